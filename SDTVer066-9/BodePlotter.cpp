@@ -646,6 +646,7 @@ void MoveBodeCursor()
  *****/
 void ProcessIQDataBode() {
 //  float bodeResultROld;
+  const uint32_t samples = BUFFER_SIZE * N_BLOCKS;  // N_BLOCKS follows rxLatencyMode
 
   if ((uint32_t)Q_in_R.available() > N_BLOCKS + 0) {
     usec = 0;
@@ -666,9 +667,9 @@ void ProcessIQDataBode() {
       Q_in_R.freeBuffer();
     }
   }
-  arm_biquad_cascade_df2T_f32(&S1_BodePlotFilter, float_buffer_L, float_buffer_L, 2048);
-  arm_scale_f32(float_buffer_L, 2.0, float_buffer_L_AudioCW, 2048);  //AFP 10-18-22
-  arm_rms_f32(float_buffer_L_AudioCW, 2048, &bodeResultR);
+  arm_biquad_cascade_df2T_f32(&S1_BodePlotFilter, float_buffer_L, float_buffer_L, samples);
+  arm_scale_f32(float_buffer_L, 2.0, float_buffer_L_AudioCW, samples);  //AFP 10-18-22
+  arm_rms_f32(float_buffer_L_AudioCW, samples, &bodeResultR);
 }
 // ================== Bode IIF Filter
 
@@ -233,6 +233,12 @@ void ButtonZoom() {
     void
 *****/
 void ButtonFilter() {
+  if (bands[currentBand].mode == DEMOD_SAM) {
+    // Both SAM filter edges move together, so the button picks the SAM sideband instead
+    samSideband = (samSideband + 1) % 3;  // SAM_DSB, SAM_LSB, SAM_USB
+    BandInformation();
+    return;
+  }
   switchFilterSideband = !switchFilterSideband;
   ControlFilterF();
   FilterBandwidth();
@@ -330,7 +336,7 @@ void ButtonMode()  //====== Changed AFP 10-05-22  =================
 void ButtonNR()  //AFP 09-19-22 update
 {
   nrOptionSelect++;
-  if (nrOptionSelect > 3) {
+  if (nrOptionSelect > 4) {
     nrOptionSelect = 0;
   }
   NROptions();  //AFP 09-19-22
@@ -349,6 +355,7 @@ void ButtonNR()  //AFP 09-19-22 update
 void ButtonNotchFilter() 
 {
   ANR_notchOn = !ANR_notchOn;
+  FFTAutoNotchReset();
   MyDelay(100L);
 }
 
@@ -331,9 +331,19 @@ char *processCATCommand(char *catCommand) {
             sprintf(outputBuffer,"NT%d;",ANR_notchOn);
           } else if(catCommand[3]==';') {
             ANR_notchOn=atoi(&catCommand[2]);
+            FFTAutoNotchReset();
             UpdateNotchField();
           }
           break;
+        case 'B': // Set/Read Noise Blanker, the impulse blanker on the wideband I/Q
+          if(catCommand[2]==';') {
+            sprintf(outputBuffer,"NB%d;",NB_RF_on);
+          } else if(catCommand[3]==';') {
+            NB_RF_on=(catCommand[2]=='1');
+            EEPROMData.NB_RF_on=NB_RF_on;
+            EEPROMWrite();
+          }
+          break;
         default:
           sprintf(outputBuffer,"?;");
           break;
@@ -422,6 +432,36 @@ char *processCATCommand(char *catCommand) {
           break;
       }
       break;
+    case 'Z':
+      switch(catCommand[1]) {
+        case 'P':  // Extension: DSP profiler. ZP; stage count, ZPnn; one stage in us, ZPR; reset
+#if defined(DSP_PROFILER)
+          if(catCommand[2]==';') {
+            sprintf(outputBuffer,"ZP%02d;",PROF_STAGE_COUNT);
+          } else if(catCommand[2]=='R' && catCommand[3]==';') {
+            ProfilerReset();
+            sprintf(outputBuffer,"ZPR;");
+          } else if(catCommand[4]==';') {
+            struct profileSummary s;
+            int i=atoi(&catCommand[2]);
+            if(ProfilerGetStage(i,&s)) {
+              sprintf(outputBuffer,"ZP%02d,%s,%lu,%.1f,%.1f,%.1f,%.1f;",i,s.name,(unsigned long)s.count,
+                      s.minUs,s.meanUs,s.p99Us,s.maxUs);
+            } else {
+              sprintf(outputBuffer,"?;");
+            }
+          } else {
+            sprintf(outputBuffer,"?;");
+          }
+#else
+          sprintf(outputBuffer,"?;");
+#endif // DSP_PROFILER
+          break;
+        default:
+          sprintf(outputBuffer,"?;");
+          break;
+      }
+      break;
     default:
       sprintf(outputBuffer,"?;");
       break;      
@@ -68,6 +68,125 @@ void SelectCWFilter()
 //  EraseMenus();
   return;
 }
+/*****
+  Tone detector for the CW decoder: a sliding DFT at one frequency, updated every sample.
+
+  S[n] = x[n] + r * e^(jw) * S[n-1] - r^N * e^(jwN) * x[n-N] is the DFT of the last N samples at w, so
+  one complex multiply and a delay line give the tone level at every sample.  The same is run one bin
+  either side, and 0.5 * S(w) - 0.25 * (S(w - 2pi/N) + S(w + 2pi/N)) is the DFT through a Hann window.
+  The plain DFT lets a strong signal 500 Hz away through at -25 dB, which a decoder that keys on the
+  level over the noise would copy.  The damping r keeps rounding from building up in the recursion.
+  The coefficients are worked out once in CWToneDetectorInit(), not for every block.
+*****/
+#define CW_TONE_WINDOW 256  // Samples, 10.7 ms at 24K SPS.  The window is symmetric, so the level is
+                            // half way up N / 2 samples after either end of a mark.
+#define CW_TONE_DAMPING 0.9999
+
+static struct {
+  float32_t rotRe[3], rotIm[3];  // r * e^(jw) for the bin below, the tone and the bin above
+  float32_t oldRe, oldIm;        // r^N * e^(jwN), the same for all three
+  float32_t scale;               // Windowed DFT magnitude to tone amplitude
+  float32_t re[3], im[3];
+  float32_t delay[CW_TONE_WINDOW];
+  uint32_t index;
+} cwTone;
+static float32_t cwToneEnvelope[FFT_LENGTH / 2];
+
+/*****
+  The decoder runs on its own clock, counted in samples of the audio it decodes, so a mark or gap is
+  timed to the step it started in rather than to the block.  The key goes down when the tone level
+  crosses half way from the noise to the peak of the signal, which is the same distance behind both
+  ends of a mark.
+*****/
+#define CW_DECODE_STEP 8           // Samples between decoder steps, 0.33 ms at 24K SPS
+#define CW_NOISE_ALPHA 0.0005      // Per sample with the key up, about 80 ms
+#define CW_PEAK_DECAY 0.99996      // Per sample, about 1 s
+#define CW_KEY_HYSTERESIS 0.1      // Of the peak to noise distance, either side of half way
+#define CW_KEY_OVER_NOISE 4.0      // Key down no lower than 12 dB over the noise
+#define CW_WARMUP (CW_DECODE_SAMPLE_RATE / 4)  // Samples of noise to learn before the key can go down
+#define CW_WARMUP_ALPHA 0.002
+
+static struct {
+  float32_t noise;  // Tone level with the key up
+  float32_t peak;   // Recent peak of the tone level
+  uint8_t down;     // Key state
+} cwKey;
+static uint32_t cwDecodeClock = 0;  // Samples decoded so far
+
+/*****
+  Purpose: Convert a time on the decoder clock to the milliseconds the histograms and ditLength use
+
+  Parameter list:
+    uint32_t samples
+
+  Return value;
+    long                  milliseconds
+*****/
+static long CWSamplesToMs(uint32_t samples) {
+  return (long)((uint64_t)samples * 1000 / CW_DECODE_SAMPLE_RATE);
+}
+
+/*****
+  Purpose: Set the tone detector to a new frequency and clear it
+
+  Parameter list:
+    float32_t toneHz          tone to detect
+    float32_t sampleRate      of the audio it will see
+
+  Return value;
+    void
+*****/
+void CWToneDetectorInit(float32_t toneHz, float32_t sampleRate) {
+  float32_t w = TWO_PI * toneHz / sampleRate;
+  for (int m = 0; m < 3; m++) {
+    float32_t wm = w + (m - 1) * TWO_PI / CW_TONE_WINDOW;
+    cwTone.rotRe[m] = CW_TONE_DAMPING * cosf(wm);
+    cwTone.rotIm[m] = CW_TONE_DAMPING * sinf(wm);
+    cwTone.re[m] = 0.0;
+    cwTone.im[m] = 0.0;
+  }
+  float32_t dampN = powf(CW_TONE_DAMPING, CW_TONE_WINDOW);
+  cwTone.oldRe = dampN * cosf(w * CW_TONE_WINDOW);
+  cwTone.oldIm = dampN * sinf(w * CW_TONE_WINDOW);
+  cwTone.scale = 4.0 / CW_TONE_WINDOW;  // A tone of amplitude A gives A * N / 4
+  memset(cwTone.delay, 0, sizeof(cwTone.delay));
+  cwTone.index = 0;
+}
+
+/*****
+  Purpose: Run the tone detector over a block of audio
+
+  Parameter list:
+    const float32_t *in       audio
+    float32_t *envelope       tone amplitude after each sample, the same scale as the audio
+    uint32_t blockSize
+
+  Return value;
+    void
+*****/
+void CWToneDetector(const float32_t *in, float32_t *envelope, uint32_t blockSize) {
+  uint32_t index = cwTone.index;
+
+  for (uint32_t i = 0; i < blockSize; i++) {
+    float32_t x = in[i];
+    float32_t old = cwTone.delay[index];
+    cwTone.delay[index] = x;
+    index = (index + 1) % CW_TONE_WINDOW;
+    float32_t inRe = x - cwTone.oldRe * old;
+    float32_t inIm = -cwTone.oldIm * old;
+    for (int m = 0; m < 3; m++) {
+      float32_t re = cwTone.re[m];
+      float32_t im = cwTone.im[m];
+      cwTone.re[m] = inRe + re * cwTone.rotRe[m] - im * cwTone.rotIm[m];
+      cwTone.im[m] = inIm + re * cwTone.rotIm[m] + im * cwTone.rotRe[m];
+    }
+    float32_t hannRe = 0.5 * cwTone.re[1] - 0.25 * (cwTone.re[0] + cwTone.re[2]);
+    float32_t hannIm = 0.5 * cwTone.im[1] - 0.25 * (cwTone.im[0] + cwTone.im[2]);
+    envelope[i] = cwTone.scale * sqrtf(hannRe * hannRe + hannIm * hannIm);
+  }
+  cwTone.index = index;
+}
+
 //=================  AFP10-18-22 ================
 /*****
   Purpose: to process CW specific signals
@@ -80,62 +199,58 @@ void SelectCWFilter()
 
 *****/
 void DoCWReceiveProcessing() {  // All New AFP 09-19-22
-  float goertzelMagnitude1;
-  float goertzelMagnitude2;
-  int audioTemp;  // KF5N
   //arm_copy_f32(float_buffer_R, float_buffer_R_CW, 256);
   //arm_biquad_cascade_df2T_f32(&S1_CW_Filter, float_buffer_R, float_buffer_R_CW, 256);//AFP 09-01-22
   //arm_biquad_cascade_df2T_f32(&S1_CW_Filter, float_buffer_L, float_buffer_L_CW, 256);//AFP 09-01-22
 
-  arm_fir_f32(&FIR_CW_DecodeL, float_buffer_L, float_buffer_L_CW, 256);  // AFP 10-25-22  Park McClellan FIR filter const Group delay
-  arm_fir_f32(&FIR_CW_DecodeR, float_buffer_R, float_buffer_R_CW, 256);  // AFP 10-25-22
+  // The receive audio is mono, so only one channel is filtered and measured
+  arm_fir_f32(&FIR_CW_DecodeL, float_buffer_L, float_buffer_L_CW, BUF_N_DF);  // AFP 10-25-22  Park McClellan FIR filter const Group delay
 
   //  if (decoderFlag == DECODE_OFF) {                  // AFP 09-27-22
   if (decoderFlag == DECODE_ON) {  // JJP 7/20/23
 
     //=== end CW Filter ===
 
-    // ----------------------  Correlation calculation  AFP 02-04-22 -------------------------
-
-    //Calculate correlation between calc sine and incoming signal
-
-    arm_correlate_f32(float_buffer_R_CW, 256, sinBuffer, 256, float_Corr_BufferR);
-    arm_max_f32(float_Corr_BufferR, 511, &corrResultR, &corrResultIndexR);
-    //running average of corr coeff. R
-    aveCorrResultR = .7 * corrResultR + .3 * aveCorrResultR;
-    arm_correlate_f32(float_buffer_L_CW, 256, sinBuffer, 256, float_Corr_BufferL);
-    //get max value of correlation
-    arm_max_f32(float_Corr_BufferL, 511, &corrResultL, &corrResultIndexL);
-    //running average of corr coeff. L
-    aveCorrResultL = .7 * corrResultL + .3 * aveCorrResultL;
-    aveCorrResult = (corrResultR + corrResultL) / 2;
-    // Calculate Goertzel Mahnitude of incomming signal
-    goertzelMagnitude1 = goertzel_mag(256, 750, 24000, float_buffer_L_CW);  //AFP 10-25-22
-    goertzelMagnitude2 = goertzel_mag(256, 750, 24000, float_buffer_R_CW);  //AFP 10-25-22
-    goertzelMagnitude = (goertzelMagnitude1 + goertzelMagnitude2) / 2;
-    //Combine Correlation and Gowetzel Coefficients
-    combinedCoeff = 10 * aveCorrResult * 100 * goertzelMagnitude;
-    combinedCoeff2 = combinedCoeff;
+    // ----------------------  Tone detection -------------------------
+    // The tone level at every sample; the block average drives the lock indicator
+    CWToneDetector(float_buffer_L_CW, cwToneEnvelope, BUF_N_DF);
+    arm_mean_f32(cwToneEnvelope, BUF_N_DF, &cwToneLevel);
     // ==========  Changed CW decode "lock" indicator
-    if (combinedCoeff > 50) {  // AFP 10-26-22
-      tft.fillRect(745, 448, 15, 15, RA8875_GREEN);
-    } else if (combinedCoeff < 50) {  // AFP 10-26-22
-      CWLevelTimer = millis();
-      if (CWLevelTimer - CWLevelTimerOld > 2000) {
-        CWLevelTimerOld = millis();
-        tft.fillRect(744, 447, 17, 17, RA8875_BLACK);
+    // Nothing is drawn while the display is moving memory; the decoder text catches up on the next block
+    if (displayBusy == 0) {
+      if (cwToneLevel > CW_TONE_THRESHOLD) {
+        tft.fillRect(745, 448, 15, 15, RA8875_GREEN);
+      } else {
+        CWLevelTimer = millis();
+        if (CWLevelTimer - CWLevelTimerOld > 2000) {
+          CWLevelTimerOld = millis();
+          tft.fillRect(744, 447, 17, 17, RA8875_BLACK);
+        }
       }
-    }
-    combinedCoeff2Old = combinedCoeff2;
-    tft.drawFastVLine(BAND_INDICATOR_X + 22, AUDIO_SPECTRUM_BOTTOM - 118, 118, RA8875_GREEN);  //CW lower freq indicator
-    tft.drawFastVLine(BAND_INDICATOR_X + 30, AUDIO_SPECTRUM_BOTTOM - 118, 118, RA8875_GREEN);  //CW upper freq indicator
-    if (combinedCoeff > 50) {                                                                  // if  have a reasonable corr coeff, >50, then we have a keeper. // AFP 10-26-22
-      audioTemp = 1;
-    } else {
-      audioTemp = 0;
+      tft.drawFastVLine(BAND_INDICATOR_X + 22, AUDIO_SPECTRUM_BOTTOM - 118, 118, RA8875_GREEN);  //CW lower freq indicator
+      tft.drawFastVLine(BAND_INDICATOR_X + 30, AUDIO_SPECTRUM_BOTTOM - 118, 118, RA8875_GREEN);  //CW upper freq indicator
+      MorseDecoderRedraw();
     }
     //==============  acquire data on CW  ================
-    DoCWDecoding(audioTemp);
+    for (int step = 0; step < (int)BUF_N_DF; step += CW_DECODE_STEP) {
+      for (int i = step; i < step + CW_DECODE_STEP; i++) {
+        float32_t level = cwToneEnvelope[i];
+        float32_t half = 0.5 * (cwKey.noise + cwKey.peak);
+        float32_t hysteresis = CW_KEY_HYSTERESIS * (cwKey.peak - cwKey.noise);
+        cwKey.peak = fmaxf(level, cwKey.peak * CW_PEAK_DECAY);
+        if (cwDecodeClock < CW_WARMUP) {  // The receive chain is still settling
+          cwKey.noise += CW_WARMUP_ALPHA * (level - cwKey.noise);
+          cwKey.peak = cwKey.noise;
+        } else if (cwKey.down) {
+          cwKey.down = level > half - hysteresis;
+        } else {
+          cwKey.down = level > fmaxf(CW_KEY_OVER_NOISE * cwKey.noise, half + hysteresis);
+          cwKey.noise += CW_NOISE_ALPHA * (level - cwKey.noise);
+        }
+      }
+      cwDecodeClock += CW_DECODE_STEP;
+      DoCWDecoding(cwKey.down);
+    }
   }
 }
 
@@ -425,6 +540,8 @@ void SetSideToneVolume()
 //==================================== Decoder =================
 //DB2OO, 29-AUG-23: moved col declaration here
 static int col = 0;  // Start at lower left
+static bool decodeTextPending = false;  // decodeBuffer has changed since it was drawn
+static long decodeWPM = -1;             // Estimated speed still to be drawn, -1 if none
 
 /*****
     DB2OO, 29-AUG-23: added
@@ -461,11 +578,42 @@ void MorseCharacterDisplay(char currentLetter) {
     decodeBuffer[col - 1] = currentLetter;                          // Add to end
     decodeBuffer[col] = '\0';                                       // Make is a string
   }
-  tft.fillRect(CW_TEXT_START_X, CW_TEXT_START_Y, CW_MESSAGE_WIDTH, CW_MESSAGE_HEIGHT * 2, RA8875_BLACK);
-  tft.setFontScale((enum RA8875tsize)1);
-  tft.setTextColor(RA8875_WHITE);
-  tft.setCursor(CW_TEXT_START_X, CW_TEXT_START_Y);
-  tft.print(decodeBuffer);
+  decodeTextPending = true;
+  if (displayBusy == 0) {
+    MorseDecoderRedraw();
+  }
+}
+
+/*****
+  Purpose: Draws the decoded text and the estimated WPM if they changed while the display was busy
+
+  Parameter list:
+    void
+
+  Return value
+    void
+*****/
+void MorseDecoderRedraw() {
+  if (decodeTextPending) {
+    tft.fillRect(CW_TEXT_START_X, CW_TEXT_START_Y, CW_MESSAGE_WIDTH, CW_MESSAGE_HEIGHT * 2, RA8875_BLACK);
+    tft.setFontScale((enum RA8875tsize)1);
+    tft.setTextColor(RA8875_WHITE);
+    tft.setCursor(CW_TEXT_START_X, CW_TEXT_START_Y);
+    tft.print(decodeBuffer);
+    decodeTextPending = false;
+  }
+  if (decodeWPM >= 0) {
+    tft.setFontScale((enum RA8875tsize)0);  // Show estimated WPM
+    tft.setTextColor(RA8875_GREEN);
+    tft.fillRect(DECODER_X + 104, DECODER_Y, tft.getFontWidth() * 10, tft.getFontHeight(), RA8875_BLACK);
+    tft.setCursor(DECODER_X + 105, DECODER_Y);
+    tft.print("(");
+    tft.print(decodeWPM);
+    tft.print(" WPM)");
+    tft.setTextColor(RA8875_WHITE);
+    tft.setFontScale((enum RA8875tsize)3);
+    decodeWPM = -1;
+  }
 }
 
 
@@ -634,32 +782,29 @@ void DoSignalPlot(float val) {
 *****/
 // charProcessFlag means a character is being decoded.  blankFlag indicates a blank has already been printed.
 bool charProcessFlag, blankFlag;
-int currentTime, interElementGap, noSignalTimeStamp;
+uint32_t currentTime, noSignalTimeStamp;  // Decoder clock, samples
+int interElementGap;
 char *bigMorseCodeTree = (char *)"-EISH5--4--V---3--UF--------?-2--ARL---------.--.WP------J---1--TNDB6--.--X/-----KC------Y------MGZ7----,Q------O-8------9--0----";
 //                                012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678
 //                                         10        20        30        40        50        60        70        80        90       100       110       120
 
 void DoCWDecoding(int audioValue) {
-  static long oldTime = millis();
-
   switch (decodeStates) {
     
     case state0:                                                // State 0.  Detects start of signal and starts timer.
       // Detect signal and redirect to appropriate state.
       if (audioValue == 1) {
-        signalStart = millis();                                                                              // Time stamp beginning of signal.
+        signalStart = cwDecodeClock;                                                                         // Time stamp beginning of signal, in samples.
         decodeStates = state1;                                                                               // Go to "signalStart" state.
-        gapLength = signalStart - signalEnd;                                                                 // Calculate the time gap between the start of this new signal and the end of the last one.
+        gapLength = CWSamplesToMs((uint32_t)(signalStart - signalEnd));                                                  // Calculate the time gap between the start of this new signal and the end of the last one.
         if (gapLength > LOWEST_ATOM_TIME                                                                     // range
-            && (uint32_t)gapLength < (uint32_t)(thresholdGeometricMean * 3)
-            && signalStart - oldTime > 5000L) {                                                              // Only call histogram every 5 seconds
+            && (uint32_t)gapLength < (uint32_t)(thresholdGeometricMean * 3)) {
           DoGapHistogram(gapLength);                                                                         // Map the gap in the signal
-          oldTime = signalStart;                                                                             // Reset old time
         }
         break;
       }
-      noSignalTimeStamp = millis();
-      interElementGap = noSignalTimeStamp - signalEnd;
+      noSignalTimeStamp = cwDecodeClock;
+      interElementGap = CWSamplesToMs((uint32_t)(noSignalTimeStamp - signalEnd));
       if ((interElementGap > ditLength * 1.95) && charProcessFlag) {  // use thresholdGeometricMean??? was ditLength. End of character!  65 * 2
         decodeStates = state5;                                        // Character ended, print it!
         break;
@@ -673,18 +818,16 @@ void DoCWDecoding(int audioValue) {
 
     case state1:                                                // Times a signal and measures its duration.  The next state determines if the signal is a dit or a dah.
       if (audioValue == 0) {
-        currentTime       = millis();
-        signalElapsedTime = currentTime - signalStart;          // Calculate the duration of the signal.
+        currentTime       = cwDecodeClock;
+        signalElapsedTime = CWSamplesToMs((uint32_t)(currentTime - signalStart));  // Calculate the duration of the signal.
 //                                                                 Ignore short noisy signal bursts:
         if (signalElapsedTime < LOWEST_ATOM_TIME) {             // A hiccup or a real signal?  Make this a fraction of ditLength instead???
           decodeStates    = state0;                             // False signal, start over.
           break;
         }
         if (signalElapsedTime > LOWEST_ATOM_TIME                // Valid elapsed time?
-            && signalElapsedTime < HISTOGRAM_ELEMENTS
-            && currentTime - oldTime > 5000L) {                 // Only call histogram every 5 seconds
+            && signalElapsedTime < HISTOGRAM_ELEMENTS) {
           DoSignalHistogram(signalElapsedTime);                 // Yep
-          oldTime = currentTime;                                // Reset old time
         }
         signalEnd         = currentTime;                        // Time gap to next signal.
         decodeStates      = state2;                             // Proceed to state2.  A timed signal is available and must be processed.
@@ -717,18 +860,9 @@ void DoCWDecoding(int audioValue) {
       break;                                                    // End state5
 
     case state6:                                                //  Blank printing state.
+      decodeWPM = 1200L / max(dahLength / 3, 1);  // Show estimated WPM.  No dah timed yet at the first blank
       MorseCharacterDisplay(' ');
 
-      tft.setFontScale((enum RA8875tsize)0);                    // Show estimated WPM
-      tft.setTextColor(RA8875_GREEN);
-      tft.fillRect(DECODER_X + 104, DECODER_Y, tft.getFontWidth() * 10, tft.getFontHeight(), RA8875_BLACK);
-      tft.setCursor(DECODER_X + 105, DECODER_Y);
-      tft.print("(");
-      tft.print(1200L / (dahLength / 3));
-      tft.print(" WPM)");
-      tft.setTextColor(RA8875_WHITE);
-      tft.setFontScale((enum RA8875tsize)3);
-
       blankFlag = true;
       decodeStates = state0;  // Start process for next incoming character.
       break;
@@ -928,11 +1062,11 @@ void DoSignalHistogram(long val) {
 
   if (valFlag == 0) {
     valRef1 = signalElapsedTime;
-    signalStartOld = millis();
+    signalStartOld = cwDecodeClock;
     valFlag = 1;
   }
 
-  if (millis() - signalStartOld > LOWEST_ATOM_TIME && valFlag == 1) {
+  if (CWSamplesToMs(cwDecodeClock - (uint32_t)signalStartOld) > LOWEST_ATOM_TIME && valFlag == 1) {
     gapRef1 = gapLength;
     valRef2 = signalElapsedTime;
     valFlag = 0;
@@ -978,48 +1112,6 @@ void DoSignalHistogram(long val) {
   }
 }
 
-/*****
-  Purpose: Calculate Goertzal Algorithn to enable decoding CW
-
-  Parameter list:
-    int numSamples,         // number of sample in data array
-    int TARGET_FREQUENCY,   // frequency for which the magnitude of the transform is to be found
-    int SAMPLING_RATE,      // Sampling rate in our case 24ksps
-    float* data             // pointer to input data array
-
-  Return value;
-    float magnitude     //magnitude of the transform at the target frequency
-
-*****/
-float goertzel_mag(int numSamples, int TARGET_FREQUENCY, int SAMPLING_RATE, float *data) {
-  int k, i;
-  float floatnumSamples;
-  float omega, sine, cosine, coeff, q0, q1, q2, magnitude, real, imag;
-
-  float scalingFactor = numSamples / 2.0;
-
-  floatnumSamples = (float)numSamples;
-  k = (int)(0.5 + ((floatnumSamples * TARGET_FREQUENCY) / SAMPLING_RATE));
-  omega = (2.0 * M_PI * k) / floatnumSamples;
-  sine = sin(omega);
-  cosine = cos(omega);
-  coeff = 2.0 * cosine;
-  q0 = 0;
-  q1 = 0;
-  q2 = 0;
-
-  for (i = 0; i < numSamples; i++) {
-    q0 = coeff * q1 - q2 + data[i];
-    q2 = q1;
-    q1 = q0;
-  }
-  real = (q1 - q2 * cosine) / scalingFactor;  // calculate the real and imaginary results scaling appropriately
-  imag = (q2 * sine) / scalingFactor;
-
-  magnitude = sqrtf(real * real + imag * imag);
-  return magnitude;
-}
-
 /*****
   Purpose:Display horizontal CW Decode level
 
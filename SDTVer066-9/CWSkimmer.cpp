@@ -0,0 +1,451 @@
+#ifndef BEENHERE
+#include "SDT.h"
+#endif
+
+/*****
+  Multi-channel CW skimmer on the 24K SPS complex baseband, after RxDecimate()
+
+  One polyphase analysis filter bank splits the baseband into SKIM_CHANNELS channels 93.75 Hz apart.
+  Each frame the last SKIM_TAPS samples are weighted with a lowpass prototype, folded down to
+  SKIM_CHANNELS points and put through one complex FFT, so every channel costs SKIM_TAPS / SKIM_CHANNELS
+  multiplies plus its share of the FFT however many signals there are.  Frames are SKIM_HOP samples
+  apart, half the channel count, which gives a channel sample every 5.3 ms.  Only the envelope is
+  used, so the phase each frame picks up from the hop does not matter.
+
+  Every channel inside the decimator passband has its own key detector and timing decoder.  A channel
+  only keys down when it is louder than both neighbours, so a signal between two channels is decoded
+  once.  Mark lengths sort into dits and dahs against twice the running dit length, the same Morse
+  tree as DoCWDecoding() turns the elements into characters, and a decoded word that looks like a
+  callsign goes into a short spot queue.  loop() prints the queue with CWSkimmerShowSpots(), so no
+  Serial output is made inside ProcessIQData().  The filter makes every mark longer and every gap shorter by the
+  same few frames, so the gaps are timed against the mean of a dit and the gap inside a character.
+  CWSkimmerReport() lists the busy channels.
+*****/
+#define SKIM_CHANNELS 256                   // FFT size, a power of two
+#define SKIM_HOP (SKIM_CHANNELS / 2)        // New samples per frame
+#define SKIM_TAPS (SKIM_CHANNELS * 2)       // Prototype lowpass length, 21 ms; much longer smears a dit
+#define SKIM_MAX_HZ 10000.0                 // Decimator passband, see RX_DEC_PASS_HZ
+#define SKIM_MAX_BLOCK 256                  // Input samples per call
+#define SKIM_ON 20.0                        // Key down no lower than 13 dB over the channel noise
+#define SKIM_NOISE_ALPHA 0.03               // Noise power tracking, per frame
+#define SKIM_SIGNAL_ALPHA 0.1               // Mark power tracking, per frame
+#define SKIM_WARMUP (SKIM_TAPS / SKIM_HOP + 2)  // Frames before the history is full of real samples
+#define SKIM_MIN_MARK 3                     // Frames; anything shorter is a noise spike
+#define SKIM_DIT_START 9.0                  // Frames, 25 WPM.  Dits and dahs sort right from 12 to 40 WPM
+#define SKIM_DIT_MAX 40.0                   // Frames, about 6 WPM
+#define SKIM_EXPIRE_FRAMES (187 * 60)       // Forget a channel after a minute without signal
+#define SKIM_TEXT 40
+#define SKIM_WORD 12
+#define SKIM_SPOTS 8                        // Spots waiting for loop(), a power of two
+
+struct skimChannel {
+  float32_t noise;           // Average power when the key is up
+  float32_t signal;          // Average power when the key is down
+  float32_t dit;             // Running dit length, frames
+  float32_t gap;             // Running gap between the elements of a character, frames
+  uint32_t lastKey;          // Frame of the last key down
+  uint16_t run;              // Frames in the current key state
+  uint8_t key;               // 1 = key down
+  uint8_t elements;          // Dits and dahs in the current character
+  uint8_t treeIndex;         // Index into bigMorseCodeTree
+  uint8_t dashJump;
+  uint8_t spaced;            // Word space already added
+  uint8_t textLen;
+  uint8_t wordLen;
+  char text[SKIM_TEXT + 1];  // Recent decoded text
+  char word[SKIM_WORD + 1];  // Word being decoded
+  char call[SKIM_WORD + 1];  // Last callsign heard
+};
+
+struct skimSpot {
+  float32_t freq;            // Hz
+  char call[SKIM_WORD + 1];
+  uint8_t wpm;
+};
+
+static float32_t DMAMEM skimPrototype[SKIM_TAPS];
+static float32_t DMAMEM skimHistory[2 * (SKIM_TAPS + SKIM_MAX_BLOCK)];  // Interleaved I/Q
+static float32_t DMAMEM skimFrame[2 * SKIM_CHANNELS];
+static float32_t DMAMEM skimPower[2][SKIM_CHANNELS];  // This frame and the last, smoothed together
+static struct skimChannel DMAMEM skimChannel[SKIM_CHANNELS];
+static uint32_t skimFrames = 0;
+static uint32_t skimFill = 0;  // New samples in skimHistory since the last frame
+static int skimEdge = 0;       // Channels -skimEdge to skimEdge are decoded
+static bool skimReady = false;
+static struct skimSpot skimSpots[SKIM_SPOTS];
+static uint32_t skimSpotHead = 0;  // Next spot to write; only SkimmerEndWord() moves it
+static uint32_t skimSpotTail = 0;  // Next spot to print; only CWSkimmerShowSpots() moves it
+
+/*****
+  Purpose: Design the channel filter and clear every channel's decoder.  Called when the skimmer is
+           turned on.
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+void CWSkimmerReset() {
+  // Blackman windowed sinc, -6 dB at half the channel spacing
+  const float32_t centre = (SKIM_TAPS - 1) / 2.0;
+  for (int i = 0; i < SKIM_TAPS; i++) {
+    float32_t x = (i - centre) / SKIM_CHANNELS;
+    float32_t sinc = (fabsf(x) < 1.0e-6) ? 1.0 : sinf(PI * x) / (PI * x);
+    float32_t w = 0.42 - 0.5 * cosf(TWO_PI * i / (SKIM_TAPS - 1)) + 0.08 * cosf(2.0 * TWO_PI * i / (SKIM_TAPS - 1));
+    skimPrototype[i] = sinc * w / SKIM_CHANNELS;
+  }
+  memset(skimHistory, 0, sizeof(skimHistory));
+  memset(skimPower, 0, sizeof(skimPower));
+  memset(skimChannel, 0, sizeof(skimChannel));
+  for (int k = 0; k < SKIM_CHANNELS; k++) {
+    skimChannel[k].dit = SKIM_DIT_START;
+    skimChannel[k].gap = SKIM_DIT_START;
+    skimChannel[k].dashJump = DECODER_BUFFER_SIZE;
+  }
+  float32_t spacing = ((float32_t)SR[SampleRate].rate / DF) / SKIM_CHANNELS;
+  skimEdge = min((int)(SKIM_MAX_HZ / spacing), SKIM_CHANNELS / 2 - 1);
+  skimFrames = 0;
+  skimFill = 0;
+  skimSpotTail = skimSpotHead;
+  skimReady = true;
+}
+
+/*****
+  Purpose: Frequency of a channel's centre
+
+  Parameter list:
+    int k                 channel, negative below the receive frequency
+
+  Return value;
+    float32_t             Hz
+*****/
+static float32_t SkimmerChannelFreq(int k) {
+  return (float32_t)TxRxFreq + k * ((float32_t)SR[SampleRate].rate / DF) / SKIM_CHANNELS;
+}
+
+/*****
+  Purpose: Decide whether a word looks like a callsign: a prefix of one to three characters with at
+           least one letter, a digit, then one to four letters.  A portable or mobile part after a
+           slash is ignored.
+
+  Parameter list:
+    const char *word      decoded word
+
+  Return value;
+    bool                  true for a callsign
+*****/
+static bool SkimmerIsCallsign(const char *word) {
+  char base[SKIM_WORD + 1];
+  const char *slash = strchr(word, '/');
+  int len = slash ? (int)(slash - word) : (int)strlen(word);
+  if (slash && len < 3) {  // A prefix like DL/ in front of the call
+    word = slash + 1;
+    len = strlen(word);
+    slash = strchr(word, '/');
+    if (slash) len = slash - word;
+  }
+  if (len < 3 || len > SKIM_WORD) return false;
+  memcpy(base, word, len);
+  base[len] = '\0';
+
+  int digit = -1;
+  for (int i = len - 1; i >= 0; i--) {
+    if (isdigit(base[i])) {
+      digit = i;
+      break;
+    }
+    if (!isalpha(base[i])) return false;
+  }
+  int suffix = len - digit - 1;
+  if (digit < 1 || digit > 3 || suffix < 1 || suffix > 4) return false;
+  bool letter = false;
+  for (int i = 0; i < digit; i++) {
+    if (!isalnum(base[i])) return false;
+    if (isalpha(base[i])) letter = true;
+  }
+  return letter;
+}
+
+/*****
+  Purpose: The Morse time unit of a channel.  A dit plus the gap after it is two units however much
+           the filter stretches the mark.
+
+  Parameter list:
+    const struct skimChannel *ch
+
+  Return value;
+    float32_t             frames
+*****/
+static float32_t SkimmerUnit(const struct skimChannel *ch) {
+  return 0.5 * (ch->dit + ch->gap);
+}
+
+/*****
+  Purpose: Add a character to a channel's text, sliding the text along when it is full
+
+  Parameter list:
+    struct skimChannel *ch
+    char c
+
+  Return value;
+    void
+*****/
+static void SkimmerAddText(struct skimChannel *ch, char c) {
+  if (ch->textLen == SKIM_TEXT) {
+    memmove(ch->text, &ch->text[1], SKIM_TEXT - 1);
+    ch->textLen--;
+  }
+  ch->text[ch->textLen++] = c;
+  ch->text[ch->textLen] = '\0';
+}
+
+/*****
+  Purpose: End the word being decoded on a channel and queue a spot if it is a new callsign.  A spot
+           that finds the queue full is dropped.
+
+  Parameter list:
+    struct skimChannel *ch
+    int k                 channel number
+
+  Return value;
+    void
+*****/
+static void SkimmerEndWord(struct skimChannel *ch, int k) {
+  ch->word[ch->wordLen] = '\0';
+  if (ch->wordLen && SkimmerIsCallsign(ch->word) && strcmp(ch->word, ch->call) != 0) {
+    strcpy(ch->call, ch->word);
+    if (skimSpotHead - skimSpotTail < SKIM_SPOTS) {
+      struct skimSpot *spot = &skimSpots[skimSpotHead & (SKIM_SPOTS - 1)];
+      spot->freq = SkimmerChannelFreq(k);
+      strcpy(spot->call, ch->call);
+      spot->wpm = (uint8_t)(1200.0 / (SkimmerUnit(ch) * 1000.0 * SKIM_HOP / ((float32_t)SR[SampleRate].rate / DF)) + 0.5);
+      skimSpotHead++;
+    }
+  }
+  ch->wordLen = 0;
+}
+
+/*****
+  Purpose: Run one channel's key detector and decoder for one frame
+
+  Parameter list:
+    struct skimChannel *ch
+    int k                 channel number
+    float32_t P           smoothed power of the channel
+    bool peak             the channel is louder than both neighbours
+
+  Return value;
+    void
+*****/
+static void SkimmerDecode(struct skimChannel *ch, int k, float32_t P, bool peak) {
+  // Key halfway between the noise and the mark level in dB.  Tied to the noise alone, the key of a
+  // strong signal would never come up: the filter's skirts fill the gaps far above the noise.
+  float32_t threshold = fmaxf(SKIM_ON * ch->noise, sqrtf(ch->noise * ch->signal));
+  if (ch->run < UINT16_MAX) {
+    ch->run++;
+  }
+
+  if (!ch->key) {
+    if (P > threshold && peak) {
+      if (ch->elements && ch->run < 2.0 * SkimmerUnit(ch)) {
+        ch->gap += 0.25 * (ch->run - ch->gap);
+      }
+      ch->key = 1;
+      ch->run = 0;
+      ch->lastKey = skimFrames;
+      if (ch->signal < P) {
+        ch->signal = P;
+      }
+      return;
+    }
+    ch->noise += SKIM_NOISE_ALPHA * (P - ch->noise);
+
+    // Gaps: a character after two dits, a word after five
+    if (ch->elements && ch->run >= 2.0 * SkimmerUnit(ch)) {
+      char c = (ch->elements <= 6) ? bigMorseCodeTree[ch->treeIndex] : '-';
+      if (c != '-') {  // '-' marks an element pattern that is no character
+        SkimmerAddText(ch, c);
+        if (ch->wordLen < SKIM_WORD) {
+          ch->word[ch->wordLen++] = c;
+        }
+      }
+      ch->elements = 0;
+      ch->treeIndex = 0;
+      ch->dashJump = DECODER_BUFFER_SIZE;
+      ch->spaced = 0;
+    }
+    if (!ch->spaced && ch->textLen && ch->run >= 5.0 * SkimmerUnit(ch)) {
+      SkimmerAddText(ch, ' ');
+      SkimmerEndWord(ch, k);
+      ch->spaced = 1;
+    }
+    if (ch->textLen && skimFrames - ch->lastKey > SKIM_EXPIRE_FRAMES) {
+      float32_t noise = ch->noise;
+      memset(ch, 0, sizeof(*ch));
+      ch->noise = noise;  // The signal level goes; the next station may be weaker
+      ch->dit = SKIM_DIT_START;
+      ch->gap = SKIM_DIT_START;
+      ch->dashJump = DECODER_BUFFER_SIZE;
+    }
+    return;
+  }
+
+  ch->lastKey = skimFrames;
+  if (P >= threshold) {
+    ch->signal += SKIM_SIGNAL_ALPHA * (P - ch->signal);
+    return;
+  }
+  ch->key = 0;
+  int mark = ch->run;
+  ch->run = 0;
+  if (mark < SKIM_MIN_MARK) {
+    return;
+  }
+  ch->dashJump >>= 1;
+  if (mark < 2.0 * ch->dit) {  // Dit
+    ch->treeIndex++;
+    ch->dit += 0.25 * (mark - ch->dit);
+  } else {  // Dah
+    ch->treeIndex += ch->dashJump;
+    ch->dit += 0.25 * (mark / 3.0 - ch->dit);
+  }
+  ch->dit = fminf(fmaxf(ch->dit, SKIM_MIN_MARK), SKIM_DIT_MAX);
+  if (ch->elements < UINT8_MAX) {
+    ch->elements++;
+  }
+  if (ch->dashJump == 0) {  // Too many elements for the tree; wait for the gap
+    ch->dashJump = 1;
+    ch->elements = 7;
+  }
+}
+
+/*****
+  Purpose: Channelize a block of baseband and run the decoders
+
+  Parameter list:
+    const float32_t *IQ       decimated I/Q, interleaved, 24K SPS
+    uint32_t blockSize        complex samples, no more than SKIM_MAX_BLOCK
+
+  Return value;
+    void
+*****/
+void CWSkimmer(const float32_t *IQ, uint32_t blockSize) {
+  const arm_cfft_instance_f32 *skimS = &arm_cfft_sR_f32_len256;
+
+  if (!skimReady) {
+    CWSkimmerReset();
+  }
+  arm_copy_f32(IQ, &skimHistory[2 * (SKIM_TAPS + skimFill)], 2 * blockSize);
+  skimFill += blockSize;
+
+  uint32_t used = 0;
+  while (skimFill - used >= SKIM_HOP) {
+    // The newest SKIM_TAPS samples up to this frame, weighted and folded to SKIM_CHANNELS points
+    used += SKIM_HOP;
+    const float32_t *x = &skimHistory[2 * used];
+    for (int m = 0; m < SKIM_CHANNELS; m++) {
+      float32_t re = 0.0;
+      float32_t im = 0.0;
+      for (int p = m; p < SKIM_TAPS; p += SKIM_CHANNELS) {
+        re += x[2 * p] * skimPrototype[p];
+        im += x[2 * p + 1] * skimPrototype[p];
+      }
+      skimFrame[2 * m] = re;
+      skimFrame[2 * m + 1] = im;
+    }
+    arm_cfft_f32(skimS, skimFrame, 0, 1);
+
+    float32_t *now = skimPower[skimFrames & 1];
+    float32_t *last = skimPower[(skimFrames + 1) & 1];
+    arm_cmplx_mag_squared_f32(skimFrame, now, SKIM_CHANNELS);
+    arm_add_f32(now, last, last, SKIM_CHANNELS);  // last now holds the two frame sum
+    skimFrames++;
+
+    const int mask = SKIM_CHANNELS - 1;
+    if (skimFrames >= SKIM_WARMUP) {
+      // A click or a tuning step jumps in most channels at once; keying never does.  Hold every
+      // channel still for that frame instead of reading it as a dit everywhere.
+      int jumps = 0;
+      for (int k = -skimEdge; k <= skimEdge; k++) {
+        if (last[k & mask] > SKIM_ON * skimChannel[k & mask].noise) {
+          jumps++;
+        }
+      }
+      if (jumps > skimEdge / 2) {
+        arm_copy_f32(now, last, SKIM_CHANNELS);
+        continue;
+      }
+    }
+    for (int k = -skimEdge; k <= skimEdge; k++) {
+      if (k == 0) continue;  // DC offset and the leak of the LO
+      if (skimFrames < SKIM_WARMUP) {
+        skimChannel[k & mask].noise = last[k & mask];  // Start from the noise, not the zeroed history
+        continue;
+      }
+      float32_t P = last[k & mask];
+      bool peak = P > last[(k - 1) & mask] && P >= last[(k + 1) & mask];
+      SkimmerDecode(&skimChannel[k & mask], k, P, peak);
+    }
+    arm_copy_f32(now, last, SKIM_CHANNELS);  // Unsmoothed again for the next frame
+  }
+
+  // Keep SKIM_TAPS samples ahead of the first unused one
+  memmove(skimHistory, &skimHistory[2 * used], 2 * (SKIM_TAPS + skimFill - used) * sizeof(float32_t));
+  skimFill -= used;
+}
+
+/*****
+  Purpose: Print the spots the skimmer queued since the last call.  Called from loop(), outside the
+           receive DSP chain.
+
+  Parameter list:
+    Print &out            where to write the spots, usually Serial
+
+  Return value;
+    void
+*****/
+void CWSkimmerShowSpots(Print &out) {
+  while (skimSpotTail != skimSpotHead) {
+    const struct skimSpot *spot = &skimSpots[skimSpotTail & (SKIM_SPOTS - 1)];
+    out.printf("CW skimmer: %9.1f kHz  %-10s %2d WPM\n", spot->freq / 1000.0, spot->call, spot->wpm);
+    skimSpotTail++;
+  }
+}
+
+/*****
+  Purpose: List the channels heard in the last minute with their callsign and text.  With the DSP
+           profiler built in, also estimate how many channels would fit in the receive block time,
+           taking the skimmer's cost as proportional to the channel count.
+
+  Parameter list:
+    Print &out            where to write the list, usually Serial
+
+  Return value;
+    void
+*****/
+void CWSkimmerReport(Print &out) {
+  const int mask = SKIM_CHANNELS - 1;
+  const int channels = 2 * skimEdge;
+  out.printf("CW skimmer: %d channels %.2f Hz apart\n", channels, ((float32_t)SR[SampleRate].rate / DF) / SKIM_CHANNELS);
+#if defined(DSP_PROFILER)
+  struct profileSummary skim, total;
+  ProfilerGetStage(PROF_RX_SKIMMER, &skim);
+  ProfilerGetStage(PROF_RX_TOTAL, &total);
+  if (skim.count && channels) {
+    float32_t budgetUs = 1000000.0 * BUFFER_SIZE * N_BLOCKS / SR[SampleRate].rate;
+    float32_t restUs = total.meanUs - skim.meanUs;
+    float32_t perChannelUs = skim.meanUs / channels;
+    out.printf("  %.1f us per block, %.3f us per channel; the receive chain uses %.0f%% of the %.0f us block\n",
+               skim.meanUs, perChannelUs, 100.0 * total.meanUs / budgetUs, budgetUs);
+    // More channels means more banks like this one, so the cost per channel holds
+    out.printf("  about %d channels fit in what the rest of the chain (%.1f us) leaves\n",
+               (int)((budgetUs - restUs) / perChannelUs), restUs);
+  }
+#endif
+  for (int k = -skimEdge; k <= skimEdge; k++) {
+    struct skimChannel *ch = &skimChannel[k & mask];
+    if (k == 0 || ch->textLen == 0) continue;
+    out.printf("%9.1f kHz  %-10s %s\n", SkimmerChannelFreq(k) / 1000.0, ch->call[0] ? ch->call : "-", ch->text);
+  }
+}
@@ -60,6 +60,9 @@
 // Fast tune function on fine tune knob from Harry Brash GM3RVL
 #define FAST_TUNE
 
+// Uncomment for per-stage timing of the receive and transmit DSP chains. Report goes to Serial with DEBUG, or CAT ZP;
+//#define DSP_PROFILER
+
 //====================== User Specific Preferences =============
 
 #define DECODER_STATE 0                 // 0 = off, 1 = on
@@ -39,11 +39,102 @@ void NoiseBlanker(float32_t* inputsamples, float32_t* outputsamples)
 
   AltNoiseBlanking(inputsamples, NB_FFT_SIZE, Energy);
 
-  for (unsigned k = 0; k < NB_FFT_SIZE;  k++)
-  {
-    outputsamples[k] = inputsamples[k];
+  if (outputsamples != inputsamples) {
+    for (unsigned k = 0; k < NB_FFT_SIZE;  k++)
+    {
+      outputsamples[k] = inputsamples[k];
+    }
+  }
+
+}
+
+/*****
+  RF noise blanker on the wideband I/Q, ahead of FreqShift2() and the decimators
+
+  Before the narrow filters an impulse is still only a few samples long, so it can be gated out
+  cheaply.  After them it has been stretched to the length of their impulse response and has to be
+  predicted over, as AltNoiseBlanking() does.  Each sample's power is compared with a running average
+  of the power; one more than NB_RF_thresh (an amplitude ratio) above it marks an impulse.  The output
+  runs RF_NB_DELAY samples behind the input, so the gain can ramp down before the impulse arrives,
+  stays at zero through it and RF_NB_HANG samples after, then ramps back up.  A sample over the
+  threshold only feeds the average up to the threshold, so the average still follows a signal that
+  keys on but impulses do not pull it up.  Lengths are in samples, about 5 us each at 192K SPS.
+*****/
+#define RF_NB_TRANS 4                         // Raised cosine ramp down and up
+#define RF_NB_ADVANCE 4                       // Zero gain from this far ahead of an impulse
+#define RF_NB_DELAY (RF_NB_TRANS + RF_NB_ADVANCE)  // Power of two
+#define RF_NB_HANG 12                         // Zero gain for this long after the last impulse sample
+#define RF_NB_AVG_SECONDS 0.01                // Time constant of the average power
+
+static struct {
+  float32_t delayI[RF_NB_DELAY];
+  float32_t delayQ[RF_NB_DELAY];
+  float32_t ramp[RF_NB_TRANS + 1];  // Gain by ramp position, 1 down to 0
+  float32_t avg;                    // Average power
+  float32_t avgCoeff;
+  int idx;
+  int pending;                      // Samples left before the gain may start back up
+  int pos;                          // Ramp position, 0 = full gain, RF_NB_TRANS = blanked
+  uint32_t rate;
+} rfNB;
+
+/*****
+  Purpose: Gate impulse noise out of the wideband I/Q stream, in place
+
+  Parameter list:
+    float32_t *IQ             I/Q at the ADC rate, interleaved
+    uint32_t blockSize        complex samples
+
+  Return value;
+    void
+*****/
+void RFNoiseBlanker(float32_t *IQ, uint32_t blockSize) {
+  if (rfNB.rate != SR[SampleRate].rate) {
+    memset(&rfNB, 0, sizeof(rfNB));
+    rfNB.rate = SR[SampleRate].rate;
+    rfNB.avgCoeff = 1.0 / (RF_NB_AVG_SECONDS * rfNB.rate);
+    for (int i = 0; i <= RF_NB_TRANS; i++) {
+      rfNB.ramp[i] = 0.5 + 0.5 * cosf(PI * i / RF_NB_TRANS);
+    }
+  }
+  const float32_t thresh2 = NB_RF_thresh * NB_RF_thresh;
+  const float32_t k = rfNB.avgCoeff;
+  float32_t avg = rfNB.avg;
+  int idx = rfNB.idx;
+  int pending = rfNB.pending;
+  int pos = rfNB.pos;
+
+  for (uint32_t i = 0; i < blockSize; i++) {
+    float32_t inI = IQ[2 * i];
+    float32_t inQ = IQ[2 * i + 1];
+    float32_t p = inI * inI + inQ * inQ;
+    float32_t limit = thresh2 * avg;
+    if (p > limit && avg > 0.0) {
+      pending = RF_NB_DELAY + RF_NB_HANG;
+      p = limit;
+    }
+    avg += k * (p - avg);
+
+    float32_t outI = rfNB.delayI[idx];
+    float32_t outQ = rfNB.delayQ[idx];
+    rfNB.delayI[idx] = inI;
+    rfNB.delayQ[idx] = inQ;
+    idx = (idx + 1) & (RF_NB_DELAY - 1);
+
+    if (pending > 0) {
+      pending--;
+      if (pos < RF_NB_TRANS) pos++;
+    } else if (pos > 0) {
+      pos--;
+    }
+    IQ[2 * i] = outI * rfNB.ramp[pos];
+    IQ[2 * i + 1] = outQ * rfNB.ramp[pos];
   }
 
+  rfNB.avg = avg;
+  rfNB.idx = idx;
+  rfNB.pending = pending;
+  rfNB.pos = pos;
 }
 
 /*****
@@ -304,6 +395,54 @@ void CalcNotchBins()
 
 // ================= AGC
 
+// Look-ahead peak for AGC(): a monotonic deque of abs_ring indices over the attack window, oldest
+// first, with strictly falling magnitudes.  The front is the window maximum; each sample is pushed
+// and popped at most once, so tracking costs O(1) per sample however steady the carrier.
+#define AGC_PEAK_SIZE 2048  // Power of two, at least RB_SIZE
+static uint16_t agcPeakIndex[AGC_PEAK_SIZE];
+static int agcPeakHead = 0;
+static int agcPeakCount = 0;
+
+/*****
+  Purpose: Add the newest abs_ring sample to the look-ahead peak deque
+
+  Parameter list:
+    int index           abs_ring index just written
+
+  Return value;
+    void
+*****/
+static inline void AGCPeakPush(int index) {
+  float32_t value = abs_ring[index];
+  while (agcPeakCount > 0) {
+    if (abs_ring[agcPeakIndex[(agcPeakHead + agcPeakCount - 1) & (AGC_PEAK_SIZE - 1)]] > value) break;
+    agcPeakCount--;  // Can never be the maximum again
+  }
+  agcPeakIndex[(agcPeakHead + agcPeakCount) & (AGC_PEAK_SIZE - 1)] = index;
+  agcPeakCount++;
+}
+
+/*****
+  Purpose: Rebuild the look-ahead peak deque from the samples already in the attack window,
+           out_index + 1 through in_index.  Needed whenever attack_buffsize or the indices change.
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+static void AGCPeakReset() {
+  agcPeakHead = 0;
+  agcPeakCount = 0;
+  int k = out_index;
+  for (int j = 0; j < attack_buffsize; j++) {
+    if (++k >= (int)ring_buffsize)
+      k = 0;
+    AGCPeakPush(k);
+  }
+}
+
 // G0ORX broke this code out so can be called from other places
 
 void AGCLoadValues() {
@@ -348,6 +487,9 @@ void AGCLoadValues() {
   max_gain = powf (10.0, (float32_t)bands[currentBand].AGC_thresh / 20.0);
   attack_buffsize = (int)ceil(sample_rate * n_tau * tau_attack);
   in_index = attack_buffsize + out_index;
+  if (in_index >= ring_buffsize)
+    in_index -= ring_buffsize;
+  AGCPeakReset();
   attack_mult = 1.0 - expf(-1.0 / (sample_rate * tau_attack));
   decay_mult = 1.0 - expf(-1.0 / (sample_rate * tau_decay));
   fast_decay_mult = 1.0 - expf(-1.0 / (sample_rate * tau_fast_decay));
@@ -423,20 +565,29 @@ void AGCThresholdChanged() {
 *****/
 void AGC()
 {
-  int k;
   float32_t mult;
   
   if (AGCMode == 0)  // AGC OFF
   {
-    for (unsigned i = 0; i < FFT_length / 2; i++)
+    for (unsigned i = 0; i < BUF_N_DF; i++)
     {
-      iFFT_buffer[FFT_length + 2 * i + 0] = fixed_gain * iFFT_buffer[FFT_length + 2 * i + 0];
-      iFFT_buffer[FFT_length + 2 * i + 1] = fixed_gain * iFFT_buffer[FFT_length + 2 * i + 1];
+      rxFilteredIQ[2 * i + 0] = fixed_gain * rxFilteredIQ[2 * i + 0];
+      rxFilteredIQ[2 * i + 1] = fixed_gain * rxFilteredIQ[2 * i + 1];
     }
     return;
   }
 
-  for (unsigned i = 0; i < FFT_length / 2; i++)
+  // MAGNITUDE CALCULATION for the whole block first, so the per-sample loop below only indexes
+  float32_t *blockIn = rxFilteredIQ;
+  float32_t blockMag[FFT_LENGTH / 2];  // BUF_N_DF is at most this
+  if (pmode == 0) {
+    for (unsigned i = 0; i < BUF_N_DF; i++)
+      blockMag[i] = max(fabs(blockIn[2 * i + 0]), fabs(blockIn[2 * i + 1]));
+  } else {
+    arm_cmplx_mag_f32(blockIn, blockMag, BUF_N_DF);
+  }
+
+  for (unsigned i = 0; i < BUF_N_DF; i++)
   {
     if (++out_index >= (int)ring_buffsize)
       out_index -= ring_buffsize;
@@ -446,30 +597,20 @@ void AGC()
     out_sample[0] = ring[2 * out_index + 0];
     out_sample[1] = ring[2 * out_index + 1];
     abs_out_sample = abs_ring[out_index];
-    ring[2 * in_index + 0] = iFFT_buffer[FFT_length + 2 * i + 0];
-    ring[2 * in_index + 1] = iFFT_buffer[FFT_length + 2 * i + 1];
-    if (pmode == 0) // MAGNITUDE CALCULATION
-      abs_ring[in_index] = max(fabs(ring[2 * in_index + 0]), fabs(ring[2 * in_index + 1]));
-    else
-      abs_ring[in_index] = sqrtf(ring[2 * in_index + 0] * ring[2 * in_index + 0] + ring[2 * in_index + 1] * ring[2 * in_index + 1]);
+    ring[2 * in_index + 0] = blockIn[2 * i + 0];
+    ring[2 * in_index + 1] = blockIn[2 * i + 1];
+    abs_ring[in_index] = blockMag[i];
 
     fast_backaverage = fast_backmult * abs_out_sample + onemfast_backmult * fast_backaverage;
     hang_backaverage = hang_backmult * abs_out_sample + onemhang_backmult * hang_backaverage;
 
-    if ((abs_out_sample >= ring_max) && (abs_out_sample > 0.0))
-    {
-      ring_max = 0.0;
-      k = out_index;
-      for (int j = 0; j < attack_buffsize; j++)
-      {
-        if (++k == (int)ring_buffsize)
-          k = 0;
-        if (abs_ring[k] > ring_max)
-          ring_max = abs_ring[k];
-      }
+    // Peak of the attack window, out_index + 1 through in_index
+    if (agcPeakCount > 0 && agcPeakIndex[agcPeakHead] == out_index) {
+      agcPeakHead = (agcPeakHead + 1) & (AGC_PEAK_SIZE - 1);
+      agcPeakCount--;
     }
-    if (abs_ring[in_index] > ring_max)
-      ring_max = abs_ring[in_index];
+    AGCPeakPush(in_index);
+    ring_max = abs_ring[agcPeakIndex[agcPeakHead]];
 
     if (hang_counter > 0)
       --hang_counter;
@@ -565,8 +706,8 @@ void AGC()
     //#else
     //  mult = (out_target - slope_constant * min (0.0, log10f(inv_max_input * volts))) / volts;
     //#endif
-    iFFT_buffer[FFT_length + 2 * i + 0] = out_sample[0] * mult;
-    iFFT_buffer[FFT_length + 2 * i + 1] = out_sample[1] * mult;
+    rxFilteredIQ[2 * i + 0] = out_sample[0] * mult;
+    rxFilteredIQ[2 * i + 1] = out_sample[1] * mult;
   }
 }
 
@@ -582,9 +723,9 @@ void AGC()
     void
 *****/
 void DecodeIQ() {
-  for (unsigned i = 0; i < FFT_length / 2; i++) {
-    float_buffer_L[i] = iFFT_buffer[FFT_length + i * 2];
-    float_buffer_R[i] = iFFT_buffer[FFT_length + i * 2 + 1];
+  for (unsigned i = 0; i < BUF_N_DF; i++) {
+    float_buffer_L[i] = rxFilteredIQ[i * 2];
+    float_buffer_R[i] = rxFilteredIQ[i * 2 + 1];
   }
 }
 
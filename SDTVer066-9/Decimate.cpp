@@ -0,0 +1,176 @@
+#ifndef BEENHERE
+#include "SDT.h"
+#endif
+
+/*****
+  Receive decimation, 192K SPS to 24K SPS, as three half-band stages of 2 each.
+
+  A half-band lowpass has its cutoff at a quarter of the input rate, so every other tap is zero
+  apart from the centre tap, which is 0.5.  With the symmetry of a linear phase FIR, a filter of
+  4 * pairs - 1 taps needs only "pairs" multiplies per output, plus one for the centre.  I and Q are
+  kept interleaved in the filter history so both channels share every coefficient load.
+
+  Each stage only has to keep out what would alias into the final passband (up to RX_DEC_PASS_HZ), so
+  the first two stages have very wide transition bands and are short.  Each stage writes its output
+  straight into the history buffer of the next one, so there are no intermediate buffers.  The front
+  end writes each new block straight into the history of the first stage, see RxDecimatorInput(), and
+  the receive chain works on it there until it is decimated.
+*****/
+#define RX_DEC_STAGES 3
+#define RX_DEC_MAX_PAIRS 24
+#define RX_DEC_PASS_HZ 10000.0  // Widest receive filter, see the LP_F_help limit in SetDecIntFilters()
+#define RX_DEC_MAX_IN (FFT_LENGTH / 2 * 8)  // BUFFER_SIZE * N_B; N_B is not a compile time constant here
+
+struct halfBandStage {
+  float32_t coeffs[RX_DEC_MAX_PAIRS];  // Odd taps h1, h3, h5 ... outward from the centre
+  uint16_t pairs;                      // Taps = 4 * pairs - 1
+  uint32_t maxIn;                      // Largest input block, sets the size of the history buffer
+  float32_t *state;                    // Interleaved I/Q: taps - 1 old samples, then the new block
+};
+
+static struct halfBandStage rxDec[RX_DEC_STAGES];
+static float32_t DMAMEM rxDecState1[2 * (4 * RX_DEC_MAX_PAIRS - 2 + RX_DEC_MAX_IN)];
+static float32_t DMAMEM rxDecState2[2 * (4 * RX_DEC_MAX_PAIRS - 2 + RX_DEC_MAX_IN / 2)];
+static float32_t DMAMEM rxDecState3[2 * (4 * RX_DEC_MAX_PAIRS - 2 + RX_DEC_MAX_IN / 4)];
+
+/*****
+  Purpose: Design a Kaiser windowed half-band lowpass, the same window CalcFIRCoeffs() uses
+
+  Parameter list:
+    struct halfBandStage *stage   stage to fill in
+    float32_t passHz              passband edge; the stopband starts at rateIn / 2 - passHz
+    float32_t rateIn              input sample rate
+    float32_t Astop               stopband attenuation in dB
+
+  Return value:
+    void
+*****/
+static void DesignHalfBand(struct halfBandStage *stage, float32_t passHz, float32_t rateIn, float32_t Astop) {
+  // Kaiser's estimate of the length for this transition band, rounded up to 4 * pairs - 1 taps
+  float32_t transition = TWO_PI * (rateIn / 2.0 - 2.0 * passHz) / rateIn;
+  int taps = (int)ceilf((Astop - 8.0) / (2.285 * transition)) + 1;
+  int pairs = (taps + 1 + 3) / 4;
+  if (pairs > RX_DEC_MAX_PAIRS) pairs = RX_DEC_MAX_PAIRS;
+  if (pairs < 1) pairs = 1;
+  stage->pairs = pairs;
+
+  float32_t beta = 0.1102 * (Astop - 8.71);
+  float32_t izb = Izero(beta);
+  int centre = 2 * pairs - 1;
+  for (int j = 0; j < pairs; j++) {
+    int k = 2 * j + 1;
+    float32_t x = (float32_t)k / (float32_t)centre;
+    float32_t w = Izero(beta * sqrtf(fmaxf(0.0, 1.0 - x * x))) / izb;
+    float32_t sinc = ((j & 1) ? -1.0 : 1.0) / (PI * k);  // sin(PI * k / 2) / (PI * k)
+    stage->coeffs[j] = sinc * w;
+  }
+}
+
+/*****
+  Purpose: Run one half-band stage on the block already in its history buffer
+
+  Parameter list:
+    struct halfBandStage *stage   stage to run
+    uint32_t numIn                complex input samples, even
+    float32_t *out                interleaved I/Q output, numIn / 2 samples
+
+  Return value:
+    void
+*****/
+static void HalfBandDecimate(struct halfBandStage *stage, uint32_t numIn, float32_t *out) {
+  const int pairs = stage->pairs;
+  const int centre = 2 * pairs - 1;
+  const float32_t *h = stage->coeffs;
+
+  for (uint32_t n = 0; n < numIn / 2; n++) {
+    const float32_t *mid = stage->state + 2 * (2 * n + centre);
+    float32_t re = 0.5 * mid[0];
+    float32_t im = 0.5 * mid[1];
+    for (int j = 0; j < pairs; j++) {
+      const float32_t *older = mid - 2 * (2 * j + 1);
+      const float32_t *newer = mid + 2 * (2 * j + 1);
+      re += h[j] * (older[0] + newer[0]);
+      im += h[j] * (older[1] + newer[1]);
+    }
+    out[2 * n] = re;
+    out[2 * n + 1] = im;
+  }
+  // Keep the last taps - 1 samples for the next block
+  memmove(stage->state, stage->state + 2 * numIn, 2 * (4 * pairs - 2) * sizeof(float32_t));
+}
+
+/*****
+  Purpose: Design the receive decimation filters and clear their history
+
+  Parameter list:
+    void
+
+  Return value:
+    void
+*****/
+void InitRxDecimator() {
+  float32_t *states[RX_DEC_STAGES] = { rxDecState1, rxDecState2, rxDecState3 };
+  float32_t rate = (float32_t)SR[SampleRate].rate;
+
+  for (int i = 0; i < RX_DEC_STAGES; i++) {
+    DesignHalfBand(&rxDec[i], RX_DEC_PASS_HZ, rate, n_att);
+    rxDec[i].maxIn = RX_DEC_MAX_IN >> i;
+    rxDec[i].state = states[i];
+    memset(states[i], 0, 2 * (4 * RX_DEC_MAX_PAIRS - 2 + rxDec[i].maxIn) * sizeof(float32_t));
+    rate /= 2.0;
+  }
+}
+
+/*****
+  Purpose: Where the next block of receive I/Q at the ADC rate goes, in the history of the first
+           decimation stage.  It stays valid until RxDecimate() has run.
+
+  Parameter list:
+    void
+
+  Return value:
+    float32_t *         room for BUFFER_SIZE * N_B samples, interleaved I, Q
+*****/
+float32_t *RxDecimatorInput() {
+  struct halfBandStage *first = &rxDec[0];
+  return first->state + 2 * (4 * first->pairs - 2);
+}
+
+/*****
+  Purpose: Decimate the receive I/Q stream by 8 (DF1 * DF2)
+
+  Parameter list:
+    float32_t *IQ_out                 blockSize / 8 samples, interleaved I, Q
+    uint32_t blockSize                samples already written at RxDecimatorInput(), a multiple of 8
+                                      and no more than BUFFER_SIZE * N_B
+
+  Return value:
+    void
+*****/
+void RxDecimate(float32_t *IQ_out, uint32_t blockSize) {
+  uint32_t numIn = blockSize;
+  for (int i = 0; i < RX_DEC_STAGES - 1; i++) {
+    struct halfBandStage *next = &rxDec[i + 1];
+    HalfBandDecimate(&rxDec[i], numIn, next->state + 2 * (4 * next->pairs - 2));
+    numIn /= 2;
+  }
+  HalfBandDecimate(&rxDec[RX_DEC_STAGES - 1], numIn, IQ_out);
+}
+
+/*****
+  Purpose: Group delay of the receive decimator.  Each half-band is linear phase, so its delay is half
+           its length, at its own input rate.
+
+  Parameter list:
+    void
+
+  Return value:
+    uint32_t            delay in samples at the ADC rate
+*****/
+uint32_t RxDecimatorDelay() {
+  uint32_t delay = 0;
+  for (int i = 0; i < RX_DEC_STAGES; i++) {
+    delay += (2 * rxDec[i].pairs - 1) << i;
+  }
+  return delay;
+}
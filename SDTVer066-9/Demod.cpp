@@ -2,7 +2,49 @@
 #include "SDT.h"
 #endif
 
+/*****
+  Sideband selection for SAM.  Two chains of allpass sections, y[n] = c * (x[n] + y[n-2]) - x[n-2],
+  whose outputs stay 90 degrees apart (within a degree) from 50 Hz to 10 kHz at 24K SPS, once the
+  first one is delayed by a sample.  The coefficients are Olli Niemitalo's, squared.  The in-phase
+  detector output goes through the first chain and the quadrature one through the second; their sum
+  keeps one sideband and their difference the other.
+*****/
+#define SAM_ALLPASS_STAGES 4
+
+static const float32_t samAllpassI[SAM_ALLPASS_STAGES] = { 0.4794008656, 0.8762184935, 0.9765975895, 0.9974992559 };
+static const float32_t samAllpassQ[SAM_ALLPASS_STAGES] = { 0.1617584984, 0.7330289323, 0.9453497003, 0.9905991567 };
+static float32_t samAllpassStateI[2 * SAM_ALLPASS_STAGES + 2];  // x[n-1], x[n-2] of every node of the chain
+static float32_t samAllpassStateQ[2 * SAM_ALLPASS_STAGES + 2];
+static float32_t samDelayI = 0.0;
+static float32_t samCarrierCos = 1.0;  // The PLL carrier, advanced by a rotation each sample
+static float32_t samCarrierSin = 0.0;
 
+/*****
+  Purpose: Run a block through one allpass chain, in place
+
+  Parameter list:
+    float32_t *buffer           samples
+    const float32_t *coeffs     SAM_ALLPASS_STAGES coefficients
+    float32_t *state            chain history
+    uint32_t count              number of samples
+
+  Return value;
+    void
+*****/
+static void SAMAllpass(float32_t *buffer, const float32_t *coeffs, float32_t *state, uint32_t count) {
+  for (uint32_t i = 0; i < count; i++) {
+    float32_t x = buffer[i];
+    for (int k = 0; k < SAM_ALLPASS_STAGES; k++) {
+      float32_t y = coeffs[k] * (x + state[2 * k + 3]) - state[2 * k + 1];
+      state[2 * k + 1] = state[2 * k];
+      state[2 * k] = x;
+      x = y;
+    }
+    state[2 * SAM_ALLPASS_STAGES + 1] = state[2 * SAM_ALLPASS_STAGES];
+    state[2 * SAM_ALLPASS_STAGES] = x;
+    buffer[i] = x;
+  }
+}
 
 /*****  AFP 11-03-22
   Purpose: AMDecodeSAM()
@@ -14,49 +56,25 @@
   This alogorithm works best of those implimented
       // taken from Warren Pratt´s WDSP, 2016
   // http://svn.tapr.org/repos_sdr_hpsdr/trunk/W5WC/PowerSDR_HPSDR_mRX_PS/Source/wdsp/
+
+  The PLL carrier is a unit phasor turned by the loop filter output every sample, so there is no sin()
+  or cos() per sample.  samSideband picks both sidebands (SAM_DSB) or one of them.  The carrier offset
+  is only stored in SAM_carrier_freq_offset; ShowSAMCarrierOffset() draws it from loop().
 *****/
 void AMDecodeSAM() {
- //
-  // taken from Warren Pratt´s WDSP, 2016
-  // http://svn.tapr.org/repos_sdr_hpsdr/trunk/W5WC/PowerSDR_HPSDR_mRX_PS/Source/wdsp/
-  // http://svn.tapr.org/repos_sdr_hpsdr/trunk/W5WC/PowerSDR_HPSDR_mRX_PS/Source/wdsp/
- // phzerror = 0;
-  tft.setFontScale((enum RA8875tsize)0);
-  //tft.fillRect(OPERATION_STATS_X + 150, FREQUENCY_Y + 33, tft.getFontWidth() * 11, tft.getFontHeight(), RA8875_BLUE);  // AFP 11-01-22 Clear top-left menu area
-  //tft.setCursor(OPERATION_STATS_X + 150, FREQUENCY_Y + 33);                                                            // AFP 11-01-22
-  //tft.setTextColor(RA8875_WHITE);
-  // tft.fill//Rect(OPERATION_STATS_X + 155, FREQUENCY_Y + 30, tft.getFontWidth() * 11, tft.getFontHeight(), RA8875_BLUE);
-  //tft.print("(SAM) ");  //AFP 11-01-22
-  for (unsigned i = 0; i < FFT_length / 2; i++) {
-    float32_t Sin, Cos;
-    Sin = arm_sin_f32(phzerror);
-    Cos = arm_cos_f32(phzerror);
-
-    ai = Cos * iFFT_buffer[FFT_length + i * 2];
-    bi = Sin * iFFT_buffer[FFT_length + i * 2];
-    aq = Cos * iFFT_buffer[FFT_length + i * 2 + 1];
-    bq = Sin * iFFT_buffer[FFT_length + i * 2 + 1];
-
-    corr[0] = +ai + bq;
-    corr[1] = -bi + aq;
-
-    audio = (ai - bi) + (aq + bq);
-    // audio = (ai_ps - bi_ps) + (aq_ps + bq_ps);
-
-    if (fade_leveler) {
-      dc = mtauR * dc + onem_mtauR * audio;
-      dc_insert = mtauI * dc_insert + onem_mtauI * corr[0];
-      audio = audio + dc_insert - dc;
-    }
-    float_buffer_L[i] = audio;
-    //if (bands[current_band].mode == DEMOD_SAM_STEREO)
-    //{
-    if (fade_leveler) {
-      dcu = mtauR * dcu + onem_mtauR * audiou;
-      dc_insertu = mtauI * dc_insertu + onem_mtauI * corr[0];
-      audiou = audiou + dc_insertu - dcu;
-    }
-    float_buffer_R[i] = audiou;
+  const uint32_t count = BUF_N_DF;
+
+  // The PLL has to see every sample before the next one is mixed, so this part cannot be vectorized.
+  // The detector outputs go to float_buffer_L (in phase) and float_buffer_R (quadrature).
+  for (uint32_t i = 0; i < count; i++) {
+    float32_t re = rxFilteredIQ[i * 2];
+    float32_t im = rxFilteredIQ[i * 2 + 1];
+
+    corr[0] = samCarrierCos * re + samCarrierSin * im;
+    corr[1] = samCarrierCos * im - samCarrierSin * re;
+    float_buffer_L[i] = corr[0];
+    float_buffer_R[i] = corr[1];
+
     det = ApproxAtan2(corr[1], corr[0]);
 
     del_out = fil_out;
@@ -64,38 +82,48 @@ void AMDecodeSAM() {
     if (omega2 < omega_min) omega2 = omega_min;
     else if (omega2 > omega_max) omega2 = omega_max;
     fil_out = g1 * det + omega2;
-    phzerror = phzerror + del_out;
 
-    //wrap round 2PI, modulus
-    while (phzerror >= TPI) phzerror -= TPI;
-    while (phzerror < 0.0) phzerror += TPI;
-   // while (phzerror < -TPI) phzerror += TPI;
+    // Turn the carrier by del_out.  |del_out| stays below about 1.1 rad, where these series are good to
+    // 0.2%, and the loop takes out any phase error that is left.  The last step pulls the length back to 1.
+    float32_t d2 = del_out * del_out;
+    float32_t stepSin = del_out * (1.0 - d2 / 6.0 * (1.0 - d2 / 20.0));
+    float32_t stepCos = 1.0 - d2 / 2.0 * (1.0 - d2 / 12.0);
+    float32_t carrierCos = samCarrierCos * stepCos - samCarrierSin * stepSin;
+    float32_t carrierSin = samCarrierSin * stepCos + samCarrierCos * stepSin;
+    float32_t norm = 1.5 - 0.5 * (carrierCos * carrierCos + carrierSin * carrierSin);
+    samCarrierCos = carrierCos * norm;
+    samCarrierSin = carrierSin * norm;
   }
 
-  //arm_copy_f32(float_buffer_L, float_buffer_R, FFT_length);
-  //}
-  //        SAM_display_count++;
-  //        if(SAM_display_count > 50) // to display the exact carrier frequency that the PLL is tuned to
-  //        if(0)
-  // in the small frequency display
-  // we calculate carrier offset here and the display function is
-  // then called in main loop every 100ms
-  //{ // to make this smoother, a simple lowpass/exponential averager here . . .
-  SAM_carrier =  (omega2 * 24000) / (2 * TPI);
-
-  //SAM_carrier = SAM_carrier + 0.92 * SAM_lowpass;
-  SAM_carrier_freq_offset = (int)10 * SAM_carrier;
-  SAM_carrier_freq_offset = 0.95 * SAM_carrier_freq_offsetOld + 0.05 * SAM_carrier_freq_offset;
-  //            SAM_display_count = 0;
-  //SAM_lowpass = SAM_carrier;
+  if (samSideband != SAM_DSB) {
+    SAMAllpass(float_buffer_L, samAllpassI, samAllpassStateI, count);
+    SAMAllpass(float_buffer_R, samAllpassQ, samAllpassStateQ, count);
+    // The in-phase chain runs one sample behind the quadrature chain
+    float32_t last = float_buffer_L[count - 1];
+    memmove(&float_buffer_L[1], &float_buffer_L[0], (count - 1) * sizeof(float32_t));
+    float_buffer_L[0] = samDelayI;
+    samDelayI = last;
+    if (samSideband == SAM_USB) {
+      arm_add_f32(float_buffer_L, float_buffer_R, float_buffer_L, count);
+    } else {
+      arm_sub_f32(float_buffer_L, float_buffer_R, float_buffer_L, count);
+    }
+  }
 
-  //if (SAM_carrier_freq_offset != SAM_carrier_freq_offsetOld) {
-    tft.setCursor(300, FREQUENCY_Y + 33);
-    tft.fillRect(300, FREQUENCY_Y + 33, tft.getFontWidth() * 7, tft.getFontHeight(), RA8875_BLUE);
-    tft.print(0.20000012146 * SAM_carrier_freq_offset, 2);  //AFP 11-01-22
- // }
- SAM_carrier_freq_offsetOld=SAM_carrier_freq_offset;
+  if (fade_leveler) {
+    // Swap the carrier level in the audio, which follows the fading, for a slow average of it
+    for (uint32_t i = 0; i < count; i++) {
+      float32_t sample = float_buffer_L[i];
+      dc = mtauR * dc + onem_mtauR * sample;
+      dc_insert = mtauI * dc_insert + onem_mtauI * sample;
+      float_buffer_L[i] = sample + dc_insert - dc;  // Mono; the right channel is filled at the output of ProcessIQData()
+    }
+  }
 
+  SAM_carrier = (omega2 * 24000) / (2 * TPI);
+  SAM_carrier_freq_offset = (int)10 * SAM_carrier;
+  SAM_carrier_freq_offset = 0.95 * SAM_carrier_freq_offsetOld + 0.05 * SAM_carrier_freq_offset;
+  SAM_carrier_freq_offsetOld = SAM_carrier_freq_offset;
 }
 
 /*****  AFP 11-03-22
@@ -124,19 +152,19 @@ float ApproxAtan2(float y, float x) {
       const float z = x / y;
       if (y > 0.0f) {
         // atan2(y,x) = PI/2 - atan(x/y) if |y/x| > 1, y > 0
-        return -ApproxAtan(z) + TPI;
+        return -ApproxAtan(z) + PIH;
       } else {
         // atan2(y,x) = -PI/2 - atan(x/y) if |y/x| > 1, y < 0
-        return -ApproxAtan(z) - TPI;
+        return -ApproxAtan(z) - PIH;
       }
     }
   } else {
     if (y > 0.0f)  // x = 0, y > 0
     {
-      return TPI;
+      return PIH;
     } else if (y < 0.0f)  // x = 0, y < 0
     {
-      return -TPI;
+      return -PIH;
     }
   }
   return 0.0f;  // x,y = 0. Could return NaN instead.
@@ -63,14 +63,58 @@ void ShowName() {
   tft.print(VERSION);
 }
 
+// ShowSpectrum() frame state.  A frame is drawn from a snapshot of pixelnew[] and audioYPixel[] taken when
+// the frame starts, so the DSP can compute the next spectrum while this one is still being drawn.
+static int spectrumColumn = 0;                     // Next column to draw, 0 = no frame in progress
+static int16_t pixelSnapshot[SPECTRUM_RES];        // Spectrum being drawn
+static int16_t pixelErase[SPECTRUM_RES];           // Spectrum left on screen by the last frame
+static int16_t audioYPixelSnapshot[256];           // Audio spectrum being drawn
+static int filterLoMarkerX, filterHiMarkerX;       // Filter lines on the audio spectrum
+
+/*****
+  Purpose: Draw the filter lines on the audio spectrum plot  AFP 10-30-22
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+static void DrawAudioFilterLines() {
+  tft.drawLine(filterLoMarkerX, SPECTRUM_BOTTOM - 3, filterLoMarkerX, SPECTRUM_BOTTOM - 112, RA8875_LIGHT_GREY);
+  tft.drawLine(filterHiMarkerX, SPECTRUM_BOTTOM - 3, filterHiMarkerX, SPECTRUM_BOTTOM - 112, RA8875_LIGHT_GREY);
+}
+
+/*****
+  Purpose: Wait for the RA8875 to finish a block transfer, draining the receive audio while it works.
+           The display must not be written during the move, so displayBusy holds off the drawing done
+           from ProcessIQData() and the encoders are left for the next ServiceReceiveDSP().
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+static void WaitForDisplayBTE() {
+  displayBusy = 1;
+  while (tft.readStatus()) {  // Memory moves can take time.
+    if ((uint32_t)Q_in_L.available() > N_BLOCKS && (uint32_t)Q_in_R.available() > N_BLOCKS) {
+      DrainReceiveAudio();
+    }
+  }
+  displayBusy = 0;
+}
+
 FASTRUN  // Place in tightly-coupled memory
          /*****
   Purpose: Show Spectrum display
-            Note that this routine calls the Audio process Function during each display cycle,
-            for each of the 512 display frequency bins.  This means that the audio is refreshed at the maximum rate
-            and does not have to wait for the display to complete drawinf the full spectrum.
-            However, the display data are only updated ONCE during each full display cycle,
-            ensuring consistent data for the erase/draw cycle at each frequency point.
+            The receive DSP runs independently of the drawing: ServiceReceiveDSP() is called on entry and
+            again whenever a full set of audio blocks is queued between two columns, so audio is never held
+            up by the display.  Each call draws at most SPECTRUM_SLICE_COLUMNS columns and returns, letting
+            loop() read the buttons and encoders mid-frame.
+            A frame starts only when the spectrum FFT has a new one ready.  It is copied to a snapshot so the
+            erase/draw cycle at each frequency point always uses consistent data.
 
   Parameter list:
     void
@@ -83,29 +127,64 @@ FASTRUN  // Place in tightly-coupled memory
   int centerLine = (MAX_WATERFALL_WIDTH + SPECTRUM_LEFT_X) / 2;
   int middleSlice = centerLine / 2;  // Approximate center element
   int x1 = 0;
+  int lastColumn;
   int filterLoPositionMarker;
   int filterHiPositionMarker;
   int y_new_plot, y1_new_plot, y_old_plot, y_old2_plot;
 
-  pixelnew[0] = 0;
-  pixelnew[1] = 0;
-  pixelCurrent[0] = 0;
-  pixelCurrent[1] = 0;
-
-  for (x1 = 1; x1 < MAX_WATERFALL_WIDTH - 1; x1++)  // Draws the main Spectrum, Waterfall and Audio displays
-  {                                                 // Update the frequency here only.  This is the beginning of the 512 wide spectrum display.
-    if (x1 == 1) {
-      updateDisplayFlag = 1;  //Set flag so the display data are saved only once during each display refresh cycle at the start of the cycle, not 512 times
-    } else
-      updateDisplayFlag = 0;  //  Do not save the the display data for the remainder of the
-
-    FilterSetSSB();       // Insert Filter encoder update here  AFP 06-22-22
-    ProcessIQData();      // Call the Audio process from within the display routine to eliminate conflicts with drawing the spectrum and waterfall displays
-    EncoderCenterTune();  // Moved the tuning encoder to reduce lag times and interference during tuning.
-    y_new = pixelnew[x1];
-    y1_new = pixelnew[x1 - 1];
-    y_old = pixelold[x1];  // pixelold spectrum is saved by the FFT function prior to a new FFT which generates the pixelnew spectrum.  KF5N
-    y_old2 = pixelold[x1 - 1];
+  ServiceReceiveDSP();
+  if (radioState == CW_TRANSMIT_STRAIGHT_STATE || radioState == CW_TRANSMIT_KEYER_STATE) {  //AFP 09-01-22
+    spectrumColumn = 0;  // Abandon the frame; pixelCurrent[] records what is on screen
+    return;
+  }
+
+  if (spectrumColumn == 0) {  // Start a new frame
+    if (spectrumFrameReady == 0) {
+      updateDisplayFlag = 1;  // Nothing new to draw yet; make sure the DSP is computing a frame
+      return;
+    }
+    memcpy(pixelSnapshot, pixelnew, sizeof(pixelSnapshot));
+    memcpy(pixelErase, pixelCurrent, sizeof(pixelErase));  // pixelCurrent is what is actually on screen, even after a CW interrupt.  KF5N
+    memcpy(audioYPixelSnapshot, audioYPixel, sizeof(audioYPixelSnapshot));
+    spectrumFrameReady = 0;
+    updateDisplayFlag = 1;  // Ask the DSP for the next frame while this one is drawn
+    pixelSnapshot[0] = 0;
+    pixelSnapshot[1] = 0;
+    pixelCurrent[0] = 0;
+    pixelCurrent[1] = 0;
+
+    // The following lines calculate the position of the Filter bar below the spectrum display
+    // and the filter lines in the Audio spectrum container to the right of the Main spectrum display
+    filterLoPositionMarker = map(bands[currentBand].FLoCut, 0, 6000, 0, 256);
+    filterHiPositionMarker = map(bands[currentBand].FHiCut, 0, 6000, 0, 256);
+    filterLoMarkerX = 534 + abs(filterLoPositionMarker);
+    filterHiMarkerX = 533 + abs(filterHiPositionMarker);
+    if (filterLoPositionMarker != filterLoPositionMarkerOld || filterHiPositionMarker != filterHiPositionMarkerOld) {
+      DrawBandWidthIndicatorBar();
+    }
+    filterLoPositionMarkerOld = filterLoPositionMarker;
+    filterHiPositionMarkerOld = filterHiPositionMarker;
+    DrawAudioFilterLines();
+    spectrumColumn = 1;
+  }
+
+  lastColumn = spectrumColumn + SPECTRUM_SLICE_COLUMNS;
+  if (lastColumn > MAX_WATERFALL_WIDTH - 1) {
+    lastColumn = MAX_WATERFALL_WIDTH - 1;
+  }
+  for (x1 = spectrumColumn; x1 < lastColumn; x1++)  // Draws the main Spectrum, Waterfall and Audio displays
+  {
+    if ((uint32_t)Q_in_L.available() > N_BLOCKS) {  // Audio first: pre-empt the drawing as soon as a block set is waiting
+      ServiceReceiveDSP();
+      if (radioState == CW_TRANSMIT_STRAIGHT_STATE || radioState == CW_TRANSMIT_KEYER_STATE) {
+        spectrumColumn = 0;
+        return;
+      }
+    }
+    y_new = pixelSnapshot[x1];
+    y1_new = pixelSnapshot[x1 - 1];
+    y_old = pixelErase[x1];
+    y_old2 = pixelErase[x1 - 1];
 
     y_new_plot = spectrumNoiseFloor - y_new - currentNoiseFloor[currentBand];
     y1_new_plot = spectrumNoiseFloor - y1_new - currentNoiseFloor[currentBand];
@@ -134,40 +213,22 @@ FASTRUN  // Place in tightly-coupled memory
     tft.drawLine(x1 + 1, y1_new_plot, x1 + 1, y_new_plot, RA8875_YELLOW);  // Draw new
 
     //  What is the actual spectrum at this time?  It's a combination of the old and new spectrums.
-    //  In the case of a CW interrupt, the array pixelnew should be saved as the actual spectrum.
-    pixelCurrent[x1] = pixelnew[x1];  //  This is the actual "old" spectrum!  This is required due to CW interrupts.  pixelCurrent gets copied to pixelold by the FFT function.  KF5N
-
-    if (x1 < 253) {                                                                             //AFP 09-01-22
-      if (radioState == CW_TRANSMIT_STRAIGHT_STATE || radioState == CW_TRANSMIT_KEYER_STATE) {  //AFP 09-01-22
-        return;                                                                                 //AFP 09-01-22
-      } else {                                                                                  //AFP 09-01-22
-                                                                                                //        tft.drawFastVLine(BAND_INDICATOR_X - 8 + x1, SPECTRUM_BOTTOM - 116, 115, RA8875_BLACK);  //AFP Erase old AUDIO spectrum line 247-116=
-        tft.drawFastVLine(532 + x1, 131, 115, RA8875_BLACK);                                    // 540 - 8 = 532
-        if (audioYPixel[x1] != 0) {
-          if (audioYPixel[x1] > CLIP_AUDIO_PEAK)  // audioSpectrumHeight = 118
-            audioYPixel[x1] = CLIP_AUDIO_PEAK;
-          if (x1 == middleSlice) {
-            smeterLength = y_new;
-          }
-          tft.drawFastVLine(532 + x1, AUDIO_SPECTRUM_BOTTOM - audioYPixel[x1] - 1, audioYPixel[x1] - 2, RA8875_MAGENTA);  //AFP draw new AUDIO spectrum line
+    //  In the case of a CW interrupt, the array pixelCurrent holds the actual spectrum.
+    pixelCurrent[x1] = pixelSnapshot[x1];  //  This is the actual "old" spectrum!  This is required due to CW interrupts.  KF5N
+
+    if (x1 < 253) {                                          //AFP 09-01-22
+      tft.drawFastVLine(532 + x1, 131, 115, RA8875_BLACK);  // Erase old AUDIO spectrum line.  540 - 8 = 532
+      if (audioYPixelSnapshot[x1] != 0) {
+        if (audioYPixelSnapshot[x1] > CLIP_AUDIO_PEAK)  // audioSpectrumHeight = 118
+          audioYPixelSnapshot[x1] = CLIP_AUDIO_PEAK;
+        if (x1 == middleSlice) {
+          smeterLength = y_new;
         }
-        tft.drawFastHLine(SPECTRUM_LEFT_X - 1, SPECTRUM_TOP_Y + SPECTRUM_HEIGHT, MAX_WATERFALL_WIDTH, RA8875_YELLOW);
-        // The following lines calculate the position of the Filter bar below the spectrum display
-        // and then draw the Audio spectrum in its own container to the right of the Main spectrum display
-
-        filterLoPositionMarker = map(bands[currentBand].FLoCut, 0, 6000, 0, 256);
-        filterHiPositionMarker = map(bands[currentBand].FHiCut, 0, 6000, 0, 256);
-        //Draw Fiter indicator lines on audio plot AFP 10-30-22
-        //        tft.drawLine(BAND_INDICATOR_X - 6 + abs(filterLoPositionMarker), SPECTRUM_BOTTOM - 3, BAND_INDICATOR_X - 6 + abs(filterLoPositionMarker), SPECTRUM_BOTTOM - 112, RA8875_LIGHT_GREY);
-        //        tft.drawLine(BAND_INDICATOR_X - 7 + abs(filterHiPositionMarker), SPECTRUM_BOTTOM - 3, BAND_INDICATOR_X - 7 + abs(filterHiPositionMarker), SPECTRUM_BOTTOM - 112, RA8875_LIGHT_GREY);
-        tft.drawLine(534 + abs(filterLoPositionMarker), SPECTRUM_BOTTOM - 3, 534 + abs(filterLoPositionMarker), SPECTRUM_BOTTOM - 112, RA8875_LIGHT_GREY);
-        tft.drawLine(533 + abs(filterHiPositionMarker), SPECTRUM_BOTTOM - 3, 533 + abs(filterHiPositionMarker), SPECTRUM_BOTTOM - 112, RA8875_LIGHT_GREY);
-
-        if (filterLoPositionMarker != filterLoPositionMarkerOld || filterHiPositionMarker != filterHiPositionMarkerOld) {
-          DrawBandWidthIndicatorBar();
-        }
-        filterLoPositionMarkerOld = filterLoPositionMarker;
-        filterHiPositionMarkerOld = filterHiPositionMarker;
+        tft.drawFastVLine(532 + x1, AUDIO_SPECTRUM_BOTTOM - audioYPixelSnapshot[x1] - 1, audioYPixelSnapshot[x1] - 2, RA8875_MAGENTA);  //AFP draw new AUDIO spectrum line
+      }
+      // Redraw a filter line on the audio plot only when the erase above has just passed over it
+      if (532 + x1 == filterLoMarkerX || 532 + x1 == filterHiMarkerX) {
+        DrawAudioFilterLines();
       }
     }
 
@@ -180,20 +241,20 @@ FASTRUN  // Place in tightly-coupled memory
     waterfall[x1] = gradient[test1];  // Try to put pixel values in middle of gradient array.  KF5N
     tft.writeTo(L1);
   }
-  // End for(...) Draw MAX_WATERFALL_WIDTH spectral points
-  // Use the Block Transfer Engine (BTE) to move waterfall down a line
-
-  if (radioState == CW_TRANSMIT_STRAIGHT_STATE || radioState == CW_TRANSMIT_KEYER_STATE) {  //AFP 09-01-22
-    return;
-  } else {
-    tft.BTE_move(WATERFALL_LEFT_X, FIRST_WATERFALL_LINE, MAX_WATERFALL_WIDTH, MAX_WATERFALL_ROWS - 2, WATERFALL_LEFT_X, FIRST_WATERFALL_LINE + 1, 1, 2);
-    while (tft.readStatus())  // Make sure it is done.  Memory moves can take time.
-      ;
-    // Now bring waterfall back to the beginning of the 2nd row.
-    tft.BTE_move(WATERFALL_LEFT_X, FIRST_WATERFALL_LINE + 1, MAX_WATERFALL_WIDTH, MAX_WATERFALL_ROWS - 2, WATERFALL_LEFT_X, FIRST_WATERFALL_LINE + 1, 2);
-    while (tft.readStatus())  // Make sure it's done.
-      ;
+  spectrumColumn = lastColumn;
+  if (spectrumColumn < MAX_WATERFALL_WIDTH - 1) {
+    return;  // Rest of the frame on the next call
   }
+  // End of frame: all MAX_WATERFALL_WIDTH spectral points drawn
+  spectrumColumn = 0;
+  tft.drawFastHLine(SPECTRUM_LEFT_X - 1, SPECTRUM_TOP_Y + SPECTRUM_HEIGHT, MAX_WATERFALL_WIDTH, RA8875_YELLOW);
+
+  // Use the Block Transfer Engine (BTE) to move waterfall down a line
+  tft.BTE_move(WATERFALL_LEFT_X, FIRST_WATERFALL_LINE, MAX_WATERFALL_WIDTH, MAX_WATERFALL_ROWS - 2, WATERFALL_LEFT_X, FIRST_WATERFALL_LINE + 1, 1, 2);
+  WaitForDisplayBTE();
+  // Now bring waterfall back to the beginning of the 2nd row.
+  tft.BTE_move(WATERFALL_LEFT_X, FIRST_WATERFALL_LINE + 1, MAX_WATERFALL_WIDTH, MAX_WATERFALL_ROWS - 2, WATERFALL_LEFT_X, FIRST_WATERFALL_LINE + 1, 2);
+  WaitForDisplayBTE();
   // Then write new row data into the missing top row to get a scroll effect using display hardware, not the CPU.
   tft.writeRect(WATERFALL_LEFT_X, FIRST_WATERFALL_LINE, MAX_WATERFALL_WIDTH, 1, waterfall);
 }
@@ -501,6 +562,8 @@ void ShowAnalogGain() {
   }
 }
 
+static float32_t samOffsetShown = -1.0e9;  // Carrier offset on the screen; BandInformation() draws over it
+
 /*****
   Purpose: To display the current transmission frequency, band, mode, and sideband above the spectrum display
 
@@ -605,8 +668,15 @@ void BandInformation()  // SSB or CW
       tft.setTextColor(RA8875_WHITE);
       tft.print("(AM)");  //AFP 09-22-22
       break;
-    case DEMOD_SAM:         //AFP 11-01-22
-      tft.print("(SAM) ");  //AFP 11-01-22
+    case DEMOD_SAM:  //AFP 11-01-22
+      if (samSideband == SAM_LSB) {
+        tft.print("SAM-L");
+      } else if (samSideband == SAM_USB) {
+        tft.print("SAM-U");
+      } else {
+        tft.print("(SAM) ");  //AFP 11-01-22
+      }
+      samOffsetShown = -1.0e9;
       break;
   }
   ShowCurrentPowerSetting();
@@ -614,6 +684,33 @@ void BandInformation()  // SSB or CW
   tft.setFontScale((enum RA8875tsize)1);
 }
 
+/*****
+  Purpose: Show the carrier offset the SAM PLL has locked to, next to the mode.  AMDecodeSAM() only
+           stores it, so the TFT is never written from inside the audio processing.
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+void ShowSAMCarrierOffset() {
+  if (bands[currentBand].mode != DEMOD_SAM) {
+    return;
+  }
+  float32_t offset = 0.20000012146 * SAM_carrier_freq_offset;  //AFP 11-01-22
+  if (fabsf(offset - samOffsetShown) < 0.005) {  // Same as the last 2 decimal readout
+    return;
+  }
+  samOffsetShown = offset;
+  tft.setFontScale((enum RA8875tsize)0);
+  tft.setTextColor(RA8875_WHITE);
+  tft.fillRect(300, FREQUENCY_Y + 33, tft.getFontWidth() * 7, tft.getFontHeight(), RA8875_BLUE);
+  tft.setCursor(300, FREQUENCY_Y + 33);
+  tft.print(offset, 2);
+  tft.setFontScale((enum RA8875tsize)1);
+}
+
 /*****
   Purpose: Display current power setting
 
@@ -1244,6 +1341,9 @@ void UpdateDecoderField() {
   } else {
     tft.print("Off");
   }
+  if (cwSkimmerOn) {
+    tft.print(" Skim");
+  }
   if (xmtMode == CW_MODE && decoderFlag == DECODE_ON) {  // In CW mode with decoder on? AFP 09-27-22
                                                          //    tft.setFontScale((enum RA8875tsize)0);
     tft.setTextColor(RA8875_LIGHT_GREY);
@@ -1326,7 +1426,7 @@ void UpdateKeyTypeField() {
     void
 *****/
 void UpdateNoiseField() {
-  const char *filter[] = { "Off", "Kim", "Spectral", "LMS" };  //AFP 09-19-22
+  const char *filter[] = { "Off", "Kim", "Spectral", "LMS", "Spec FFT" };  //AFP 09-19-22
 
   tft.setFontScale((enum RA8875tsize)0);
 
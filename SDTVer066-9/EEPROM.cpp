@@ -209,6 +209,9 @@ FLASHMEM void EEPROMRead() {
   receiveEQFlag = EEPROMData.receiveEQFlag;
   xmitEQFlag = EEPROMData.xmitEQFlag;
   CWToneIndex = EEPROMData.CWToneIndex;
+  NB_RF_on = EEPROMData.NB_RF_on;
+  rxLatencyMode = EEPROMData.rxLatencyMode;  // setup() applies it with SetRxLatencyMode()
+  rxConvMode = EEPROMData.rxConvMode;        // and this one with SetRxConvMode()
 
   transmitPowerLevelCW = EEPROMData.TransmitPowerLevelCW;    // Power level factors by mode
   transmitPowerLevelSSB = EEPROMData.TransmitPowerLevelSSB;  // Power level factors by mode
@@ -329,6 +332,9 @@ FLASHMEM void EEPROMWrite() {
   EEPROMData.receiveEQFlag = receiveEQFlag;
   EEPROMData.xmitEQFlag = xmitEQFlag;
   EEPROMData.CWToneIndex = CWToneIndex;
+  EEPROMData.NB_RF_on = NB_RF_on;
+  EEPROMData.rxLatencyMode = rxLatencyMode;
+  EEPROMData.rxConvMode = rxConvMode;
 
 
   EEPROMData.TransmitPowerLevelCW = transmitPowerLevelCW;    // Power level factors by mode
@@ -650,6 +656,12 @@ FLASHMEM void EEPROMShow() {
   Serial.println(EEPROMData.xmitEQFlag);
   Serial.print(F("CWToneIndex                     = "));
   Serial.println(EEPROMData.CWToneIndex);
+  Serial.print(F("NB_RF_on                        = "));
+  Serial.println(EEPROMData.NB_RF_on);
+  Serial.print(F("rxLatencyMode                   = "));
+  Serial.println(EEPROMData.rxLatencyMode);
+  Serial.print(F("rxConvMode                      = "));
+  Serial.println(EEPROMData.rxConvMode);
 
   Serial.print(F("TransmitPowerLevelCW            = "));
   Serial.println(EEPROMData.TransmitPowerLevelCW);
@@ -1117,6 +1129,9 @@ FLASHMEM void EEPROMSaveDefaults2() {
   EEPROMData.receiveEQFlag = 0;  // JJP 2/29/2024
   EEPROMData.xmitEQFlag = 0;
   EEPROMData.CWToneIndex = 0;
+  EEPROMData.NB_RF_on = 0;
+  EEPROMData.rxLatencyMode = RX_LATENCY_NORMAL;
+  EEPROMData.rxConvMode = RX_CONV_STANDARD;
 
   EEPROMData.TransmitPowerLevelCW = 0.0;
   EEPROMData.TransmitPowerLevelSSB = 0.0;
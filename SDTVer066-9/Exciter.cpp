@@ -14,12 +14,10 @@
     1.  Read in the data from the ADC into the Left Channel at 192KHz
     2.  Format the L data and Decimate (downsample and filter)the sampled data by x8
           - the new effective sampling rate is now 24KHz
-    3.  Process the L data through the 7 EQ filters and combine to a single data stream
-    4.  Copy the L channel to the R channel
-    5.  Process the R and L through two Hilbert Transformers - L 0deg phase shift and R 90 deg ph shift
-          - This create the I (L) and Q(R) channels
-    6.  Interpolate 8x (upsample and filter) the data stream to 192KHz sample rate
-    7.  Output the data stream thruogh the DACs at 192KHz
+    3.  Filter the L data with the SSB modulator, which applies the transmit EQ and bandpass and
+          creates the I (L) and Q (R) channels
+    4.  Interpolate 8x (upsample and filter) the data stream to 192KHz sample rate
+    5.  Output the data stream thruogh the DACs at 192KHz
 *****/
 void ExciterIQData() {
   uint32_t N_BLOCKS_EX = N_B_EX;
@@ -36,6 +34,8 @@ void ExciterIQData() {
   // are there at least N_BLOCKS buffers in each channel available ?
   if ((uint32_t)Q_in_L_Ex.available() > N_BLOCKS_EX + 0 && (uint32_t)Q_in_R_Ex.available() > N_BLOCKS_EX + 0) 
   {
+    PROFILE_BEGIN(profileTotal);
+    PROFILE_BEGIN(profileMark);
 
     // get audio samples from the audio  buffers and convert them to float
     // read in 32 blocks á 128 samples in I and Q
@@ -52,6 +52,7 @@ void ExciterIQData() {
       Q_in_L_Ex.freeBuffer();
       Q_in_R_Ex.freeBuffer();
     }
+    PROFILE_MARK(PROF_TX_Q15_TO_FLOAT, profileMark);
     /**********************************************************************************  AFP 12-31-20
               Decimation is the process of downsampling the data stream and LP filtering
               Decimation is done in two stages to prevent reversal of the spectrum, which occure with each even
@@ -67,6 +68,7 @@ void ExciterIQData() {
     // decimation-by-2 in-place
     arm_fir_decimate_f32(&FIR_dec2_EX_I, float_buffer_L_EX, float_buffer_L_EX, 512);
     arm_fir_decimate_f32(&FIR_dec2_EX_Q, float_buffer_R_EX, float_buffer_R_EX, 512);
+    PROFILE_MARK(PROF_TX_DECIMATE, profileMark);
     // 24KSPS effective sample rate here
     // Set up for calibration routines
     if (twoToneFlag == 0 && IQCalFlag == 0 && SSB_PA_CalFlag == 0) SSB_CalModeTask = 0;  // Regular operation
@@ -93,37 +95,13 @@ void ExciterIQData() {
     }
    arm_scale_f32(float_buffer_L_EX, (float)XAttenSSB[currentBand] / 10, float_buffer_L_EX, 256);
     arm_scale_f32(float_buffer_R_EX, (float)XAttenSSB[currentBand] / 10, float_buffer_R_EX, 256);
+    PROFILE_MARK(PROF_TX_LEVEL, profileMark);
 
-    //============================  Transmit EQ  ========================  AFP 10-02-22
-    if (xmitEQFlag == ON) {
-      DoExciterEQ();
-    }
-    //============================ End Receive EQ  AFP 10-02-22
-    arm_copy_f32(float_buffer_L_EX, float_buffer_R_EX, 256);
-    //  The following converts th sample rate to 12K SPS, applies the Hilbert transforms and then interpolates back to 24K SP.
-    //The objective is to extend the lower frequency rnge of the Hilbert transfrom by moving the lowewr limit of the Hilbert usefullness down to below 200Hz.
-
-    //Decimate by 2 to 12K SPS sample rate
-    arm_fir_decimate_f32(&FIR_dec3_EX_I, float_buffer_L_EX, float_buffer_L_EX, 256);
-    arm_fir_decimate_f32(&FIR_dec3_EX_Q, float_buffer_R_EX, float_buffer_R_EX, 256);
-    //Hilbert transforms at 12K, with 5KHz bandwidth, buffer size 128
-    arm_fir_f32(&FIR_Hilbert_L, float_buffer_L_EX, float_buffer_L_EX, 128);
-    arm_fir_f32(&FIR_Hilbert_R, float_buffer_R_EX, float_buffer_R_EX, 128);
-    //Interpolate back to 24K SPS
-    arm_fir_interpolate_f32(&FIR_int3_EX_I, float_buffer_L_EX, float_buffer_LTemp, 128);
-    arm_fir_interpolate_f32(&FIR_int3_EX_Q, float_buffer_R_EX, float_buffer_RTemp, 128);
-    //Back to 24000 SPS
-    //Scale to equalize levels
-    arm_scale_f32(float_buffer_LTemp, 3.5, float_buffer_L_EX, 256);
-    arm_scale_f32(float_buffer_RTemp, 3.5, float_buffer_R_EX, 256);
-
+    //============================  SSB modulator  ========================
+    // Transmit EQ, bandpass and the 90 degree I/Q split as one FFT filter, see SSBModulator.cpp
+    SSBModulate(float_buffer_L_EX, float_buffer_R_EX);
+    PROFILE_MARK(PROF_TX_SSB_MOD, profileMark);
 
-    /**********************************************************************************
-             R and L channels are processed though the two Hilbert Transformers, L at 0 deg and R at 90 deg
-             Tthe result are the quadrature data streans, I and Q necessary for Phasing calculations to
-             create the SSB signals.
-             Two Hilbert Transformers are used to preserve eliminate the relative time delays created during processing of the data
-    **********************************************************************************/
 
     //==== Uising Vol and Filter encoders afjust IQ calibration factors
     if (twoToneFlag == 0 && IQCalFlag == 1 && SSB_PA_CalFlag == 0) {
@@ -141,6 +119,7 @@ void ExciterIQData() {
       IQPhaseCorrection(float_buffer_L_EX, float_buffer_R_EX, IQXPhaseCorrectionFactor[currentBandA], 256);
     }
     arm_scale_f32(float_buffer_R_EX, 1.00, float_buffer_R_EX, 256);
+    PROFILE_MARK(PROF_TX_IQ_CORRECTION, profileMark);
 
     //exciteMaxL = 0;
 
@@ -158,6 +137,7 @@ void ExciterIQData() {
     //  192KHz effective sample rate here
     arm_scale_f32(float_buffer_L_EX, 20, float_buffer_L_EX, 2048);  //Scale to compensate for losses in Interpolation
     arm_scale_f32(float_buffer_R_EX, 20, float_buffer_R_EX, 2048);
+    PROFILE_MARK(PROF_TX_INTERPOLATE, profileMark);
 
     /**********************************************************************************  AFP 12-31-20
       CONVERT TO INTEGER AND PLAY AUDIO
@@ -172,6 +152,8 @@ void ExciterIQData() {
       Q_out_R_Ex.playBuffer();  // play it !
      
     }
+    PROFILE_MARK(PROF_TX_OUTPUT, profileMark);
+    PROFILE_MARK(PROF_TX_TOTAL, profileTotal);
   }
   
 }
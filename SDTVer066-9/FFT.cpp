@@ -34,16 +34,133 @@ void ZoomFFTPrep()
   zoom_sample_ptr = 0;
 }
 
+/*****
+  Spectrum post-processing shared by the display FFTs and the audio spectrum.  The Hann window is a
+  table, the bin powers come from arm_cmplx_mag_squared_f32(), and the smoothing is one pass of vector
+  operations.  Pixels are offset + dBScale * log10(power): log2 is the float's exponent plus a table
+  entry for its leading mantissa bits, so there is no cos() or log10f() per sample or bin.
+*****/
+#define SPECTRUM_LOG2_BITS 8  // Mantissa bits looked up; log2 is within 0.003, or 0.01 dB
+
+static float32_t spectrumWindow[SPECTRUM_RES];
+static float32_t spectrumLog2Mantissa[1 << SPECTRUM_LOG2_BITS];
+static bool spectrumTablesReady = false;
+
+/*****
+  Purpose: Fill in the window and log2 tables
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+static void SpectrumTablesInit() {
+  for (int i = 0; i < SPECTRUM_RES; i++) {
+    spectrumWindow[i] = 0.5 - 0.5 * cos(TWO_PI * i / SPECTRUM_RES);  // Hann
+  }
+  for (int m = 0; m < (1 << SPECTRUM_LOG2_BITS); m++) {  // log2 at the middle of each mantissa interval
+    spectrumLog2Mantissa[m] = log2(1.0 + (m + 0.5) / (1 << SPECTRUM_LOG2_BITS));
+  }
+  spectrumTablesReady = true;
+}
+
+/*****
+  Purpose: Window SPECTRUM_RES complex samples into buffer_spec_FFT, ready for the spectrum FFT
+
+  Parameter list:
+    const float32_t *I        in phase samples, every stride'th value
+    const float32_t *Q        quadrature samples, every stride'th value
+    int stride                2 for interleaved I/Q, 1 for separate buffers
+    float32_t gain            applied with the window
+
+  Return value;
+    void
+*****/
+static void SpectrumWindow(const float32_t *I, const float32_t *Q, int stride, float32_t gain) {
+  if (!spectrumTablesReady) {
+    SpectrumTablesInit();
+  }
+  for (int i = 0; i < SPECTRUM_RES; i++) {
+    float32_t w = gain * spectrumWindow[i];
+    buffer_spec_FFT[i * 2] = w * I[i * stride];
+    buffer_spec_FFT[i * 2 + 1] = w * Q[i * stride];
+  }
+}
+
+/*****
+  Purpose: FFT the windowed samples and smooth the bin powers into FFT_spec_old, with the negative
+           frequencies in the lower half.  FFT_spec is used as scratch.
+
+  Parameter list:
+    float32_t LPFcoeff        weight of the new frame, 0 to 1
+
+  Return value;
+    void
+*****/
+static void SpectrumPower(float32_t LPFcoeff) {
+  // perform complex FFT
+  // calculation is performed in-place the FFT_buffer [re, im, re, im, re, im . . .]
+  arm_cfft_f32(spec_FFT, buffer_spec_FFT, 0, 1);
+
+  // The power is enough, it is converted to dB anyway
+  arm_cmplx_mag_squared_f32(&buffer_spec_FFT[SPECTRUM_RES], FFT_spec, SPECTRUM_RES / 2);
+  arm_cmplx_mag_squared_f32(buffer_spec_FFT, &FFT_spec[SPECTRUM_RES / 2], SPECTRUM_RES / 2);
+
+  // FFT_spec_old += LPFcoeff * (FFT_spec - FFT_spec_old)
+  arm_sub_f32(FFT_spec, FFT_spec_old, FFT_spec, SPECTRUM_RES);
+  arm_scale_f32(FFT_spec, LPFcoeff, FFT_spec, SPECTRUM_RES);
+  arm_add_f32(FFT_spec_old, FFT_spec, FFT_spec_old, SPECTRUM_RES);
+}
+
+/*****
+  Purpose: Convert bin powers to pixels, offset + (int)(dBScale * log10(power)), limited to low..high
+
+  Parameter list:
+    const float32_t *power    bin powers
+    int16_t *pixels           one pixel value per bin
+    uint32_t count            bins
+    float32_t dBScale         pixels per decade of power
+    int16_t offset            pixel value for a power of 1
+    int16_t low               smallest pixel value
+    int16_t high              largest pixel value
+
+  Return value;
+    void
+*****/
+void SpectrumPixels(const float32_t *power, int16_t *pixels, uint32_t count, float32_t dBScale, int16_t offset, int16_t low, int16_t high) {
+  if (!spectrumTablesReady) {
+    SpectrumTablesInit();
+  }
+  const float32_t scale = dBScale * 0.3010299956639812;  // log10(x) = log2(x) * log10(2)
+  for (uint32_t i = 0; i < count; i++) {
+    union {
+      float32_t f;
+      uint32_t u;
+    } bits = { power[i] };
+    int32_t exponent = (int32_t)((bits.u >> 23) & 0xFF) - 127;
+    float32_t log2Power = (float32_t)exponent + spectrumLog2Mantissa[(bits.u >> (23 - SPECTRUM_LOG2_BITS)) & ((1 << SPECTRUM_LOG2_BITS) - 1)];
+    int32_t pixel = offset + (int32_t)(scale * log2Power);
+    if (pixel < low) {
+      pixel = low;
+    } else if (pixel > high) {
+      pixel = high;
+    }
+    pixels[i] = pixel;
+  }
+}
+
 /*****
   Purpose: Zoom FFT
   
   Parameter list:
-    void
+    const float32_t *IQ       wideband receive I/Q, interleaved [I, Q, I, Q . . .]
+    uint32_t blockSize        complex samples in IQ
   Return value;
     void
     Used when Spectrum Zoom>1
 *****/
-void ZoomFFTExe(uint32_t blockSize)  //AFP changed resolution 03-12-21  Only for spectrum Zoom > 1
+void ZoomFFTExe(const float32_t *IQ, uint32_t blockSize)  //AFP changed resolution 03-12-21  Only for spectrum Zoom > 1
 {
   if (updateDisplayFlag == 1) {  //Runs display FFT routine only once for each Audio process FFT.  Cuts number of FFTs by 1/512.
     float32_t x_buffer[blockSize];                      // can be 4096 [FFT length == 1024] or even 8192 [FFT length == 2048]
@@ -51,14 +168,16 @@ void ZoomFFTExe(uint32_t blockSize)  //AFP changed resolution 03-12-21  Only for
     int sample_no = SPECTRUM_RES;                       // sample_no is 256, in high magnify modes it is smaller!
     // but it must never be > SPECTRUM_RES
 
-    sample_no = BUFFER_SIZE * N_BLOCKS / (1 << spectrum_zoom);
+    sample_no = blockSize / (1 << spectrum_zoom);  // What the decimator leaves of this block, at any rxLatencyMode
     if (sample_no > SPECTRUM_RES) {
       sample_no = SPECTRUM_RES;
     }
 
     if (spectrum_zoom != SPECTRUM_ZOOM_1) {                                                     //For magnifications >1
-      arm_biquad_cascade_df1_f32 (&IIR_biquad_Zoom_FFT_I, float_buffer_L, x_buffer, blockSize);
-      arm_biquad_cascade_df1_f32 (&IIR_biquad_Zoom_FFT_Q, float_buffer_R, y_buffer, blockSize);
+      // The receive chain folds the Fs/4 shift into its NCO, so shift the copy displayed here
+      FreqShift1(IQ, x_buffer, y_buffer, blockSize);
+      arm_biquad_cascade_df1_f32 (&IIR_biquad_Zoom_FFT_I, x_buffer, x_buffer, blockSize);
+      arm_biquad_cascade_df1_f32 (&IIR_biquad_Zoom_FFT_Q, y_buffer, y_buffer, blockSize);
       // decimation
       arm_fir_decimate_f32(&Fir_Zoom_FFT_Decimate_I, x_buffer, x_buffer, blockSize);
       arm_fir_decimate_f32(&Fir_Zoom_FFT_Decimate_Q, y_buffer, y_buffer, blockSize);
@@ -78,14 +197,7 @@ void ZoomFFTExe(uint32_t blockSize)  //AFP changed resolution 03-12-21  Only for
     if (spectrum_zoom > SPECTRUM_ZOOM_8) { // && spectrum_zoom < SPECTRUM_ZOOM_1024) {
       multiplier = (float32_t)(1 << spectrum_zoom);
     }
-    for (int idx = 0; idx < SPECTRUM_RES; idx++) {
-      buffer_spec_FFT[idx * 2 + 0] =  multiplier * FFT_ring_buffer_x[zoom_sample_ptr] * (0.5 - 0.5 * cos(6.28 * idx / SPECTRUM_RES)); //Hanning Window AFP 03-12-21
-      buffer_spec_FFT[idx * 2 + 1] =  multiplier * FFT_ring_buffer_y[zoom_sample_ptr] * (0.5 - 0.5 * cos(6.28 * idx / SPECTRUM_RES));
-      zoom_sample_ptr++;
-      if (zoom_sample_ptr >= SPECTRUM_RES) {
-        zoom_sample_ptr = 0;
-      }
-    }
+    SpectrumWindow(FFT_ring_buffer_x, FFT_ring_buffer_y, 1, multiplier);  //Hanning Window AFP 03-12-21
     zoom_sample_ptr = 0;
     //***************
     // adjust lowpass filter coefficient, so that
@@ -93,92 +205,56 @@ void ZoomFFTExe(uint32_t blockSize)  //AFP changed resolution 03-12-21  Only for
     // and the same across different magnify modes . . .
     //float32_t LPFcoeff = LPF_spectrum * (AUDIO_SAMPLE_RATE_EXACT / SR[SampleRate].rate);
     float32_t LPFcoeff = 0.7;                                                           //AFP 03-12-21  reduced averaging time
-    if (LPFcoeff > 1.0) {
-      LPFcoeff = 1.0;
-    }
-    if (LPFcoeff < 0.001) {
-      LPFcoeff = 0.001;
-    }
-    float32_t onem_LPFcoeff = 1.0 - LPFcoeff;
     // save old pixels for lowpass filter This is also used to erase the old spectrum.  KF5N
     for (int i = 0; i < SPECTRUM_RES; i++) {
       //pixelold[i] = pixelnew[i];
       pixelold[i] = pixelCurrent[i];  // KF5N
     }
-    // perform complex FFT
-    // calculation is performed in-place the FFT_buffer [re, im, re, im, re, im . . .]
-    arm_cfft_f32(spec_FFT, buffer_spec_FFT, 0, 1);
-
-    for (int i = 0; i < SPECTRUM_RES / 2; i++) {
-      FFT_spec[i + SPECTRUM_RES / 2] = (buffer_spec_FFT[i * 2] * buffer_spec_FFT[i * 2] + buffer_spec_FFT[i * 2 + 1] * buffer_spec_FFT[i * 2 + 1]); // Last half of spectrum
-      FFT_spec[i] = (buffer_spec_FFT[(i + SPECTRUM_RES / 2) * 2] * buffer_spec_FFT[(i + SPECTRUM_RES / 2)  * 2] + buffer_spec_FFT[(i + SPECTRUM_RES / 2)  * 2 + 1] * buffer_spec_FFT[(i + SPECTRUM_RES / 2)  * 2 + 1]);
-    }
-    // apply low pass filter and scale the magnitude values and convert to int for spectrum display
-    // apply spectrum AGC
-    //
-    for (int16_t x = 0; x < SPECTRUM_RES; x++) {
-      FFT_spec[x] = LPFcoeff * FFT_spec[x] + onem_LPFcoeff * FFT_spec_old[x];
-      FFT_spec_old[x] = FFT_spec[x];
-    }
-
-    for (int16_t x = 0; x < SPECTRUM_RES; x++) {
-      pixelnew[x] = displayScale[currentScale].baseOffset + bands[currentBand].pixel_offset + (int16_t)(displayScale[currentScale].dBScale * log10f_fast(FFT_spec[x]));
-      if (pixelnew[x] > 220) {
-        pixelnew[x] = 220;
-      }
-    }
+    SpectrumPower(LPFcoeff);
+    // scale the magnitude values and convert to int for spectrum display
+    SpectrumPixels(FFT_spec_old, pixelnew, SPECTRUM_RES, displayScale[currentScale].dBScale,
+                   displayScale[currentScale].baseOffset + bands[currentBand].pixel_offset, INT16_MIN, 220);
+    spectrumFrameReady = 1;
   }
 }
 /*****
   Purpose: CalcZoom1Magn()
   Parameter list:
-    void
+    const float32_t *IQ       wideband receive I/Q, interleaved [I, Q, I, Q . . .]
+    uint32_t blockSize        complex samples in IQ
   Return value;
     void
     Used when Spectrum Zoom =1
 *****/
-void CalcZoom1Magn()
+void CalcZoom1Magn(const float32_t *IQ, uint32_t blockSize)
 {
  if (updateDisplayFlag == 1) {
-  float32_t spec_help = 0.0;
   float32_t LPFcoeff = 0.7;
-  if (LPFcoeff > 1.0) {
-    LPFcoeff = 1.0;
+  const float32_t *I = IQ;
+  const float32_t *Q = IQ + 1;
+  int stride = 2;
+  if (blockSize < SPECTRUM_RES) {  // Low latency blocks are shorter than the FFT: collect them as ZoomFFTExe() does
+    for (uint32_t i = 0; i < blockSize; i++) {
+      FFT_ring_buffer_x[zoom_sample_ptr] = IQ[2 * i];
+      FFT_ring_buffer_y[zoom_sample_ptr] = IQ[2 * i + 1];
+      zoom_sample_ptr++;
+    }
+    if (zoom_sample_ptr < SPECTRUM_RES) {
+      return;
+    }
+    zoom_sample_ptr = 0;
+    I = FFT_ring_buffer_x;
+    Q = FFT_ring_buffer_y;
+    stride = 1;
   }
   for (int i = 0; i < SPECTRUM_RES; i++) {
     pixelold[i] = pixelnew[i];
   }
 
-
-  for (int i = 0; i < SPECTRUM_RES; i++) { // interleave real and imaginary input values [real, imag, real, imag . . .]
-    buffer_spec_FFT[i * 2] =      float_buffer_L[i] * (0.5 - 0.5 * cos(6.28 * i / SPECTRUM_RES)); //Hanning
-    buffer_spec_FFT[i * 2 + 1] =  float_buffer_R[i] * (0.5 - 0.5 * cos(6.28 * i / SPECTRUM_RES));
-  }
-  // perform complex FFT
-  // calculation is performed in-place the FFT_buffer [re, im, re, im, re, im . . .]
-  arm_cfft_f32(spec_FFT, buffer_spec_FFT, 0, 1);
-
-  // calculate magnitudes and put into FFT_spec
-  // we do not need to calculate magnitudes with square roots, it would seem to be sufficient to
-  // calculate mag = I*I + Q*Q, because we are doing a log10-transformation later anyway
-  // and simultaneously put them into the right order
-  // 38.50%, saves 0.05% of processor power and 1kbyte RAM ;-)
-
-  for (int i = 0; i < SPECTRUM_RES/2; i++) {
-      FFT_spec[i + SPECTRUM_RES/2] = (buffer_spec_FFT[i * 2] * buffer_spec_FFT[i * 2] + buffer_spec_FFT[i * 2 + 1] * buffer_spec_FFT[i * 2 + 1]);
-      FFT_spec[i]                  = (buffer_spec_FFT[(i + SPECTRUM_RES/2) * 2] * buffer_spec_FFT[(i + SPECTRUM_RES/2)  * 2] + buffer_spec_FFT[(i + SPECTRUM_RES/2)  * 2 + 1] * buffer_spec_FFT[(i + SPECTRUM_RES/2)  * 2 + 1]);
-    }
-  // apply low pass filter and scale the magnitude values and convert to int for spectrum display
-
-  for (int16_t x = 0; x < SPECTRUM_RES; x++) {
-    spec_help = LPFcoeff * FFT_spec[x] + (1.0 - LPFcoeff) * FFT_spec_old[x];
-    FFT_spec_old[x] = spec_help;
-
-#ifdef USE_LOG10FAST
-    pixelnew[x] = displayScale[currentScale].baseOffset + bands[currentBand].pixel_offset + (int16_t) (displayScale[currentScale].dBScale * log10f_fast(FFT_spec[x]));
-#else
-    pixelnew[x] = displayScale[currentScale].baseOffset + bands[currentBand].pixel_offset + (int16_t) (displayScale[currentScale].dBScale * log10f(spec_help));
-#endif
-  }
+  SpectrumWindow(I, Q, stride, 1.0);  //Hanning
+  SpectrumPower(LPFcoeff);
+  SpectrumPixels(FFT_spec_old, pixelnew, SPECTRUM_RES, displayScale[currentScale].dBScale,
+                 displayScale[currentScale].baseOffset + bands[currentBand].pixel_offset, INT16_MIN, INT16_MAX);
+  spectrumFrameReady = 1;
  }
 } // end calc_256_magn
@@ -2,124 +2,34 @@
 #include "SDT.h"
 #endif
 
+#define RX_EQ_CARRIER_HZ 100.0  // AM and SAM: offsets below this are the carrier, not audio
 
 /*****
-  Purpose: void DoReceiveEQ  Parameter list:
-    void
-  Return value;
-    void
-*****/
-void DoReceiveEQ()  //AFP 08-09-22
-{
-  for (int i = 0; i < 14; i++) {
-    recEQ_LevelScale[i] = (float)EEPROMData.equalizerRec[i] / 100.0;
-  }
-  arm_biquad_cascade_df2T_f32(&S1_Rec, float_buffer_L, rec_EQ1_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S2_Rec, float_buffer_L, rec_EQ2_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S3_Rec, float_buffer_L, rec_EQ3_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S4_Rec, float_buffer_L, rec_EQ4_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S5_Rec, float_buffer_L, rec_EQ5_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S6_Rec, float_buffer_L, rec_EQ6_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S7_Rec, float_buffer_L, rec_EQ7_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S8_Rec, float_buffer_L, rec_EQ8_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S9_Rec, float_buffer_L, rec_EQ9_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S10_Rec, float_buffer_L, rec_EQ10_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S11_Rec, float_buffer_L, rec_EQ11_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S12_Rec, float_buffer_L, rec_EQ12_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S13_Rec, float_buffer_L, rec_EQ13_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S14_Rec, float_buffer_L, rec_EQ14_float_buffer_L, 256);
-
-  arm_scale_f32(rec_EQ1_float_buffer_L, -recEQ_LevelScale[0], rec_EQ1_float_buffer_L, 256);
-  arm_scale_f32(rec_EQ2_float_buffer_L, recEQ_LevelScale[1], rec_EQ2_float_buffer_L, 256);
-  arm_scale_f32(rec_EQ3_float_buffer_L, -recEQ_LevelScale[2], rec_EQ3_float_buffer_L, 256);
-  arm_scale_f32(rec_EQ4_float_buffer_L, recEQ_LevelScale[3], rec_EQ4_float_buffer_L, 256);
-  arm_scale_f32(rec_EQ5_float_buffer_L, -recEQ_LevelScale[4], rec_EQ5_float_buffer_L, 256);
-  arm_scale_f32(rec_EQ6_float_buffer_L, recEQ_LevelScale[5], rec_EQ6_float_buffer_L, 256);
-  arm_scale_f32(rec_EQ7_float_buffer_L, -recEQ_LevelScale[6], rec_EQ7_float_buffer_L, 256);
-  arm_scale_f32(rec_EQ8_float_buffer_L, recEQ_LevelScale[7], rec_EQ8_float_buffer_L, 256);
-  arm_scale_f32(rec_EQ9_float_buffer_L, -recEQ_LevelScale[8], rec_EQ9_float_buffer_L, 256);
-  arm_scale_f32(rec_EQ10_float_buffer_L, recEQ_LevelScale[9], rec_EQ10_float_buffer_L, 256);
-  arm_scale_f32(rec_EQ11_float_buffer_L, -recEQ_LevelScale[10], rec_EQ11_float_buffer_L, 256);
-  arm_scale_f32(rec_EQ12_float_buffer_L, recEQ_LevelScale[11], rec_EQ12_float_buffer_L, 256);
-  arm_scale_f32(rec_EQ13_float_buffer_L, -recEQ_LevelScale[12], rec_EQ13_float_buffer_L, 256);
-  arm_scale_f32(rec_EQ14_float_buffer_L, recEQ_LevelScale[13], rec_EQ14_float_buffer_L, 256);
-
-  arm_add_f32(rec_EQ1_float_buffer_L, rec_EQ2_float_buffer_L, float_buffer_L, 256);
-
-  arm_add_f32(float_buffer_L, rec_EQ3_float_buffer_L, float_buffer_L, 256);
-  arm_add_f32(float_buffer_L, rec_EQ4_float_buffer_L, float_buffer_L, 256);
-  arm_add_f32(float_buffer_L, rec_EQ5_float_buffer_L, float_buffer_L, 256);
-  arm_add_f32(float_buffer_L, rec_EQ6_float_buffer_L, float_buffer_L, 256);
-  arm_add_f32(float_buffer_L, rec_EQ7_float_buffer_L, float_buffer_L, 256);
-  arm_add_f32(float_buffer_L, rec_EQ8_float_buffer_L, float_buffer_L, 256);
-  arm_add_f32(float_buffer_L, rec_EQ9_float_buffer_L, float_buffer_L, 256);
-  arm_add_f32(float_buffer_L, rec_EQ10_float_buffer_L, float_buffer_L, 256);
-  arm_add_f32(float_buffer_L, rec_EQ11_float_buffer_L, float_buffer_L, 256);
-  arm_add_f32(float_buffer_L, rec_EQ12_float_buffer_L, float_buffer_L, 256);
-  arm_add_f32(float_buffer_L, rec_EQ13_float_buffer_L, float_buffer_L, 256);
-  arm_add_f32(float_buffer_L, rec_EQ14_float_buffer_L, float_buffer_L, 256);
-}
-
-/*****
-  Purpose: void DoExciterEQ
-
-  Parameter list:
-    void
-  Return value;
-    void
-*****/
-void DoExciterEQ()  //AFP 10-02-22
-{
-  #ifdef NOTDEF                 // this messes up the equalizer settings in EEPROM
-  for (int i = 0; i < 14; i++) {
-    xmtEQ_Level[i] = (float)EEPROMData.equalizerXmt[i] / 100.0;
-  }
-  #endif
-  arm_biquad_cascade_df2T_f32(&S1_Xmt, float_buffer_L_EX, xmt_EQ1_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S2_Xmt, float_buffer_L_EX, xmt_EQ2_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S3_Xmt, float_buffer_L_EX, xmt_EQ3_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S4_Xmt, float_buffer_L_EX, xmt_EQ4_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S5_Xmt, float_buffer_L_EX, xmt_EQ5_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S6_Xmt, float_buffer_L_EX, xmt_EQ6_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S7_Xmt, float_buffer_L_EX, xmt_EQ7_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S8_Xmt, float_buffer_L_EX, xmt_EQ8_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S9_Xmt, float_buffer_L_EX, xmt_EQ9_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S10_Xmt, float_buffer_L_EX, xmt_EQ10_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S11_Xmt, float_buffer_L_EX, xmt_EQ11_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S12_Xmt, float_buffer_L_EX, xmt_EQ12_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S13_Xmt, float_buffer_L_EX, xmt_EQ13_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S14_Xmt, float_buffer_L_EX, xmt_EQ14_float_buffer_L, 256);
-
-  arm_scale_f32(xmt_EQ1_float_buffer_L, -xmtEQ_Level[0], xmt_EQ1_float_buffer_L, 256);
-  arm_scale_f32(xmt_EQ2_float_buffer_L, xmtEQ_Level[1], xmt_EQ2_float_buffer_L, 256);
-  arm_scale_f32(xmt_EQ3_float_buffer_L, -xmtEQ_Level[2], xmt_EQ3_float_buffer_L, 256);
-  arm_scale_f32(xmt_EQ4_float_buffer_L, xmtEQ_Level[3], xmt_EQ4_float_buffer_L, 256);
-  arm_scale_f32(xmt_EQ5_float_buffer_L, -xmtEQ_Level[4], xmt_EQ5_float_buffer_L, 256);
-  arm_scale_f32(xmt_EQ6_float_buffer_L, xmtEQ_Level[5], xmt_EQ6_float_buffer_L, 256);
-  arm_scale_f32(xmt_EQ7_float_buffer_L, -xmtEQ_Level[6], xmt_EQ7_float_buffer_L, 256);
-  arm_scale_f32(xmt_EQ8_float_buffer_L, xmtEQ_Level[7], xmt_EQ8_float_buffer_L, 256);
-  arm_scale_f32(xmt_EQ9_float_buffer_L, -xmtEQ_Level[8], xmt_EQ9_float_buffer_L, 256);
-  arm_scale_f32(xmt_EQ10_float_buffer_L, xmtEQ_Level[9], xmt_EQ10_float_buffer_L, 256);
-  arm_scale_f32(xmt_EQ11_float_buffer_L, -xmtEQ_Level[10], xmt_EQ11_float_buffer_L, 256);
-  arm_scale_f32(xmt_EQ12_float_buffer_L, xmtEQ_Level[11], xmt_EQ12_float_buffer_L, 256);
-  arm_scale_f32(xmt_EQ13_float_buffer_L, -xmtEQ_Level[12], xmt_EQ13_float_buffer_L, 256);
-  arm_scale_f32(xmt_EQ14_float_buffer_L, xmtEQ_Level[13], xmt_EQ14_float_buffer_L, 256);
-
-  arm_add_f32(xmt_EQ1_float_buffer_L, xmt_EQ2_float_buffer_L, float_buffer_L_EX, 256);
-
-  arm_add_f32(float_buffer_L_EX, xmt_EQ3_float_buffer_L, float_buffer_L_EX, 256);
-  arm_add_f32(float_buffer_L_EX, xmt_EQ4_float_buffer_L, float_buffer_L_EX, 256);
-  arm_add_f32(float_buffer_L_EX, xmt_EQ5_float_buffer_L, float_buffer_L_EX, 256);
-  arm_add_f32(float_buffer_L_EX, xmt_EQ6_float_buffer_L, float_buffer_L_EX, 256);
-  arm_add_f32(float_buffer_L_EX, xmt_EQ7_float_buffer_L, float_buffer_L_EX, 256);
-  arm_add_f32(float_buffer_L_EX, xmt_EQ8_float_buffer_L, float_buffer_L_EX, 256);
-  arm_add_f32(float_buffer_L_EX, xmt_EQ9_float_buffer_L, float_buffer_L_EX, 256);
-  arm_add_f32(float_buffer_L_EX, xmt_EQ10_float_buffer_L, float_buffer_L_EX, 256);
-  arm_add_f32(float_buffer_L_EX, xmt_EQ11_float_buffer_L, float_buffer_L_EX, 256);
-  arm_add_f32(float_buffer_L_EX, xmt_EQ12_float_buffer_L, float_buffer_L_EX, 256);
-  arm_add_f32(float_buffer_L_EX, xmt_EQ13_float_buffer_L, float_buffer_L_EX, 256);
-  arm_add_f32(float_buffer_L_EX, xmt_EQ14_float_buffer_L, float_buffer_L_EX, 256);
-}
+  Filter mask cache.  Designing a receive filter takes a windowed sinc of m_NumTaps, an FFT of it and,
+  with the receive EQ on, two more FFTs and the EQ response at every bin.  The masks of the last few
+  passbands are kept, so going back to one is only a change of the FIR_filter_mask pointer.  A mask
+  depends on the passband, the sample rate, FFT_length, m_NumTaps and the EQ, which the mode can leave
+  out, so all of those are in the key; the least recently used entry is the one replaced.  The cache is
+  a pool of FILTER_MASK_CACHE_SIZE masks of FFT_LENGTH bins, which holds fewer of the larger masks.
+*****/
+struct filterMaskKey {
+  int32_t FLoCut;
+  int32_t FHiCut;
+  uint32_t rate;
+  uint32_t fftLength;
+  uint32_t taps;
+  int32_t mode;
+  uint32_t eq;  // Hash of the EQ levels, 0 with the EQ off
+};
+
+static struct filterMaskKey filterMaskKeys[FILTER_MASK_CACHE_SIZE];
+static uint32_t filterMaskLastUse[FILTER_MASK_CACHE_SIZE];  // 0 for an empty entry
+static uint32_t filterMaskClock = 0;
+static uint32_t filterMaskSize = FFT_LENGTH * 2;  // Floats per entry of the pool
+static const float32_t *filterMaskPinned = NULL;  // Entry the receive FFT last used, see FilterMaskPin()
+static float32_t DMAMEM filterMaskPool[FILTER_MASK_CACHE_SIZE * FFT_LENGTH * 2] __attribute__((aligned(4)));
+
+float32_t *FIR_filter_mask = filterMaskPool;
 
 /*****
   Purpose: void FilterBandwidth()  Parameter list:
@@ -128,9 +38,8 @@ void DoExciterEQ()  //AFP 10-02-22
     void
 *****/
 void FilterBandwidth() {
-  AudioNoInterrupts();
-
-  CalcCplxFIRCoeffs(FIR_Coef_I, FIR_Coef_Q, m_NumTaps, (float32_t)bands[currentBand].FLoCut, (float32_t)bands[currentBand].FHiCut, (float)SR[SampleRate].rate / DF);
+  // Only ProcessIQData() uses what is changed here, and it runs in loop() as this does, so the audio
+  // interrupts are left running and the input queues keep filling.
   InitFilterMask();
 
   // also adjust IIR AM filter
@@ -152,24 +61,50 @@ void FilterBandwidth() {
   } else {
   }
   //BandInformation();
-  MyDelay(1L);
-  AudioInterrupts();
 }  // end filter_bandwidth
 
 /*****
-  Purpose: InitFilterMask()
+  Purpose: Fill in the cache key of a receive filter
 
   Parameter list:
+    struct filterMaskKey *key   the key
+    int mode                    DEMOD_xxx
+    int FLoCut, FHiCut          passband edges in Hz
+
+  Return value;
     void
+*****/
+static void FilterMaskKey(struct filterMaskKey *key, int mode, int FLoCut, int FHiCut) {
+  key->FLoCut = FLoCut;
+  key->FHiCut = FHiCut;
+  key->rate = SR[SampleRate].rate;
+  key->fftLength = FFT_length;
+  key->taps = m_NumTaps;
+  key->mode = mode;
+  key->eq = 0;
+  if (receiveEQFlag == ON && mode != DEMOD_IQ) {
+    uint32_t h = 2166136261u;  // FNV-1a
+    for (int i = 0; i < EQUALIZER_CELL_COUNT; i++) {
+      h = (h ^ (uint32_t)EEPROMData.equalizerRec[i]) * 16777619u;
+    }
+    key->eq = h | 1;
+  }
+}
+
+/*****
+  Purpose: Calculate the FFT of the FIR filter coefficients to produce a filter mask
+
+  Parameter list:
+    float32_t *mask             FFT_length complex bins
+    int mode                    DEMOD_xxx
+    int FLoCut, FHiCut          passband edges in Hz
 
   Return value;
     void
 *****/
-void InitFilterMask() {
+static void BuildFilterMask(float32_t *mask, int mode, int FLoCut, int FHiCut) {
+  CalcCplxFIRCoeffs(FIR_Coef_I, FIR_Coef_Q, m_NumTaps, (float32_t)FLoCut, (float32_t)FHiCut, (float)SR[SampleRate].rate / DF);
 
-  /****************************************************************************************
-     Calculate the FFT of the FIR filter coefficients once to produce the FIR filter mask
-  ****************************************************************************************/
   // the FIR has exactly m_NumTaps and a maximum of (FFT_length / 2) + 1 taps = coefficients, so we have to add (FFT_length / 2) -1 zeros before the FFT
   // in order to produce a FFT_length point input buffer for the FFT
   // copy coefficients into real values of first part of buffer, rest is zero
@@ -177,20 +112,222 @@ void InitFilterMask() {
   for (unsigned i = 0; i < m_NumTaps; i++) {
     // try out a window function to eliminate ringing of the filter at the stop frequency
     //             sd.FFT_Samples[i] = (float32_t)((0.53836 - (0.46164 * arm_cos_f32(PI*2 * (float32_t)i / (float32_t)(FFT_IQ_BUFF_LEN-1)))) * sd.FFT_Samples[i]);
-    FIR_filter_mask[i * 2] = FIR_Coef_I[i];
-    FIR_filter_mask[i * 2 + 1] = FIR_Coef_Q[i];
+    mask[i * 2] = FIR_Coef_I[i];
+    mask[i * 2 + 1] = FIR_Coef_Q[i];
   }
 
-  for (unsigned i = FFT_length + 1; i < FFT_length * 2; i++) {
-    FIR_filter_mask[i] = 0.0;
+  for (unsigned i = m_NumTaps * 2; i < FFT_length * 2; i++) {
+    mask[i] = 0.0;
   }
 
-  // FFT of FIR_filter_mask
+  // FFT of the mask
   // perform FFT (in-place), needs only to be done once (or every time the filter coeffs change)
-  arm_cfft_f32(maskS, FIR_filter_mask, 0, 1);
+  arm_cfft_f32(maskS, mask, 0, 1);
+
+  if (receiveEQFlag == ON && mode != DEMOD_IQ) {
+    ApplyReceiveEQToMask(mask, mode);
+  }
+}
+
+/*****
+  Purpose: Find the mask of a receive filter in the cache, designing it into the least recently used
+           entry if it is not there
+
+  Parameter list:
+    int mode                    DEMOD_xxx
+    int FLoCut, FHiCut          passband edges in Hz
+
+  Return value;
+    float32_t *                 the mask, FFT_length complex bins
+*****/
+static float32_t *FilterMaskLookup(int mode, int FLoCut, int FHiCut) {
+  struct filterMaskKey key;
+  int slot = -1;
+  uint32_t size = 2 * (FFT_length > FFT_LENGTH ? FFT_length : FFT_LENGTH);
 
+  if (size != filterMaskSize) {  // The pool is cut up differently, so every entry is lost
+    memset(filterMaskLastUse, 0, sizeof(filterMaskLastUse));
+    filterMaskSize = size;
+    filterMaskPinned = NULL;
+  }
+  const int entries = FILTER_MASK_CACHE_SIZE * FFT_LENGTH * 2 / filterMaskSize;
+
+  FilterMaskKey(&key, mode, FLoCut, FHiCut);
+  filterMaskClock++;
+  for (int i = 0; i < entries; i++) {
+    if (filterMaskLastUse[i] != 0 && memcmp(&filterMaskKeys[i], &key, sizeof(key)) == 0) {
+      filterMaskLastUse[i] = filterMaskClock;
+      return &filterMaskPool[i * filterMaskSize];
+    }
+    if (&filterMaskPool[i * filterMaskSize] == filterMaskPinned) {
+      continue;
+    }
+    if (slot < 0 || filterMaskLastUse[i] < filterMaskLastUse[slot]) {
+      slot = i;
+    }
+  }
+
+  // The pool always has two entries or more, so there is one that is not pinned
+  BuildFilterMask(&filterMaskPool[slot * filterMaskSize], mode, FLoCut, FHiCut);
+  filterMaskKeys[slot] = key;
+  filterMaskLastUse[slot] = filterMaskClock;
+  return &filterMaskPool[slot * filterMaskSize];
+}
+
+/*****
+  Purpose: Keep a mask in the cache while the receive FFT still needs it.  A new filter is faded in
+           with the mask of the frame before, see ProcessIQData(), and several filter changes can come
+           between two frames.  Only one mask is pinned at a time.
+
+  Parameter list:
+    const float32_t *mask       a mask from the cache, or NULL
+
+  Return value;
+    void
+*****/
+void FilterMaskPin(const float32_t *mask) {
+  filterMaskPinned = mask;
+}
+
+/*****
+  Purpose: InitFilterMask()  Point FIR_filter_mask at the mask for the current band's filter, mode and EQ
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+void InitFilterMask() {
+  FIR_filter_mask = FilterMaskLookup(bands[currentBand].mode, bands[currentBand].FLoCut, bands[currentBand].FHiCut);
 }  // end init_filter_mask
 
+/*****
+  Purpose: Design the filter masks for each band's filter and mode, so the first visit to a band, or a
+           return to its usual filter, finds them in the cache.  Call once the bands and the EQ have
+           been read from EEPROM.
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+void PrewarmFilterMasks() {
+  for (int i = 0; i < NUMBER_OF_BANDS && i < FILTER_MASK_CACHE_SIZE; i++) {
+    FilterMaskLookup(bands[i].mode, bands[i].FLoCut, bands[i].FHiCut);
+  }
+}
+
+/*****
+  Purpose: Magnitude of the 14 band equalizer at one audio frequency.  The bands are the EQ_BandNCoeffs
+           4 stage biquads, summed with alternating signs as the old time domain equalizers did.
+
+  Parameter list:
+    const float32_t *bandLevels   14 linear band gains
+    float32_t freq                audio frequency in Hz
+    float32_t sampleRate          audio sample rate in Hz
+
+  Return value;
+    float32_t               linear gain
+*****/
+float32_t EqualizerGain(const float32_t *bandLevels, float32_t freq, float32_t sampleRate) {
+  static float32_t *bandCoeffs[EQUALIZER_CELL_COUNT] = { EQ_Band1Coeffs, EQ_Band2Coeffs, EQ_Band3Coeffs, EQ_Band4Coeffs, EQ_Band5Coeffs,
+                                       EQ_Band6Coeffs, EQ_Band7Coeffs, EQ_Band8Coeffs, EQ_Band9Coeffs, EQ_Band10Coeffs,
+                                       EQ_Band11Coeffs, EQ_Band12Coeffs, EQ_Band13Coeffs, EQ_Band14Coeffs };
+  float32_t w = TWO_PI * freq / sampleRate;
+  float32_t c1 = cosf(w), s1 = -sinf(w);  // z^-1
+  float32_t c2 = cosf(2.0 * w), s2 = -sinf(2.0 * w);  // z^-2
+  float32_t sumRe = 0.0, sumIm = 0.0;
+
+  for (int i = 0; i < EQUALIZER_CELL_COUNT; i++) {
+    float32_t hRe = (i & 1) ? 1.0 : -1.0;  // Even bands are subtracted
+    float32_t hIm = 0.0;
+    hRe *= bandLevels[i];
+    for (int stage = 0; stage < IIR_NUMSTAGES; stage++) {
+      // CMSIS df2T layout {b0, b1, b2, a1, a2}: H = (b0 + b1 z^-1 + b2 z^-2) / (1 - a1 z^-1 - a2 z^-2)
+      const float32_t *k = bandCoeffs[i] + 5 * stage;
+      float32_t numRe = k[0] + k[1] * c1 + k[2] * c2;
+      float32_t numIm = k[1] * s1 + k[2] * s2;
+      float32_t denRe = 1.0 - k[3] * c1 - k[4] * c2;
+      float32_t denIm = -k[3] * s1 - k[4] * s2;
+      float32_t denMag = denRe * denRe + denIm * denIm;
+      float32_t stRe = (numRe * denRe + numIm * denIm) / denMag;
+      float32_t stIm = (numIm * denRe - numRe * denIm) / denMag;
+      float32_t re = hRe * stRe - hIm * stIm;
+      hIm = hRe * stIm + hIm * stRe;
+      hRe = re;
+    }
+    sumRe += hRe;
+    sumIm += hIm;
+  }
+  return sqrtf(sumRe * sumRe + sumIm * sumIm);
+}
+
+/*****
+  Purpose: Cut a filter mask that an equalizer has been multiplied into back to the length the
+           overlap-save convolution can run without wrapping.  The impulse response is tapered with a
+           Hann window over its taps rather than cut off, so the EQ response does not leak into the
+           opposite sideband.  The receive and transmit EQ both use it.
+
+  Parameter list:
+    const arm_cfft_instance_f32 *S   complex FFT of fftLength points
+    float32_t *mask                  fftLength complex bins, changed in place
+    uint32_t fftLength
+    uint32_t taps                    filter length, centred on (taps - 1) / 2
+
+  Return value;
+    void
+*****/
+void TaperFilterMask(const arm_cfft_instance_f32 *S, float32_t *mask, uint32_t fftLength, uint32_t taps) {
+  arm_cfft_f32(S, mask, 1, 1);
+  for (uint32_t i = 0; i < taps; i++) {
+    float32_t w = 0.5 - 0.5 * cosf(TWO_PI * i / (taps - 1));
+    mask[i * 2] *= w;
+    mask[i * 2 + 1] *= w;
+  }
+  for (uint32_t i = taps * 2; i < fftLength * 2; i++) {
+    mask[i] = 0.0;
+  }
+  arm_cfft_f32(S, mask, 0, 1);
+}
+
+/*****
+  Purpose: Fold the receive equalizer into a filter mask, so it costs nothing per audio block.
+
+           Each mask bin is an offset from the carrier, which demodulates to an audio frequency of the
+           same size on either side, so the bin is scaled by the EQ magnitude at |offset|.  The gain is
+           real, which keeps the filter linear phase.  TaperFilterMask() then brings the product back to
+           m_NumTaps with a Hann window, as the transmit EQ does, so the overlap-save convolution does
+           not wrap; the low bands are smoothed to the resolution of that length.  For AM and SAM the
+           carrier passes at unity gain.
+
+  Parameter list:
+    float32_t *mask         FFT_length complex bins, changed in place
+    int mode                DEMOD_xxx
+
+  Return value;
+    void
+*****/
+void ApplyReceiveEQToMask(float32_t *mask, int mode) {
+  float32_t sampleRate = (float32_t)SR[SampleRate].rate / DF;
+  int keepCarrier = (mode == DEMOD_AM || mode == DEMOD_SAM);
+  float32_t bandLevels[EQUALIZER_CELL_COUNT];
+
+  for (int i = 0; i < EQUALIZER_CELL_COUNT; i++) {
+    bandLevels[i] = (float32_t)EEPROMData.equalizerRec[i] / 100.0;
+  }
+
+  for (unsigned i = 0; i < FFT_length; i++) {
+    float32_t freq = fabsf((float32_t)(i < FFT_length / 2 ? (int)i : (int)i - (int)FFT_length) * sampleRate / FFT_length);
+    float32_t gain = (keepCarrier && freq < RX_EQ_CARRIER_HZ) ? 1.0 : EqualizerGain(bandLevels, freq, sampleRate);
+    mask[i * 2] *= gain;
+    mask[i * 2 + 1] *= gain;
+  }
+
+  TaperFilterMask(maskS, mask, FFT_length, m_NumTaps);
+}
+
 /*****
   Purpose: void control_filter_f()
   Parameter list:
@@ -222,6 +359,98 @@ void ControlFilterF() {
       break;
   }  //== AFP 10-27-22
 }
+/*****
+  Interpolator coefficients last played, while RxInterpolate() fades from them to new ones
+*****/
+static float32_t FIR_int1_coeffs_old[48];
+static float32_t FIR_int2_coeffs_old[32];
+static float32_t DMAMEM rxInterpolateFade[2048];  // BUFFER_SIZE * N_B, the longest receive block
+static float32_t DMAMEM rxInterpolateScratch[512];  // BUFFER_SIZE * N_B / DF1, the first stage output
+static int rxInterpolateFadePending = 0;
+
+/*****
+  Purpose: One channel of RxInterpolate(), through both interpolators
+
+  Parameter list:
+    arm_fir_interpolate_instance_f32 *int1, *int2   the two stages
+    const float32_t *in                             audio at the decimated rate
+    float32_t *scratch                              output of the first stage
+    float32_t *out                                  audio at the ADC rate
+
+  Return value;
+    void
+*****/
+static void RxInterpolateChannel(arm_fir_interpolate_instance_f32 *int1, arm_fir_interpolate_instance_f32 *int2, const float32_t *in, float32_t *scratch, float32_t *out) {
+  arm_fir_interpolate_f32(int1, in, scratch, BUFFER_SIZE * N_BLOCKS / (uint32_t)(DF));  // Interpolatikon
+  // interpolation-by-4
+  arm_fir_interpolate_f32(int2, scratch, out, BUFFER_SIZE * N_BLOCKS / (uint32_t)(DF1));
+}
+
+/*****
+  Purpose: One channel of RxInterpolate() in the block after SetDecIntFilters() has changed the
+           coefficients.  The block is also run through the old coefficients from the same filter state,
+           and the output fades from that to the new one.
+
+  Parameter list:
+    arm_fir_interpolate_instance_f32 *int1, *int2   the two stages
+    float32_t *audio                                audio at the decimated rate in, at the ADC rate out
+    float32_t *scratch                              output of the first stage
+
+  Return value;
+    void
+*****/
+static void RxInterpolateFade(arm_fir_interpolate_instance_f32 *int1, arm_fir_interpolate_instance_f32 *int2, float32_t *audio, float32_t *scratch) {
+  const uint32_t count = BUFFER_SIZE * N_BLOCKS;
+  float32_t history1[24], history2[8];  // phaseLength - 1 samples of each stage
+  const float32_t *coeffs1 = int1->pCoeffs;
+  const float32_t *coeffs2 = int2->pCoeffs;
+
+  arm_copy_f32(int1->pState, history1, int1->phaseLength - 1);
+  arm_copy_f32(int2->pState, history2, int2->phaseLength - 1);
+  int1->pCoeffs = FIR_int1_coeffs_old;
+  int2->pCoeffs = FIR_int2_coeffs_old;
+  RxInterpolateChannel(int1, int2, audio, scratch, rxInterpolateFade);
+
+  arm_copy_f32(history1, int1->pState, int1->phaseLength - 1);
+  arm_copy_f32(history2, int2->pState, int2->phaseLength - 1);
+  int1->pCoeffs = coeffs1;
+  int2->pCoeffs = coeffs2;
+  RxInterpolateChannel(int1, int2, audio, scratch, audio);
+
+  for (uint32_t i = 0; i < count; i++) {
+    float32_t g = 0.5 - 0.5 * arm_cos_f32(PI * ((float32_t)i + 0.5) / (float32_t)count);
+    audio[i] = rxInterpolateFade[i] + g * (audio[i] - rxInterpolateFade[i]);
+  }
+}
+
+/*****
+  Purpose: Interpolate the receive audio from the decimated rate back to the ADC rate, in place
+
+  Parameter list:
+    float32_t *audioL       left or only channel
+    float32_t *audioR       right channel, only used if stereo
+    int stereo              1 for DEMOD_IQ, which keeps I and Q as two channels
+
+  Return value;
+    void
+*****/
+void RxInterpolate(float32_t *audioL, float32_t *audioR, int stereo) {
+  if (rxInterpolateFadePending) {
+    RxInterpolateFade(&FIR_int1_I, &FIR_int2_I, audioL, rxInterpolateScratch);
+    if (stereo) {
+      RxInterpolateFade(&FIR_int1_Q, &FIR_int2_Q, audioR, rxInterpolateScratch);
+    }
+    rxInterpolateFadePending = 0;
+    return;
+  }
+  // The receive convolution can keep samples in FFT_buffer and iFFT_buffer from one block to the next,
+  // so the scratch buffer is a separate one
+  RxInterpolateChannel(&FIR_int1_I, &FIR_int2_I, audioL, rxInterpolateScratch, audioL);
+  if (stereo) {
+    RxInterpolateChannel(&FIR_int1_Q, &FIR_int2_Q, audioR, rxInterpolateScratch, audioR);
+  }
+}
+
 /*****
   Purpose: void SetDecIntFilters()
   Parameter list:
@@ -243,13 +472,202 @@ void SetDecIntFilters() {
   if (LP_F_help > 10000) {
     LP_F_help = 10000;
   }
-  CalcFIRCoeffs(FIR_dec1_coeffs, n_dec1_taps, (float32_t)(LP_F_help), n_att, 0, 0.0, (float32_t)(SR[SampleRate].rate));
-  CalcFIRCoeffs(FIR_dec2_coeffs, n_dec2_taps, (float32_t)(LP_F_help), n_att, 0, 0.0, (float32_t)(SR[SampleRate].rate / DF1));
-  CalcFIRCoeffs(FIR_dec3_coeffs, n_dec3_taps, (float32_t)(LP_F_help), n_att, 0, 0.0, (float32_t)(SR[SampleRate].rate / (DF1*2)));
-
-  CalcFIRCoeffs(FIR_int1_coeffs, 48, (float32_t)(LP_F_help), n_att, 0, 0.0, (float32_t)(SR[SampleRate].rate / DF1));
-  CalcFIRCoeffs(FIR_int2_coeffs, 32, (float32_t)(LP_F_help), n_att, 0, 0.0, (float32_t)SR[SampleRate].rate);
-  CalcFIRCoeffs(FIR_int3_coeffs, 24, (float32_t)(LP_F_help), n_att, 0, 0.0, (float32_t)SR[SampleRate].rate/(DF1*2));
+  // The receive decimation filters are fixed half-bands wide enough for any filter, see InitRxDecimator()
+  // The interpolators only follow the widest edge, which most filter changes leave alone.  Their state
+  // is kept, and RxInterpolate() fades from the coefficients last played to the new ones.
+  static int lastLP_F = -1;
+  static uint32_t lastRate = 0;
+  if (LP_F_help != lastLP_F || SR[SampleRate].rate != lastRate) {
+    if (lastRate != 0 && !rxInterpolateFadePending) {
+      arm_copy_f32(FIR_int1_coeffs, FIR_int1_coeffs_old, 48);
+      arm_copy_f32(FIR_int2_coeffs, FIR_int2_coeffs_old, 32);
+      rxInterpolateFadePending = 1;
+    }
+    CalcFIRCoeffs(FIR_int1_coeffs, 48, (float32_t)(LP_F_help), n_att, 0, 0.0, (float32_t)(SR[SampleRate].rate / DF1));
+    CalcFIRCoeffs(FIR_int2_coeffs, 32, (float32_t)(LP_F_help), n_att, 0, 0.0, (float32_t)SR[SampleRate].rate);
+    CalcFIRCoeffs(FIR_int3_coeffs, 24, (float32_t)(LP_F_help), n_att, 0, 0.0, (float32_t)SR[SampleRate].rate/(DF1*2));
+    lastLP_F = LP_F_help;
+    lastRate = SR[SampleRate].rate;
+  }
 
   bin_BW = 1.0 / (DF * FFT_length) * (float32_t)SR[SampleRate].rate;
 }
+
+/*****
+  Purpose: Point S, iS and maskS at the CMSIS FFT tables for the current FFT_length
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+void SetRxFFTInstances() {
+  switch (FFT_length) {
+    case 2048:
+      S = &arm_cfft_sR_f32_len2048;
+      break;
+    case 1024:
+      S = &arm_cfft_sR_f32_len1024;
+      break;
+    case 512:
+      S = &arm_cfft_sR_f32_len512;
+      break;
+    case 256:
+      S = &arm_cfft_sR_f32_len256;
+      break;
+    case 128:
+      S = &arm_cfft_sR_f32_len128;
+      break;
+    case 64:
+      S = &arm_cfft_sR_f32_len64;
+      break;
+  }
+  iS = S;
+  maskS = S;
+}
+
+/*****
+  Receive convolution size asked for, see SetRxConvolution().  0 follows the block size.
+*****/
+static uint32_t rxConvLengthWanted = 0;
+static uint32_t rxConvTapsWanted = 0;
+
+/*****
+  Purpose: Size the receive convolution for the current block, from what SetRxConvolution() was asked
+           for, and rebuild what depends on it
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+static void ApplyRxConvolution() {
+  const uint32_t block = BUF_N_DF;
+  uint32_t length = 64;
+  while (length * 2 <= rxConvLengthWanted && length * 2 <= RX_CONV_MAX_LENGTH) {
+    length *= 2;
+  }
+  if (length < 2 * block) {  // Also what a request of 0 gets: half old samples, half new ones
+    length = 2 * block;
+  }
+  uint32_t maxTaps = length - block + 1;  // At least one block of new samples per FFT
+  if (maxTaps > RX_CONV_MAX_TAPS) {
+    maxTaps = RX_CONV_MAX_TAPS;
+  }
+  uint32_t taps = rxConvTapsWanted;
+  if (taps == 0 || taps > maxTaps) {
+    taps = maxTaps;
+  }
+  if (taps < 3) {
+    taps = 3;
+  }
+
+  FFT_length = length;
+  m_NumTaps = taps;
+  rxConvHop = (length - taps + 1) / block * block;
+  ANR_buff_size = block;
+  SetRxFFTInstances();
+
+  first_block = 1;  // The overlap history belongs to the old FFT size
+  FFTNoiseReductionReset();
+  FFTAutoNotchReset();
+  FilterBandwidth();  // The mask at the new length; also sets bin_BW
+}
+
+/*****
+  Purpose: Choose the FFT size and the filter length of the receive overlap-save convolution.  Each FFT
+           takes rxConvHop new samples and keeps FFT_length - rxConvHop old ones, at least the
+           m_NumTaps - 1 the filter reaches back.  Half old and half new suits a filter as long as the
+           block.  A longer FFT with a larger share of new samples makes a longer filter, with steeper
+           skirts, for fewer operations per sample (RxConvolutionMACs()).  In return ProcessIQData()
+           collects rxConvHop / BUF_N_DF blocks before each FFT, and that wait is added to the delay.
+
+  Parameter list:
+    uint32_t fftLength      64 to RX_CONV_MAX_LENGTH, rounded down to a power of 2 and at least twice the
+                            block; 0 for twice the block
+    uint32_t taps           filter length, up to fftLength - BUF_N_DF + 1 and RX_CONV_MAX_TAPS; 0 for
+                            the most the FFT allows
+
+  Return value;
+    void
+*****/
+void SetRxConvolution(uint32_t fftLength, uint32_t taps) {
+  rxConvLengthWanted = fftLength;
+  rxConvTapsWanted = taps;
+  ApplyRxConvolution();
+}
+
+/*****
+  Purpose: Select one of the receive convolution sizes of SetRxConvolution().  The new sample shares are
+           for the normal block of 256 samples at 24K SPS.
+
+             RX_CONV_STANDARD    twice the block, block + 1 taps: 512 points, 257 taps, 50% new
+             RX_CONV_EFFICIENT   1024 points, 257 taps, 75% new: the same filter for less work
+             RX_CONV_SHARP       2048 points, 513 taps, 75% new: skirts half as wide
+
+  Parameter list:
+    int mode            one of the above
+
+  Return value;
+    void
+*****/
+void SetRxConvMode(int mode) {
+  static const uint32_t length[] = { 0, 1024, 2048 };
+  static const uint32_t taps[] = { 0, 257, 513 };
+
+  if (mode < RX_CONV_STANDARD || mode > RX_CONV_SHARP) {
+    mode = RX_CONV_STANDARD;
+  }
+  rxConvMode = mode;
+  SetRxConvolution(length[mode], taps[mode]);
+}
+
+/*****
+  Purpose: Real multiplies per output sample of the receive convolution: a forward and an inverse FFT and
+           the mask, every rxConvHop samples.  The FFTs are counted as radix 2, N / 2 * log2(N)
+           butterflies of 4 multiplies; the CMSIS radix 4 and 8 stages do a little better.  A direct
+           form FIR of complex taps on complex samples would take 4 * m_NumTaps.
+
+  Parameter list:
+    void
+
+  Return value;
+    float32_t               multiplies per complex sample at the decimated rate
+*****/
+float32_t RxConvolutionMACs() {
+  float32_t n = (float32_t)FFT_length;
+  return (2.0 * 2.0 * n * log2f(n) + 4.0 * n) / (float32_t)rxConvHop;
+}
+
+/*****
+  Purpose: Select the receive block size.  ProcessIQData() then runs on fewer ADC samples per call, and
+           the standard overlap-save convolution shrinks with the block, so the receive filter has fewer
+           taps.  A smaller block waits less time to fill and the shorter filter delays the audio less;
+           in return the filter skirts are wider and the fixed cost of each call is paid more often.
+
+             RX_LATENCY_NORMAL   BUFFER_SIZE * N_B = 2048 samples, 512 point FFT, 257 taps
+             RX_LATENCY_LOW      512 samples, 128 point FFT, 65 taps
+             RX_LATENCY_LOWEST   256 samples, 64 point FFT, 33 taps
+
+           A larger convolution chosen with SetRxConvMode() keeps its size, and collects more of the
+           shorter blocks for each FFT.
+
+  Parameter list:
+    int mode            one of the above
+
+  Return value;
+    void
+*****/
+void SetRxLatencyMode(int mode) {
+  static const uint32_t shift[] = { 0, 2, 3 };  // N_BLOCKS = N_B >> shift
+
+  if (mode < RX_LATENCY_NORMAL || mode > RX_LATENCY_LOWEST) {
+    mode = RX_LATENCY_NORMAL;
+  }
+  rxLatencyMode = mode;
+  N_BLOCKS = N_B >> shift[mode];
+  BUF_N_DF = BUFFER_SIZE * N_BLOCKS / (uint32_t)DF;
+  ApplyRxConvolution();
+}
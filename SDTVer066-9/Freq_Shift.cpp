@@ -6,51 +6,46 @@
   Purpose: void FreqShift1()
           AFP 12-31-20
         Frequency translation by Fs/4 without multiplication from Lyons (2011): chapter 13.1.2 page 646
-        together with the savings of not having to shift/rotate the FFT_buffer, this saves
-        about 1% of processor use
 
         This is for +Fs/4 [moves receive frequency to the left in the spectrum display]
-           float_buffer_L contains I = real values
-           float_buffer_R contains Q = imaginary values
+           IQ_in contains interleaved I = real values, Q = imaginary values
            xnew(0) =  xreal(0) + jximag(0)
                leave first value (DC component) as it is!
            xnew(1) =  - ximag(1) + jxreal(1)
+
+        The receive chain does this rotation inside FreqShift2(); this version is only used to feed the
+        Zoom FFT, which displays the shifted spectrum.  Writes to separate I and Q output buffers for the
+        Zoom FFT filters, so no copy is needed to keep the unshifted data.
   Parameter list:
-    void
+    const float32_t *IQ_in            input samples, interleaved I, Q
+    float32_t *I_out, *Q_out          shifted samples
+    uint32_t blocksize                number of samples, a multiple of 4
 
   Return value:
     void
 *****/
-void FreqShift1()
+void FreqShift1(const float32_t *IQ_in, float32_t *I_out, float32_t *Q_out, uint32_t blocksize)
 {
-  for (unsigned i = 0; i < BUFFER_SIZE * N_BLOCKS; i += 4) {
-    hh1 = - float_buffer_R[i + 1];  // xnew(1) =  - ximag(1) + jxreal(1)
-    hh2 =   float_buffer_L[i + 1];
-    float_buffer_L[i + 1] = hh1;
-    float_buffer_R[i + 1] = hh2;
-    hh1 = - float_buffer_L[i + 2];
-    hh2 = - float_buffer_R[i + 2];
-    float_buffer_L[i + 2] = hh1;
-    float_buffer_R[i + 2] = hh2;
-    hh1 =   float_buffer_R[i + 3];
-    hh2 = - float_buffer_L[i + 3];
-    float_buffer_L[i + 3] = hh1;
-    float_buffer_R[i + 3] = hh2;
-  }
-  for (unsigned i = 0; i < BUFFER_SIZE * N_BLOCKS; i ++) {
-
-    float_buffer_L_3[i] = float_buffer_L[i];
-    float_buffer_R_3[i] = float_buffer_R[i];
- 
+  for (unsigned i = 0; i < blocksize; i += 4) {
+    const float32_t *x = &IQ_in[2 * i];
+    I_out[i] = x[0];
+    Q_out[i] = x[1];
+    I_out[i + 1] = - x[3];  // xnew(1) =  - ximag(1) + jxreal(1)
+    Q_out[i + 1] =   x[2];
+    I_out[i + 2] = - x[4];
+    Q_out[i + 2] = - x[5];
+    I_out[i + 3] =   x[7];
+    Q_out[i + 3] = - x[6];
   }
   // this is for -Fs/4 [moves receive frequency to the right in the spectrumdisplay]
 }
 
 /*****
-  Purpose: Shift Receive frequency by an arbitray amount
+  Purpose: Shift Receive frequency by +Fs/4 and then by an arbitray amount, in one complex multiply per sample
 
   Parameter list:
-    void
+    float32_t *IQ_buffer              samples at the ADC rate, interleaved I, Q, shifted in place
+    uint32_t blocksize                number of samples
 
   Return value;
     void
@@ -62,20 +57,20 @@ void FreqShift1()
 
     FREQUENCY CONVERSION USING A SOFTWARE QUADRATURE OSCILLATOR (NCO)
 
-    THIS VERSION calculates the COS AND SIN WAVE on the fly AND IS SLOW
-
-    MAJOR ADVANTAGE: frequency conversion can be done for any frequency !
+    The Fs/4 translation (formerly FreqShift1()) and the fine tune shift are both rotations, so they are
+    combined into one oscillator at Fs/4 - (NCOFreq + sideToneShift).  Its phase is a 32 bit accumulator
+    (ncoPhase, 2^32 = one cycle), so it is continuous across blocks and frequency changes.  Every
+    NCO_SEGMENT samples the oscillator is set exactly from the accumulator with sincosf(); in between it
+    is advanced by a float complex rotation, which keeps the rounding drift far below the ADC noise floor.
 
     large parts of the code taken from the mcHF code by Clint, KA7OEI, thank you!
       see here for more info on quadrature oscillators:
     Wheatley, M. (2011): CuteSDR Technical Manual Ver. 1.01. - http://sourceforge.net/projects/cutesdr/
     Lyons, R.G. (2011): Understanding Digital Processing. – Pearson, 3rd edition.
-    Requires 4 complex multiplies and two adds per data point within the time domain buffer.  Applied after the data
-    stream is sent to the Zoom FFT , but befor decimation.
+    Applied after the data stream is sent to the Zoom FFT, but before decimation.
 *****/
-void FreqShift2()
+void FreqShift2(float32_t *IQ_buffer, uint32_t blocksize)
 {
-  uint i;
   //long currentFreqAOld;  Not used.  KF5N July 22, 2023
   int sideToneShift = 0;
 
@@ -118,25 +113,46 @@ void FreqShift2()
   }
   NCO_INC = 2.0 * PI * (NCOFreq + sideToneShift) / 192000.0; //192000 SPS is the actual sample rate used in the Receive ADC
 
-  OSC_COS = cos (NCO_INC);
-  OSC_SIN = sin (NCO_INC);
+  NCOMix(IQ_buffer, blocksize, 48000.0 - (double)(NCOFreq + sideToneShift));
+}
 
-  for (i = 0; i < BUFFER_SIZE * N_BLOCKS; i++) {
-    // generate local oscillator on-the-fly:  This takes a lot of processor time!
-    Osc_Q = (Osc_Vect_Q * OSC_COS) - (Osc_Vect_I * OSC_SIN);  // Q channel of oscillator
-    Osc_I = (Osc_Vect_I * OSC_COS) + (Osc_Vect_Q * OSC_SIN);  // I channel of oscillator
-    Osc_Gain = 1.95 - ((Osc_Vect_Q * Osc_Vect_Q) + (Osc_Vect_I * Osc_Vect_I));  // Amplitude control of oscillator
+/*****
+  Purpose: Multiply I/Q data by the receive NCO, continuing its phase from the last call
 
-    // rotate vectors while maintaining constant oscillator amplitude
-    Osc_Vect_Q = Osc_Gain * Osc_Q;
-    Osc_Vect_I = Osc_Gain * Osc_I;
-    //
-    // do actual frequency conversion
-    float freqAdjFactor = 1.1;
+  Parameter list:
+    float32_t *IQ_buffer              samples, interleaved I, Q, shifted in place
+    uint32_t blocksize                number of samples
+    double freqHz                     oscillator frequency; positive moves the spectrum up
 
-    float_buffer_L[i] = (float_buffer_L_3[i] * freqAdjFactor * Osc_Q) + (float_buffer_R_3[i] * freqAdjFactor * Osc_I); // multiply I/Q data by sine/cosine data to do translation
-    float_buffer_R[i] = (float_buffer_R_3[i] * freqAdjFactor * Osc_Q) - (float_buffer_L_3[i] * freqAdjFactor * Osc_I);
- 
+  Return value;
+    void
+*****/
+void NCOMix(float32_t *IQ_buffer, uint32_t blocksize, double freqHz)
+{
+  // The former recursive oscillator settled at an amplitude of sqrt(0.95) and was followed by a
+  // freqAdjFactor of 1.1; keep the same overall gain so downstream levels do not change.
+  const float32_t gain = 1.1 * sqrt(0.95);
+  const uint32_t phaseInc = (uint32_t)(int64_t)llround(freqHz * 4294967296.0 / 192000.0);  //192000 SPS is the actual sample rate used in the Receive ADC
+  const float32_t angleInc = (float32_t)(int32_t)phaseInc * (2.0 * PI / 4294967296.0);
+  const float32_t rotCos = cosf(angleInc);
+  const float32_t rotSin = sinf(angleInc);
+
+  for (uint32_t start = 0; start < blocksize; start += NCO_SEGMENT) {
+    uint32_t end = start + NCO_SEGMENT < blocksize ? start + NCO_SEGMENT : blocksize;
+    float32_t oscCos, oscSin;
+    sincosf((float32_t)(int32_t)ncoPhase * (2.0 * PI / 4294967296.0), &oscSin, &oscCos);
+    oscCos *= gain;
+    oscSin *= gain;
+    for (uint32_t i = start; i < end; i++) {
+      float32_t re = IQ_buffer[2 * i];
+      float32_t im = IQ_buffer[2 * i + 1];
+      IQ_buffer[2 * i] = re * oscCos - im * oscSin;
+      IQ_buffer[2 * i + 1] = re * oscSin + im * oscCos;
+      float32_t nextCos = oscCos * rotCos - oscSin * rotSin;
+      oscSin = oscCos * rotSin + oscSin * rotCos;
+      oscCos = nextCos;
+    }
+    ncoPhase += phaseInc * (end - start);
   }
 }
 
@@ -100,6 +100,9 @@ FLASHMEM void loadConfiguration(const char *filename, config_t &EEPROMData) {
   EEPROMData.receiveEQFlag = doc["receiveEQFlag"];
   EEPROMData.xmitEQFlag = doc["xmitEQFlag"];
   EEPROMData.CWToneIndex = doc["CWToneIndex"];
+  EEPROMData.NB_RF_on = doc["NB_RF_on"];
+  EEPROMData.rxLatencyMode = doc["rxLatencyMode"];
+  EEPROMData.rxConvMode = doc["rxConvMode"];
 
   EEPROMData.TransmitPowerLevelCW   = doc["TransmitPowerLevelCW"];          // Power level factors by mode
   EEPROMData.TransmitPowerLevelSSB  = doc["TransmitPowerLevelSSB"];          // Power level factors by mode
@@ -195,6 +198,9 @@ Serial.println(String(__FUNCTION__)+": "+String(filename));
   doc["receiveEQFlag"] = EEPROMData.receiveEQFlag;
   doc["xmitEQFlag"] = EEPROMData.xmitEQFlag;
   doc["CWToneIndex"] = EEPROMData.CWToneIndex;
+  doc["NB_RF_on"] = EEPROMData.NB_RF_on;
+  doc["rxLatencyMode"] = EEPROMData.rxLatencyMode;
+  doc["rxConvMode"] = EEPROMData.rxConvMode;
 
   doc["TransmitPowerLevelCW"]  = EEPROMData.TransmitPowerLevelCW;              // Power level factors by mode
   doc["TransmitPowerLevelSSB"] = EEPROMData.TransmitPowerLevelSSB;              // Power level factors by mode
@@ -207,6 +207,24 @@ int CWOptions()  // new option for Sidetone and Delay JJP 9/1/22
       SetTransmitDelay();  // Transmit relay hold delay
       break;
 
+    case 8:  // Skimmer, decodes every CW signal in the receive passband
+      cwSkimmerOn = !cwSkimmerOn;
+      if (cwSkimmerOn) {
+        CWSkimmerReset();
+      }
+      UpdateDecoderField();
+      break;
+
+    case 9: {  // Receive latency: a shorter block for break-in, at more CPU and wider filter skirts
+      const char *latency[] = { "Normal", "Low", "Lowest", "Cancel" };
+      int choice = SubmenuSelect(latency, 4, rxLatencyMode);
+      if (choice >= RX_LATENCY_NORMAL && choice <= RX_LATENCY_LOWEST) {
+        SetRxLatencyMode(choice);
+        EEPROMWrite();
+      }
+      break;
+    }
+
     default:  // Cancel
       break;
   }
@@ -464,7 +482,7 @@ void ProcessEqualizerChoices(int EQType, char *title) {
 }
 
 /*****
-  Purpose: Receive EQ set
+  Purpose: Receive EQ set, and the receive filter length
 
   Parameter list:
     void
@@ -490,9 +508,18 @@ int EqualizerRecOptions() {
       //EEPROMData.receiveEQFlag = receiveEQFlag;
       ProcessEqualizerChoices(0, (char *)"Receive Equalizer");
       break;
-    case 3:
+    case 3: {  // Receive convolution: a larger FFT for a longer filter in every mode, at more delay
+      const char *convolution[] = { "Standard", "Efficient", "Sharp", "Cancel" };
+      int choice = SubmenuSelect(convolution, 4, rxConvMode);
+      if (choice >= RX_CONV_STANDARD && choice <= RX_CONV_SHARP) {
+        SetRxConvMode(choice);
+      }
+      break;
+    }
+    case 4:
       break;
   }
+  InitFilterMask();  // The receive EQ lives in the filter mask
   EEPROMWrite();
   UpdateEqualizationFields();
   RedrawDisplayScreen();
@@ -532,6 +559,7 @@ int EqualizerXmtOptions() {
     case 3:
       break;
   }
+  InitSSBModulator();  // The transmit EQ lives in the modulator's filter mask
   EEPROMWrite();
   UpdateEqualizationFields();
   RedrawDisplayScreen();
@@ -799,6 +827,17 @@ int RFOptions() {
         returnValue = xv;
         break;
       }
+    case 7:  // Impulse blanker on the wideband I/Q, RFNoiseBlanker()
+      {
+        const char *blanker[] = { "Off", "On", "Cancel" };
+        int choice = SubmenuSelect(blanker, 3, NB_RF_on);
+        if (choice == 0 || choice == 1) {
+          NB_RF_on = choice;
+          EEPROMWrite();
+        }
+        returnValue = NB_RF_on;
+        break;
+      }
 
     default:  // Cancel
       returnValue = -1;
@@ -1021,6 +1060,10 @@ int EEPROMOptions() {
       CopySDToEEPROM();  // Copy from SD to EEPROM
       EEPROMRead();      // KF5N
 #endif                  // USE_JSON
+      SetRxLatencyMode(rxLatencyMode);  // Run with the restored block size
+      SetRxConvMode(rxConvMode);        // and filter length
+      InitFilterMask();                 // The receive EQ lives in the filter mask
+      InitSSBModulator();               // and the transmit EQ in the modulator's
       tft.writeTo(L2);  // This is specifically to clear the bandwidth indicator bar.  KF5N August 7, 2023
       tft.clearMemory();
       tft.writeTo(L1);
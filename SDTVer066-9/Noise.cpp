@@ -30,6 +30,11 @@ int NROptions() //AFP 09-19-22 Moved here from Menu Proc Revised
       NR_Index=3;
       break;
 
+    case 4:                                 // Spectral, in the receive FFT
+      NR_Index=4;
+      FFTNoiseReductionReset();
+      break;
+
     default:
 #ifdef DEBUG    
       Serial.print("Error in NROptions");
@@ -44,11 +49,12 @@ int NROptions() //AFP 09-19-22 Moved here from Menu Proc Revised
 /*****
   Purpose: Kim1_NR()
   Parameter list:
-    void
+    float32_t *audio        audio block, filtered in place
+    uint32_t count          samples, a multiple of NR_FFT_L / 2 and no more than NR_FFT_L
   Return value;
     void
 *****/
-void Kim1_NR() 
+void Kim1_NR(float32_t *audio, uint32_t count) 
 {
   /**********************************************************************************
       EXPERIMENTAL STATION FOR SPECTRAL NOISE REDUCTION
@@ -107,7 +113,7 @@ void Kim1_NR()
       VAD_high = NR_FFT_L / 2;
     }
 
-    for (int k = 0; k < 2; k++) {
+    for (int k = 0; k < (int)(count / (NR_FFT_L / 2)); k++) {
       // NR_FFT_buffer is 512 floats big
       // interleaved r, i, r, i . . .
       // fill first half of FFT_buffer with last events audio samples
@@ -117,11 +123,11 @@ void Kim1_NR()
       }
       // copy recent samples to last_sample_buffer for next time!
       for (int i = 0; i < NR_FFT_L  / 2; i++) {
-        NR_last_sample_buffer_L [i] = float_buffer_L[i + k * (NR_FFT_L / 2)];
+        NR_last_sample_buffer_L [i] = audio[i + k * (NR_FFT_L / 2)];
       }
       // now fill recent audio samples into second half of FFT_buffer
       for (int i = 0; i < NR_FFT_L / 2; i++) {
-        NR_FFT_buffer[NR_FFT_L + i * 2] = float_buffer_L[i + k * (NR_FFT_L / 2)]; // real
+        NR_FFT_buffer[NR_FFT_L + i * 2] = audio[i + k * (NR_FFT_L / 2)]; // real
         NR_FFT_buffer[NR_FFT_L + i * 2 + 1] = 0.0;
       }
       // perform windowing on 256 real samples in the NR_FFT_buffer
@@ -239,77 +245,272 @@ void Kim1_NR()
       }
     }
 
-    for (int i = 0; i < NR_FFT_L; i++) {
-      float_buffer_L[i] = NR_output_audio_buffer[i]; // * 9.0; // * 5.0;
-      float_buffer_R[i] = float_buffer_L[i];
+    for (unsigned i = 0; i < count; i++) {
+      audio[i] = NR_output_audio_buffer[i]; // * 9.0; // * 5.0;
     }
   } // end of Kim et al. 2002 algorithm
 
 }
+/*****
+  Variable leak LMS state.  The noise reduction and the automatic notch each have their own, so both
+  can run on the same block.  The delay line is stored twice, back to back: every sample is written at
+  inIdx and at inIdx + ANR_DLINE_SIZE, so the ANR_taps samples the filter reads always sit in one
+  contiguous run and the dot product and weight update need no index masking.  ANR_delay + ANR_taps
+  must not exceed ANR_DLINE_SIZE.
+*****/
+struct anrLMS {
+  float32_t d[2 * ANR_DLINE_SIZE];  // Newest sample at inIdx, older ones above it
+  float32_t w[ANR_DLINE_SIZE];
+  int inIdx;
+  float32_t lidx;
+  float32_t ngamma;
+  bool initialized;
+};
+static struct anrLMS anrNR;
+static struct anrLMS anrNotch;  // The audio notch where the FFT bins are unusable, see ProcessIQData()
+
 /*****
   Purpose:   void xanr
   Parameter list:
     void
   Return value;
     void
+  Notes: ANR_notch picks the automatic notch (output the error) or the noise reduction (output the
+         prediction), each with its own state.  The notch is only the fallback for FFTs the bin notch
+         cannot use, see FFTAutoNotch(): those shorter than RX_FFT_NOTCH_MIN_LENGTH in the low latency
+         modes, and those too large for the bin stage tables.
 *****/
 void Xanr() // variable leak LMS algorithm for automatic notch or noise reduction
 { // (c) Warren Pratt wdsp library 2016
-  int idx;
+  struct anrLMS *s = ANR_notch ? &anrNotch : &anrNR;
   float32_t c0, c1;
   float32_t y, error, sigma, inv_sigp;
   float32_t nel, nev;
 
+  if (!s->initialized) {
+    s->lidx = ANR_lidx_min;
+    s->ngamma = 0.001;
+    s->initialized = true;
+  }
+
   for (int i = 0; i < ANR_buff_size; i++) {
-    ANR_d[ANR_in_idx] = float_buffer_L[i];
+    float32_t x = float_buffer_L[i];
+    s->d[s->inIdx] = x;
+    s->d[s->inIdx + ANR_DLINE_SIZE] = x;
+    const float32_t *dl = &s->d[s->inIdx + ANR_delay];
 
     y = 0;
     sigma = 0;
-
     for (int j = 0; j < ANR_taps; j++) {
-      idx = (ANR_in_idx + j + ANR_delay) & ANR_mask;
-      y += ANR_w[j] * ANR_d[idx];
-      sigma += ANR_d[idx] * ANR_d[idx];
+      y += s->w[j] * dl[j];
+      sigma += dl[j] * dl[j];
     }
     inv_sigp = 1.0 / (sigma + 1e-10);
-    error = ANR_d[ANR_in_idx] - y;
+    error = x - y;
 
     if (ANR_notch)
-      float_buffer_R[i] = error;                            // NOTCH FILTER
+      float_buffer_L[i] = error;                            // NOTCH FILTER
     else
-      float_buffer_R[i] = y;                                // NOISE REDUCTION
+      float_buffer_L[i] = y;                                // NOISE REDUCTION
 
     if ((nel = error * (1.0 - ANR_two_mu * sigma * inv_sigp)) < 0.0)
       nel = -nel;
-    if ((nev = ANR_d[ANR_in_idx] - (1.0 - ANR_two_mu * ANR_ngamma) * y - ANR_two_mu * error * sigma * inv_sigp) < 0.0)
+    if ((nev = x - (1.0 - ANR_two_mu * s->ngamma) * y - ANR_two_mu * error * sigma * inv_sigp) < 0.0)
       nev = -nev;
     if (nev < nel) {
-      if ((ANR_lidx += ANR_lincr) > ANR_lidx_max)
-        ANR_lidx = ANR_lidx_max;
-      else if ((ANR_lidx -= ANR_ldecr) < ANR_lidx_min)
-        ANR_lidx = ANR_lidx_min;
+      if ((s->lidx += ANR_lincr) > ANR_lidx_max)
+        s->lidx = ANR_lidx_max;
+      else if ((s->lidx -= ANR_ldecr) < ANR_lidx_min)
+        s->lidx = ANR_lidx_min;
     }
-    ANR_ngamma = ANR_gamma * (ANR_lidx * ANR_lidx) * (ANR_lidx * ANR_lidx) * ANR_den_mult;
+    s->ngamma = ANR_gamma * (s->lidx * s->lidx) * (s->lidx * s->lidx) * ANR_den_mult;
 
-    c0 = 1.0 - ANR_two_mu * ANR_ngamma;
+    c0 = 1.0 - ANR_two_mu * s->ngamma;
     c1 = ANR_two_mu * error * inv_sigp;
 
     for (int j = 0; j < ANR_taps; j++) {
-      idx = (ANR_in_idx + j + ANR_delay) & ANR_mask;
-      ANR_w[j] = c0 * ANR_w[j] + c1 * ANR_d[idx];
+      s->w[j] = c0 * s->w[j] + c1 * dl[j];
     }
-    ANR_in_idx = (ANR_in_idx + ANR_mask) & ANR_mask;
+    s->inIdx = (s->inIdx + ANR_DLINE_SIZE - 1) & (ANR_DLINE_SIZE - 1);
   }
 }
 
 /*****
-  Purpose: spectral_noise_reduction
+  Spectral NR engine.  The constants of the gain rule depend only on the frame time, so NRRuleInit()
+  works them out once.  Each per bin quantity has its own array, so the bin loops run straight through
+  memory with no stride, and the only transcendental left in them is the speech presence probability
+  exp(), done by NRFastExp().  SpectralNoiseReduction() and FFTNoiseReduction() share the rule:
+  NRNoiseEstimate() and NRGain() do one frame of it.
+*****/
+#define NR_BINS (NR_FFT_L / 2)
+#define NR_INIT_FRAMES 20  // Frames of NR_FFT_L / 2 samples averaged for the first noise estimate, about 100 ms
+
+struct nrRule {
+  float32_t ax;          // Noise output smoothing per frame, exp(-tinc / tax)
+  float32_t ap;          // Speech probability smoothing per frame, exp(-tinc / tap)
+  float32_t xih1r;       // 1 / (1 + xih1) - 1, xih1 the active SNR
+  float32_t pfac;        // (1 / pspri - 1) * (1 + xih1)
+  float32_t snrPostMin;  // Floor of the a posteriori SNR, -20 dB
+  int initFrames;        // Frames averaged for the first noise estimate, the time of NR_INIT_FRAMES
+};
+
+struct spectralNR {
+  struct nrRule rule;
+  int initFrames;        // Frames left to average for the first noise estimate
+  float32_t X[NR_BINS];           // Power of this frame
+  float32_t noise[NR_BINS];       // xt, noise power estimate
+  float32_t speechProb[NR_BINS];  // pslp, smoothed speech presence probability
+  float32_t G[NR_BINS];           // Gain
+  float32_t HkOld[NR_BINS];       // Last a priori SNR, decision directed
+  float32_t smoothG[NR_BINS];     // Gain after the musical noise averaging
+};
+static struct spectralNR DMAMEM specNR;
+
+/*****
+  Purpose: exp(x) for the speech presence probability.  2^(x / ln 2) is split into a power of two,
+           put straight into the exponent bits, and 2^f for the fraction f in [0, 1), from a cubic
+           fitted for relative error.  The result is within 1.7e-4 of expf() relative, from about
+           -87 up to +88, and 0 below that.
+
+  Parameter list:
+    float32_t x
+
+  Return value;
+    float32_t       exp(x)
+*****/
+static inline float32_t NRFastExp(float32_t x) {
+  if (x < -87.0) {
+    return 0.0;
+  }
+  float32_t t = x * 1.44269504;  // log2(e)
+  float32_t whole = floorf(t);
+  float32_t f = t - whole;
+  union {
+    float32_t f;
+    int32_t i;
+  } p;
+  p.f = 1.0 + f * (0.69503748 + f * (0.22830251 + f * 0.07633082));
+  p.i += (int32_t)whole * (1 << 23);  // Not a shift: whole is negative for x < 0
+  return p.f;
+}
+
+/*****
+  Purpose: Work out the gain rule constants for frames of hop new samples.  The smoothing time
+           constants and the time of the first noise estimate are the same for any frame size.
+
+  Parameter list:
+    struct nrRule *r
+    uint32_t hop            new samples per frame, at the decimated rate
+
+  Return value;
+    void
+*****/
+static void NRRuleInit(struct nrRule *r, uint32_t hop) {
+  const float32_t tax = 0.0239;   // noise output smoothing time constant = -tinc/ln(0.8)
+  const float32_t tap = 0.05062;  // speech prob smoothing time constant = -tinc/ln(0.9)
+  const float32_t asnr = 20;      // active SNR in dB
+  const float32_t pspri = 0.5;    // prior speech probability [0.5]
+  float32_t tinc = hop / ((float32_t)SR[SampleRate].rate / DF);  // frame time, 5.3333ms for 128 samples at 24K SPS
+  float32_t xih1 = powf(10, asnr / 10.0);
+
+  r->ax = expf(-tinc / tax);
+  r->ap = expf(-tinc / tap);
+  r->xih1r = 1.0 / (1.0 + xih1) - 1.0;
+  r->pfac = (1.0 / pspri - 1.0) * (1.0 + xih1);
+  r->snrPostMin = powf(10, -20.0 / 20.0);
+  r->initFrames = max(NR_INIT_FRAMES * (NR_FFT_L / 2) / (int)hop, 1);
+}
+
+/*****
+  Purpose: Add one frame to the first noise estimate, which averages r->initFrames frames
+
+  Parameter list:
+    const struct nrRule *r
+    const float32_t *X          power of this frame per bin
+    float32_t *noise            noise power estimate, zeroed before the first frame
+    int n                       bins
+
+  Return value;
+    void
+*****/
+static void NRNoiseStart(const struct nrRule *r, const float32_t *X, float32_t *noise, int n) {
+  const float32_t psini = 0.5;  // initial speech probability [0.5]
+  for (int bindx = 0; bindx < n; bindx++) {
+    noise[bindx] += psini / r->initFrames * X[bindx];
+  }
+}
+
+/*****
+  Purpose: Update the noise estimate from the speech presence probability, Gerkmann & Hendriks
+
+  Parameter list:
+    const struct nrRule *r
+    const float32_t *X          power of this frame per bin
+    float32_t *noise            xt, noise power estimate
+    float32_t *speechProb       pslp, smoothed speech presence probability
+    int n                       bins
+
+  Return value;
+    void
+*****/
+static void NRNoiseEstimate(const struct nrRule *r, const float32_t *X, float32_t *noise, float32_t *speechProb, int n) {
+  const float32_t psthr = 0.99;  // threshold for smoothed speech probability [0.99]
+  const float32_t pnsaf = 0.01;  // noise probability safety value [0.01]
+  for (int bindx = 0; bindx < n; bindx++) {
+    float32_t xt = fmaxf(noise[bindx], 1.0e-20);
+    float32_t ph1y = 1.0 / (1.0 + r->pfac * NRFastExp(r->xih1r * X[bindx] / xt));
+    speechProb[bindx] = r->ap * speechProb[bindx] + (1.0 - r->ap) * ph1y;
+    if (speechProb[bindx] > psthr) {
+      ph1y = 1.0 - pnsaf;
+    }
+    float32_t xtr = (1.0 - ph1y) * X[bindx] + ph1y * xt;
+    noise[bindx] = r->ax * xt + (1.0 - r->ax) * xtr;
+  }
+}
+
+/*****
+  Purpose: Decision directed a priori SNR and the gain of each bin, Romanin et al.
+
   Parameter list:
+    const struct nrRule *r
+    const float32_t *X          power of this frame per bin
+    const float32_t *noise      noise power estimate
+    float32_t *HkOld            last a priori SNR
+    float32_t *G                gain out
+    int n                       bins
+    float32_t *prePower         total power of the bins before the gain
+    float32_t *postPower        and after it
+
+  Return value;
     void
+*****/
+static void NRGain(const struct nrRule *r, const float32_t *X, const float32_t *noise, float32_t *HkOld, float32_t *G,
+                   int n, float32_t *prePower, float32_t *postPower) {
+  float32_t pre = 0.0;
+  float32_t post = 0.0;
+  for (int bindx = 0; bindx < n; bindx++) {
+    float32_t snrPost = fmaxf(fminf(X[bindx] / fmaxf(noise[bindx], 1.0e-20), 1000.0), r->snrPostMin);  // limited to +30 /-20 dB
+    float32_t snrPrio = fmaxf(NR_alpha * HkOld[bindx] + (1.0 - NR_alpha) * fmaxf(snrPost - 1.0, 0.0), 0.0);
+    float32_t v = snrPrio * snrPost / (1.0 + snrPrio);
+    float32_t g = sqrtf(0.7212 * v + v * v) / snrPost;
+    G[bindx] = g;
+    HkOld[bindx] = snrPost * g * g;
+    pre += X[bindx];
+    post += g * g * X[bindx];
+  }
+  *prePower = pre;
+  *postPower = post;
+}
+
+/*****
+  Purpose: spectral_noise_reduction
+  Parameter list:
+    float32_t *audio        audio block, filtered in place
+    uint32_t count          samples, a multiple of NR_FFT_L / 2
   Return value;
     void
 *****/
-void SpectralNoiseReduction()
+void SpectralNoiseReduction(float32_t *audio, uint32_t count)
 /************************************************************************************************************
 
       Noise reduction with spectral subtraction rule
@@ -321,40 +522,13 @@ void SpectralNoiseReduction()
    STAND: UHSDR github 14.1.2018
    ************************************************************************************************************/
 {
-  static uint8_t NR_init_counter = 0;
-  uint8_t VAD_low = 0;
-  uint8_t VAD_high = 127;
-  float32_t lf_freq; // = (offset - width/2) / (12000 / NR_FFT_L); // bin BW is 46.9Hz [12000Hz / 256 bins] @96kHz
-  float32_t uf_freq; //= (offset + width/2) / (12000 / NR_FFT_L);
-
-  const float32_t tinc = 0.00533333;  // frame time 5.3333ms
-  const float32_t tax = 0.0239;       // noise output smoothing time constant = -tinc/ln(0.8)
-  const float32_t tap = 0.05062;      // speech prob smoothing time constant = -tinc/ln(0.9) tinc = frame time (5.33ms)
-  const float32_t psthr = 0.99;       // threshold for smoothed speech probability [0.99]
-  const float32_t pnsaf = 0.01;       // noise probability safety value [0.01]
-  const float32_t asnr = 20;          // active SNR in dB
-  const float32_t psini = 0.5;        // initial speech probability [0.5]
-  const float32_t pspri = 0.5;        // prior speech probability [0.5]
-  static float32_t ax;                //=0.8;       // ax=exp(-tinc/tax); % noise output smoothing factor
-  static float32_t ap;                //=0.9;        // ap=exp(-tinc/tap); % noise output smoothing factor
-  static float32_t xih1;              // = 31.6;
-  ax = expf(-tinc / tax);
-  ap = expf(-tinc / tap);
-  xih1 = powf(10, (float32_t)asnr / 10.0);
-  static float32_t xih1r = 1.0 / (1.0 + xih1) - 1.0;
-  static float32_t pfac = (1.0 / pspri - 1.0) * (1.0 + xih1);
-  float32_t snr_prio_min = powf(10, - (float32_t)20 / 20.0);
-  static float32_t pslp[NR_FFT_L / 2];
-  static float32_t xt[NR_FFT_L / 2];
-  static float32_t xtr;
-  static float32_t pre_power;
-  static float32_t post_power;
-  static float32_t power_ratio;
-  static int16_t NN;
   const int16_t NR_width = 4;
   const float32_t power_threshold = 0.4;
-  float32_t ph1y[NR_FFT_L / 2];
-  static int NR_first_time_2 = 1;
+  struct spectralNR *e = &specNR;
+  int VAD_low;
+  int VAD_high;
+  float32_t lf_freq;  // = (offset - width/2) / (12000 / NR_FFT_L); // bin BW is 46.9Hz [12000Hz / 256 bins] @96kHz
+  float32_t uf_freq;  //= (offset + width/2) / (12000 / NR_FFT_L);
 
   if (bands[currentBand].FLoCut <= 0 && bands[currentBand].FHiCut >= 0) {
     lf_freq = 0.0;
@@ -368,212 +542,389 @@ void SpectralNoiseReduction()
       lf_freq = -(float32_t)bands[currentBand].FHiCut;
     }
   }
-  // / rate DF SR[SampleRate].rate/DF
-  lf_freq /= ((SR[SampleRate].rate / DF) / NR_FFT_L); // bin BW is 46.9Hz [12000Hz / 256 bins] @96kHz
+  lf_freq /= ((SR[SampleRate].rate / DF) / NR_FFT_L);  // bin BW is 46.9Hz [12000Hz / 256 bins] @96kHz
   uf_freq /= ((SR[SampleRate].rate / DF) / NR_FFT_L);
-
-
-  // INITIALIZATION ONCE 1
-  if (NR_first_time_2 == 1) { // TODO: properly initialize all the variables
-    for (int bindx = 0; bindx < NR_FFT_L / 2; bindx++) {
-      NR_last_sample_buffer_L[bindx] = 0.0;
-      NR_G[bindx] = 1.0;
-      //xu[bindx] = 1.0;  //has to be replaced by other variable
-      NR_Hk_old[bindx] = 1.0; // old gain or xu in development mode
-      NR_Nest[bindx][0] = 0.0;
-      NR_Nest[bindx][1] = 1.0;
-      pslp[bindx] = 0.5;
-    }
-    NR_first_time_2 = 2; // we need to do some more a bit later down
+  VAD_low = (int)lf_freq;
+  VAD_high = (int)uf_freq;
+  if (VAD_low == VAD_high) {
+    VAD_high++;
+  }
+  if (VAD_low < 1) {
+    VAD_low = 1;
+  } else if (VAD_low > NR_BINS - 2) {
+    VAD_low = NR_BINS - 2;
+  }
+  if (VAD_high < 1) {
+    VAD_high = 1;
+  } else if (VAD_high > NR_BINS) {
+    VAD_high = NR_BINS;
   }
 
-  for (int k = 0; k < 2; k++) {
+  for (int k = 0; k < (int)(count / (NR_FFT_L / 2)); k++) {
     // NR_FFT_buffer is 512 floats big
     // interleaved r, i, r, i . . .
-    // fill first half of FFT_buffer with last events audio samples
-    for (int i = 0; i < NR_FFT_L / 2; i++) {
-      NR_FFT_buffer[i * 2] = NR_last_sample_buffer_L[i]; // real
-      NR_FFT_buffer[i * 2 + 1] = 0.0; // imaginary
-    }
-    // copy recent samples to last_sample_buffer for next time!
-    for (int i = 0; i < NR_FFT_L  / 2; i++) {
-      NR_last_sample_buffer_L [i] = float_buffer_L[i + k * (NR_FFT_L / 2)];
-    }
-    // now fill recent audio samples into second half of FFT_buffer
+    // fill first half of FFT_buffer with last events audio samples, the second half with the new ones
     for (int i = 0; i < NR_FFT_L / 2; i++) {
-      NR_FFT_buffer[NR_FFT_L + i * 2] = float_buffer_L[i + k * (NR_FFT_L / 2)]; // real
+      NR_FFT_buffer[i * 2] = NR_last_sample_buffer_L[i] * sqrtHann[i];  // sqrt Hann window
+      NR_FFT_buffer[i * 2 + 1] = 0.0;
+      NR_FFT_buffer[NR_FFT_L + i * 2] = audio[i + k * (NR_FFT_L / 2)] * sqrtHann[NR_FFT_L / 2 + i];
       NR_FFT_buffer[NR_FFT_L + i * 2 + 1] = 0.0;
     }
-#if 1
-    // perform windowing on samples in the NR_FFT_buffer
-    for (int idx = 0; idx < NR_FFT_L; idx++) { // sqrt Hann window
-      //float32_t temp_sample = 0.5 * (float32_t)(1.0 - (cosf(PI * 2.0 * (float32_t)idx / (float32_t)((NR_FFT_L) - 1))));
-      //NR_FFT_buffer[idx * 2] *= temp_sample;
-      NR_FFT_buffer[idx * 2] *= sqrtHann[idx];
-    }
-#endif
+    // copy recent samples to last_sample_buffer for next time!
+    arm_copy_f32(&audio[k * (NR_FFT_L / 2)], NR_last_sample_buffer_L, NR_FFT_L / 2);
 
-    // NR_FFT
-    // calculation is performed in-place the FFT_buffer [re, im, re, im, re, im . . .]
     arm_cfft_f32(NR_FFT, NR_FFT_buffer, 0, 1);
+    arm_cmplx_mag_squared_f32(NR_FFT_buffer, e->X, NR_BINS);  // Squared magnitude for the current frame
 
-    for (int bindx = 0; bindx < NR_FFT_L / 2; bindx++) {
-      // this is squared magnitude for the current frame
-      NR_X[bindx][0] = (NR_FFT_buffer[bindx * 2] * NR_FFT_buffer[bindx * 2] + NR_FFT_buffer[bindx * 2 + 1] * NR_FFT_buffer[bindx * 2 + 1]);
-    }
-
-    if (NR_first_time_2 == 2) { // TODO: properly initialize all the variables
-      for (int bindx = 0; bindx < NR_FFT_L / 2; bindx++) {
-        NR_Nest[bindx][0] = NR_Nest[bindx][0] + 0.05 * NR_X[bindx][0]; // we do it 20 times to average over 20 frames for app. 100ms only on NR_on/bandswitch/modeswitch,...
-        xt[bindx] = psini * NR_Nest[bindx][0];
+    if (e->initFrames > 0) {
+      // Average over the first frames (app. 100ms) for the starting noise estimate
+      NRNoiseStart(&e->rule, e->X, e->noise, NR_BINS);
+      e->initFrames--;
+    } else {
+      // 1. Step of NR - noise estimate from the speech presence probability
+      NRNoiseEstimate(&e->rule, e->X, e->noise, e->speechProb, NR_BINS);
+
+      // 2. Step - SNRs and gain inside the filter passband
+      float32_t pre_power, post_power;
+      NRGain(&e->rule, &e->X[VAD_low], &e->noise[VAD_low], &e->HkOld[VAD_low], &e->G[VAD_low], VAD_high - VAD_low,
+             &pre_power, &post_power);
+
+      // MUSICAL NOISE TREATMENT HERE, DL2FW
+      // musical noise "artefact" reduction by dynamic averaging - depending on SNR ratio.
+      // A running sum over NN bins; the NN / 2 bins at each edge keep their own gain.
+      float32_t power_ratio = post_power / fmaxf(pre_power, 1.0e-20);
+      int NN = 1;
+      if (power_ratio <= power_threshold) {
+        NN = 1 + 2 * (int)(0.5 + NR_width * (1.0 - power_ratio / power_threshold));
       }
-      NR_init_counter++;
-      if (NR_init_counter > 19)  { //average over 20 frames for app. 100ms
-        NR_init_counter = 0;
-        NR_first_time_2 = 3;  // now we did all the necessary initialization to actually start the noise reduction
+      if (NN > 1 && VAD_high - VAD_low >= NN) {
+        float32_t sum = 0.0;
+        for (int m = VAD_low; m < VAD_low + NN; m++) {
+          sum += e->G[m];
+        }
+        for (int bindx = VAD_low + NN / 2; bindx < VAD_high - NN / 2; bindx++) {
+          e->smoothG[bindx] = sum / (float32_t)NN;
+          if (bindx + NN / 2 + 1 < VAD_high) {
+            sum += e->G[bindx + NN / 2 + 1] - e->G[bindx - NN / 2];
+          }
+        }
+        arm_copy_f32(&e->smoothG[VAD_low + NN / 2], &e->G[VAD_low + NN / 2], VAD_high - VAD_low - 2 * (NN / 2));
       }
     }
 
-    if (NR_first_time_2 == 3) {
-      for (int bindx = 0; bindx < NR_FFT_L / 2; bindx++) { // 1. Step of NR - calculate the SNR's
-        ph1y[bindx] = 1.0 / (1.0 + pfac * expf(xih1r * NR_X[bindx][0] / xt[bindx]));
-        pslp[bindx] = ap * pslp[bindx] + (1.0 - ap) * ph1y[bindx];
+    // FINAL SPECTRAL WEIGHTING: Multiply current FFT results with the 128 bin-specific gain factors G,
+    // on both halves of the conjugate symmetric spectrum
+    for (int bindx = 0; bindx < NR_BINS; bindx++) {
+      float32_t gain = e->G[bindx] * NR_long_tone_gain[bindx];
+      NR_FFT_buffer[bindx * 2] *= gain;
+      NR_FFT_buffer[bindx * 2 + 1] *= gain;
+      NR_FFT_buffer[NR_FFT_L * 2 - bindx * 2 - 2] *= gain;
+      NR_FFT_buffer[NR_FFT_L * 2 - bindx * 2 - 1] *= gain;
+    }
 
-        if (pslp[bindx] > psthr) {
-          ph1y[bindx] = 1.0 - pnsaf;
-        } else {
-          ph1y[bindx] = fmin(ph1y[bindx] , 1.0);
-        }
-        xtr = (1.0 - ph1y[bindx]) * NR_X[bindx][0] + ph1y[bindx] * xt[bindx];
-        xt[bindx] = ax * xt[bindx] + (1.0 - ax) * xtr;
-      }
-      for (int bindx = 0; bindx < NR_FFT_L / 2; bindx++) { // 1. Step of NR - calculate the SNR's
-        NR_SNR_post[bindx] = fmax(fmin(NR_X[bindx][0] / xt[bindx], 1000.0), snr_prio_min); // limited to +30 /-15 dB, might be still too much of reduction, let's try it?
-        NR_SNR_prio[bindx] = fmax(NR_alpha * NR_Hk_old[bindx] + (1.0 - NR_alpha) * fmax(NR_SNR_post[bindx] - 1.0, 0.0), 0.0);
-      }
+    arm_cfft_f32(NR_iFFT, NR_FFT_buffer, 1, 1);
 
-      VAD_low = (int)lf_freq;
-      VAD_high = (int)uf_freq;
-      if (VAD_low == VAD_high) {
-        VAD_high++;
-      }
-      if (VAD_low < 1) {
-        VAD_low = 1;
-      } else if (VAD_low > NR_FFT_L / 2 - 2) {
-        VAD_low = NR_FFT_L / 2 - 2;
-      }
-      if (VAD_high < 1) {
-        VAD_high = 1;
-      } else if (VAD_high > NR_FFT_L / 2) {
-        VAD_high = NR_FFT_L / 2;
-      }
+    // do the overlap & add: the first half of this frame, windowed, plus the second half of the last one
+    for (int i = 0; i < NR_FFT_L / 2; i++) {
+      audio[i + k * (NR_FFT_L / 2)] = NR_FFT_buffer[i * 2] * sqrtHann[i] + NR_last_iFFT_result[i];
+      NR_last_iFFT_result[i] = NR_FFT_buffer[NR_FFT_L + i * 2] * sqrtHann[NR_FFT_L / 2 + i];
+    }
+  }
+}
 
-      float32_t v;
-      for (int bindx = VAD_low; bindx < VAD_high; bindx++) { // maybe we should limit this to the signal containing bins (filtering!!)
-        {
-          v = NR_SNR_prio[bindx] * NR_SNR_post[bindx] / (1.0 + NR_SNR_prio[bindx]);
-          NR_G[bindx] = 1.0 / NR_SNR_post[bindx] * sqrtf((0.7212 * v + v * v));
-          NR_Hk_old[bindx] = NR_SNR_post[bindx] * NR_G[bindx] * NR_G[bindx]; //
-        }
+/*****
+  Purpose: Work out the spectral NR constants for the current sample rate and start its noise
+           estimate over
 
-        // MUSICAL NOISE TREATMENT HERE, DL2FW
+  Parameter list:
+    void
 
-        // musical noise "artefact" reduction by dynamic averaging - depending on SNR ratio
-        pre_power  = 0.0;
-        post_power = 0.0;
-        for (int bindx = VAD_low; bindx < VAD_high; bindx++) {
-          pre_power += NR_X[bindx][0];
-          post_power += NR_G[bindx] * NR_G[bindx]  * NR_X[bindx][0];
-        }
+  Return value;
+    void
+*****/
+static void SpectralNoiseReductionEngineInit() {
+  struct spectralNR *e = &specNR;
+
+  NRRuleInit(&e->rule, NR_FFT_L / 2);
+  e->initFrames = e->rule.initFrames;
+  arm_fill_f32(0.0, e->noise, NR_BINS);
+  arm_fill_f32(0.5, e->speechProb, NR_BINS);
+  arm_fill_f32(1.0, e->G, NR_BINS);
+  arm_fill_f32(1.0, e->HkOld, NR_BINS);
+}
 
-        power_ratio = post_power / pre_power;
-        if (power_ratio > power_threshold) {
-          power_ratio = 1.0;
-          NN = 1;
-        } else {
-          NN = 1 + 2 * (int)(0.5 + NR_width * (1.0 - power_ratio / power_threshold));
-        }
+/*****
+  Spectral noise reduction in the receive convolution FFT (NR_Index 4)
 
-        for (int bindx = VAD_low + NN / 2; bindx < VAD_high - NN / 2; bindx++) {
-          NR_Nest[bindx][0] = 0.0;
-          for (int m = bindx - NN / 2; m <= bindx + NN / 2; m++) {
-            NR_Nest[bindx][0] += NR_G[m];
-          }
-          NR_Nest[bindx][0] /= (float32_t)NN;
-        }
+  The same speech presence / decision directed gain rule as SpectralNoiseReduction(), but worked out on
+  the filtered I/Q spectrum in iFFT_buffer, one frame per block, just before the inverse FFT.  The gain
+  is then one real vector multiply and there are no FFTs of its own.  Only the bins inside the receive
+  filter are worked on; for AM and SAM the carrier bins keep unity gain so the detectors still see it.
 
-        // and now the edges - only going NN steps forward and taking the average
-        // lower edge
-        for (int bindx = VAD_low; bindx < VAD_low + NN / 2; bindx++) {
-          NR_Nest[bindx][0] = 0.0;
-          for (int m = bindx; m < (bindx + NN); m++) {
-            NR_Nest[bindx][0] += NR_G[m];
-          }
-          NR_Nest[bindx][0] /= (float32_t)NN;
-        }
+  Changing the gain per block in an overlap-save convolution is not an exact linear filter, but the
+  gains are smoothed over time and across bins, so what wraps round is well below the noise it removes.
+*****/
+static float32_t DMAMEM fftNRGain[FFT_LENGTH];    // Per bin, unity outside the receive filter
+static float32_t DMAMEM fftNRPower[FFT_LENGTH];   // These are indexed from the low filter edge
+static float32_t DMAMEM fftNRNoise[FFT_LENGTH];   // xt, noise power estimate
+static float32_t DMAMEM fftNRSpeech[FFT_LENGTH];  // pslp, smoothed speech presence probability
+static float32_t DMAMEM fftNRHkOld[FFT_LENGTH];   // Last a priori SNR, decision directed
+static float32_t DMAMEM fftNRG[FFT_LENGTH];
+static int fftNRFrames = 0;
+static int fftNRLoBin = 0;
+static int fftNRBins = 0;
+static int fftNRLoCut, fftNRHiCut, fftNRMode = -1;
+static struct nrRule fftNRRule;
 
-        // upper edge - only going NN steps backward and taking the average
-        for (int bindx = VAD_high - NN; bindx < VAD_high; bindx++) {
-          NR_Nest[bindx][0] = 0.0;
-          for (int m = bindx; m > (bindx - NN); m--) {
-            NR_Nest[bindx][0] += NR_G[m];
-          }
-          NR_Nest[bindx][0] /= (float32_t)NN;
-        }
+/*****
+  Purpose: Start the FFT domain NR over, from a fresh noise estimate
 
-        // end of edge treatment
+  Parameter list:
+    void
 
-        for (int bindx = VAD_low + NN / 2; bindx < VAD_high - NN / 2; bindx++) {
-          NR_G[bindx] = NR_Nest[bindx][0];
-        }
-        // end of musical noise reduction
-      } //end of "if ts.nr_first_time == 3"
-
-#if 1
-      // FINAL SPECTRAL WEIGHTING: Multiply current FFT results with NR_FFT_buffer for 128 bins with the 128 bin-specific gain factors G
-      //              for(int bindx = 0; bindx < NR_FFT_L / 2; bindx++)                 // try 128:
-      for (int bindx = 0; bindx < NR_FFT_L / 2; bindx++) {                              // try 128:
-        NR_FFT_buffer[bindx * 2]                    = NR_FFT_buffer [bindx * 2] * NR_G[bindx] * NR_long_tone_gain[bindx];              // real part
-        NR_FFT_buffer[bindx * 2 + 1]                = NR_FFT_buffer [bindx * 2 + 1] * NR_G[bindx] * NR_long_tone_gain[bindx];      // imag part
-        NR_FFT_buffer[NR_FFT_L * 2 - bindx * 2 - 2] = NR_FFT_buffer[NR_FFT_L * 2 - bindx * 2 - 2] * NR_G[bindx] * NR_long_tone_gain[bindx]; // real part conjugate symmetric
-        NR_FFT_buffer[NR_FFT_L * 2 - bindx * 2 - 1] = NR_FFT_buffer[NR_FFT_L * 2 - bindx * 2 - 1] * NR_G[bindx] * NR_long_tone_gain[bindx]; // imag part conjugate symmetric
-      }
+  Return value;
+    void
+*****/
+void FFTNoiseReductionReset() {
+  fftNRMode = -1;
+}
 
-#endif
-      /*****************************************************************
-         NOISE REDUCTION CODE ENDS HERE
-       *****************************************************************/
-      // very interesting!
-      // if I leave the FFT_buffer as is and just multiply the 19 bins below with 0.1, the audio
-      // is distorted a little bit !
-      // To me, this is an indicator of a problem with windowing . . .
-      //
+/*****
+  Purpose: Set up the bin range and time constants for the current filter and clear the estimates.
+           A frame is rxConvHop new samples, so NRRuleInit() scales the smoothing per frame and the
+           frames of the first noise estimate to it; SetRxLatencyMode() and SetRxConvolution() change
+           the hop and start the NR over through FFTNoiseReductionReset().
 
-#if 0
-      for (int bindx = 1; bindx < 20; bindx++)
-        // bins 2 to 29 attenuated
-        // set real values to 0.1 of their original value
-      {
-        NR_FFT_buffer[bindx * 2] *= 0.1;
-        NR_FFT_buffer[bindx * 2 + 1] *= 0.1; //NR_iFFT_buffer[idx] * 0.1;
-      }
-#endif
+  Parameter list:
+    void
 
-      arm_cfft_f32(NR_iFFT, NR_FFT_buffer, 1, 1);
+  Return value;
+    void
+*****/
+static void FFTNoiseReductionSetup() {
+  float32_t binBW = (float32_t)SR[SampleRate].rate / DF / FFT_length;
+
+  fftNRLoCut = bands[currentBand].FLoCut;
+  fftNRHiCut = bands[currentBand].FHiCut;
+  fftNRMode = bands[currentBand].mode;
+  NRRuleInit(&fftNRRule, rxConvHop);
+
+  int lo = (int)floorf(fftNRLoCut / binBW);
+  int hi = (int)ceilf(fftNRHiCut / binBW);
+  lo = max(lo, -(int)FFT_length / 2 + 1);
+  hi = min(hi, (int)FFT_length / 2 - 1);
+  fftNRLoBin = lo;
+  fftNRBins = max(hi - lo + 1, 1);
+
+  arm_fill_f32(1.0, fftNRGain, FFT_length);
+  arm_fill_f32(0.0, fftNRNoise, fftNRBins);
+  arm_fill_f32(0.5, fftNRSpeech, fftNRBins);  // psini
+  arm_fill_f32(1.0, fftNRHkOld, fftNRBins);
+  arm_fill_f32(1.0, fftNRG, fftNRBins);
+  fftNRFrames = 0;
+}
 
-      for (int idx = 0; idx < NR_FFT_L; idx++) {
-        NR_FFT_buffer[idx * 2] *= sqrtHann[idx];      // sqrt Hann window
-      }
+/*****
+  Purpose: Apply spectral noise reduction to the filtered spectrum in iFFT_buffer
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+void FFTNoiseReduction() {
+  const int NRWidth = 4;
+  const float32_t powerThreshold = 0.4;
+  const int mask = FFT_length - 1;
+
+  if (fftNRMode != bands[currentBand].mode || fftNRLoCut != bands[currentBand].FLoCut || fftNRHiCut != bands[currentBand].FHiCut) {
+    FFTNoiseReductionSetup();
+  }
+  const int n = fftNRBins;
+
+  for (int j = 0; j < n; j++) {
+    int bin = (fftNRLoBin + j) & mask;
+    fftNRPower[j] = iFFT_buffer[bin * 2] * iFFT_buffer[bin * 2] + iFFT_buffer[bin * 2 + 1] * iFFT_buffer[bin * 2 + 1];
+  }
+
+  if (fftNRFrames < fftNRRule.initFrames) {
+    // Average the first frames for the starting noise estimate and leave the audio alone
+    NRNoiseStart(&fftNRRule, fftNRPower, fftNRNoise, n);
+    fftNRFrames++;
+    return;
+  }
+
+  // Noise estimate from the speech presence probability, then the gain
+  float32_t prePower, postPower;
+  NRNoiseEstimate(&fftNRRule, fftNRPower, fftNRNoise, fftNRSpeech, n);
+  NRGain(&fftNRRule, fftNRPower, fftNRNoise, fftNRHkOld, fftNRG, n, &prePower, &postPower);
+
+  // Musical noise: average the gains over more bins the more the frame was cut back, DL2FW
+  int NN = 1;
+  float32_t powerRatio = postPower / fmaxf(prePower, 1.0e-20);
+  if (powerRatio <= powerThreshold) {
+    NN = 1 + 2 * (int)(0.5 + NRWidth * (1.0 - powerRatio / powerThreshold));
+  }
+  NN = min(NN, n);
+  float32_t sum = 0.0;
+  for (int j = 0; j < NN; j++) {
+    sum += fftNRG[j];
+  }
+  for (int j = 0; j < n; j++) {
+    // Running mean over NN bins, held at the first and last full window at the edges
+    int first = min(max(j - NN / 2, 0), n - NN);
+    if (first > 0 && j - NN / 2 == first) {
+      sum += fftNRG[first + NN - 1] - fftNRG[first - 1];
+    }
+    fftNRGain[(fftNRLoBin + j) & mask] = sum / NN;
+  }
+
+  if (bands[currentBand].mode == DEMOD_AM || bands[currentBand].mode == DEMOD_SAM) {
+    fftNRGain[0] = fftNRGain[1] = fftNRGain[FFT_length - 1] = 1.0;  // The carrier
+  }
+
+  arm_cmplx_mult_real_f32(iFFT_buffer, fftNRGain, iFFT_buffer, FFT_length);
+}
+
+/*****
+  Automatic notch in the receive convolution FFT (tone killer)
+
+  Works on the filtered I/Q spectrum in iFFT_buffer, before the inverse FFT, like FFTNoiseReduction().
+  Each block, every bin's power is compared with the mean of the bins around it, leaving out its own
+  main lobe.  A bin that stands well above its neighbours as a local peak for enough blocks in a row
+  is taken as a carrier, and it and the bins either side are cut until it has been gone for half as
+  long.  Speech and CW come and go too fast to build up the count.  The gains are ramped from block to
+  block so a notch opens and closes without a click.  Any number of carriers cost the same one pass over
+  the bins.  For AM and SAM the carrier bins are left alone so the detectors still see it.
+*****/
+#define FFT_NOTCH_SIDE 8          // Neighbours each side for the local mean
+#define FFT_NOTCH_GAP 2           // Bins each side of the centre left out of the local mean
+#define FFT_NOTCH_ON 20.0         // Peak over local mean to count a carrier, 13 dB
+#define FFT_NOTCH_OFF 6.0         // And to count down again, 8 dB
+#define FFT_NOTCH_HOLD 30         // Blocks to open a notch, about 320 ms
+#define FFT_NOTCH_DEPTH 0.01      // -40 dB
+#define FFT_NOTCH_RAMP 0.5        // Gain step towards its target per block
+
+static float32_t DMAMEM fftNotchPower[FFT_LENGTH];   // Indexed from the low filter edge
+static float32_t DMAMEM fftNotchSum[FFT_LENGTH + 1];  // Running sum of fftNotchPower
+static float32_t DMAMEM fftNotchGain[FFT_LENGTH];
+static uint8_t DMAMEM fftNotchCount[FFT_LENGTH];  // Blocks a bin has looked like a carrier, up to FFT_NOTCH_HOLD
+static bool DMAMEM fftNotchActive[FFT_LENGTH];
+static int fftNotchLoBin = 0;
+static int fftNotchBins = 0;
+static int fftNotchLoCut, fftNotchHiCut, fftNotchMode = -1;
+
+/*****
+  Purpose: Clear all notches and start detecting afresh
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+void FFTAutoNotchReset() {
+  fftNotchMode = -1;
+}
 
-      // do the overlap & add
-      for (int i = 0; i < NR_FFT_L / 2; i++) {        // take real part of first half of current iFFT result and add to 2nd half of last iFFT_result
-        float_buffer_L[i + k * (NR_FFT_L / 2)] = NR_FFT_buffer[i * 2] + NR_last_iFFT_result[i];
-        float_buffer_R[i + k * (NR_FFT_L / 2)] = float_buffer_L[i + k * (NR_FFT_L / 2)];
+/*****
+  Purpose: Set up the bin range for the current filter and clear the notches
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+static void FFTAutoNotchSetup() {
+  float32_t binBW = (float32_t)SR[SampleRate].rate / DF / FFT_length;
+
+  fftNotchLoCut = bands[currentBand].FLoCut;
+  fftNotchHiCut = bands[currentBand].FHiCut;
+  fftNotchMode = bands[currentBand].mode;
+
+  int lo = (int)floorf(fftNotchLoCut / binBW);
+  int hi = (int)ceilf(fftNotchHiCut / binBW);
+  lo = max(lo, -(int)FFT_length / 2 + 1);
+  hi = min(hi, (int)FFT_length / 2 - 1);
+  fftNotchLoBin = lo;
+  fftNotchBins = max(hi - lo + 1, 1);
+
+  arm_fill_f32(1.0, fftNotchGain, fftNotchBins);
+  memset(fftNotchCount, 0, sizeof(fftNotchCount));
+  memset(fftNotchActive, 0, sizeof(fftNotchActive));
+}
+
+/*****
+  Purpose: Find steady carriers in the filtered spectrum in iFFT_buffer and notch them out
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+void FFTAutoNotch() {
+  const int mask = FFT_length - 1;
+
+  if (fftNotchMode != bands[currentBand].mode || fftNotchLoCut != bands[currentBand].FLoCut || fftNotchHiCut != bands[currentBand].FHiCut) {
+    FFTAutoNotchSetup();
+  }
+  const int n = fftNotchBins;
+  const bool keepCarrier = (fftNotchMode == DEMOD_AM || fftNotchMode == DEMOD_SAM);
+
+  fftNotchSum[0] = 0.0;
+  for (int j = 0; j < n; j++) {
+    int bin = (fftNotchLoBin + j) & mask;
+    fftNotchPower[j] = iFFT_buffer[bin * 2] * iFFT_buffer[bin * 2] + iFFT_buffer[bin * 2 + 1] * iFFT_buffer[bin * 2 + 1];
+    fftNotchSum[j + 1] = fftNotchSum[j] + fftNotchPower[j];
+  }
+
+  // Count each bin up while it is a clear local peak and down once it has sunk back into its neighbours
+  for (int j = 0; j < n; j++) {
+    int bin = (fftNotchLoBin + j) & mask;
+    if (keepCarrier && (bin <= 1 || bin == mask)) {
+      continue;
+    }
+    int outerLo = max(j - FFT_NOTCH_SIDE, 0);
+    int outerHi = min(j + FFT_NOTCH_SIDE + 1, n);
+    int innerLo = max(j - FFT_NOTCH_GAP, 0);
+    int innerHi = min(j + FFT_NOTCH_GAP + 1, n);
+    int count = (outerHi - outerLo) - (innerHi - innerLo);
+    if (count <= 0) {
+      continue;
+    }
+    float32_t local = (fftNotchSum[outerHi] - fftNotchSum[outerLo] - fftNotchSum[innerHi] + fftNotchSum[innerLo]) / count;
+    float32_t P = fftNotchPower[j];
+    bool peak = (j == 0 || P >= fftNotchPower[j - 1]) && (j == n - 1 || P >= fftNotchPower[j + 1]);
+
+    if (peak && P > FFT_NOTCH_ON * local) {
+      if (fftNotchCount[j] < FFT_NOTCH_HOLD && ++fftNotchCount[j] == FFT_NOTCH_HOLD) {
+        fftNotchActive[j] = true;
       }
-      for (int i = 0; i < NR_FFT_L / 2; i++) {
-        NR_last_iFFT_result[i] = NR_FFT_buffer[NR_FFT_L + i * 2];
+    } else if (!peak || P < FFT_NOTCH_OFF * local) {
+      // Twice as fast down as up, so a keyed signal cannot creep up to FFT_NOTCH_HOLD
+      fftNotchCount[j] = (fftNotchCount[j] > 2) ? fftNotchCount[j] - 2 : 0;
+      if (fftNotchCount[j] == 0) {
+        fftNotchActive[j] = false;
       }
-      // end of "for" loop which repeats the FFT_iFFT_chain two times !!!
+    }
+  }
+
+  // Ramp each bin's gain towards its target: cut if it or a neighbour carries a notch
+  for (int j = 0; j < n; j++) {
+    int bin = (fftNotchLoBin + j) & mask;
+    if (keepCarrier && (bin <= 1 || bin == mask)) {
+      continue;
+    }
+    bool cut = fftNotchActive[j] || (j > 0 && fftNotchActive[j - 1]) || (j < n - 1 && fftNotchActive[j + 1]);
+    float32_t target = cut ? FFT_NOTCH_DEPTH : 1.0;
+    float32_t g = fftNotchGain[j] + FFT_NOTCH_RAMP * (target - fftNotchGain[j]);
+    fftNotchGain[j] = g;
+    if (g < 0.999) {
+      iFFT_buffer[bin * 2] *= g;
+      iFFT_buffer[bin * 2 + 1] *= g;
     }
   }
 }
@@ -650,16 +1001,12 @@ void SpectralNoiseReductionInit()
   for (int bindx = 0; bindx < NR_FFT_L / 2; bindx++)
   {
     NR_last_sample_buffer_L[bindx] = 0.1;
-    NR_Hk_old[bindx] = 0.1; // old gain
-    NR_Nest[bindx][0] = 0.01;
-    NR_Nest[bindx][1] = 0.015;
     NR_Gts[bindx][1] = 0.1;
     NR_M[bindx] = 500.0;
     NR_E[bindx][0] = 0.1;
     NR_X[bindx][1] = 0.5;
-    NR_SNR_post[bindx] = 2.0;
-    NR_SNR_prio[bindx] = 1.0;
     NR_first_time = 2;
     NR_long_tone_gain[bindx] = 1.0;
   }
+  SpectralNoiseReductionEngineInit();
 }
@@ -8,6 +8,143 @@ bool FFTupdated;
 int16_t adjAmplitude = 0;  // Was float; cast to float in dB calculation.
 int16_t refAmplitude = 0;
 uint32_t index_of_max = 0;
+
+#define RX_FFT_NOTCH_MIN_LENGTH 256  // Shorter FFTs have bins too wide to notch a carrier, see SetRxLatencyMode()
+
+/*****
+  Audio stages that work on fixed frames: the Kim and spectral NR (NR_FFT_L / 2 samples) and the LPC
+  noise blanker (NB_FFT_SIZE).  In the low latency modes the audio block is shorter than their frame,
+  so they run behind a FIFO of one frame, which adds that frame to the delay while they are on.
+*****/
+struct framedStage {
+  float32_t in[NB_FFT_SIZE];
+  float32_t out[NB_FFT_SIZE];
+  uint32_t fill;
+  uint32_t count;  // Block size last seen; a change empties the FIFO
+};
+static struct framedStage rxNRFrames, rxNBFrames;
+
+/*****
+  Purpose: Run a frame based stage on a block of audio, through a FIFO if the block is shorter than
+           the frame
+
+  Parameter list:
+    struct framedStage *f                             FIFO for this stage
+    void (*stage)(float32_t *audio, uint32_t count)   the stage, in place on whole frames
+    uint32_t frame                                    samples per frame, no more than NB_FFT_SIZE
+    float32_t *audio                                  audio block, in place
+    uint32_t count                                    samples in the block, a multiple or a divisor of frame
+
+  Return value;
+    void
+*****/
+static void RunFramedStage(struct framedStage *f, void (*stage)(float32_t *, uint32_t), uint32_t frame, float32_t *audio, uint32_t count) {
+  if (count != f->count) {
+    f->count = count;
+    f->fill = 0;
+    memset(f->out, 0, sizeof(f->out));
+  }
+  if (count >= frame) {
+    stage(audio, count);
+    return;
+  }
+  for (uint32_t i = 0; i < count; i++) {
+    float32_t x = audio[i];
+    audio[i] = f->out[f->fill];
+    f->in[f->fill] = x;
+    if (++f->fill == frame) {
+      stage(f->in, frame);
+      arm_copy_f32(f->in, f->out, frame);
+      f->fill = 0;
+    }
+  }
+}
+
+/*****
+  Purpose: NoiseBlanker() as a frame based stage
+
+  Parameter list:
+    float32_t *audio        one NB_FFT_SIZE frame, in place
+    uint32_t count          unused, always NB_FFT_SIZE
+
+  Return value;
+    void
+*****/
+static void NoiseBlankerFrame(float32_t *audio, uint32_t count) {
+  (void)count;
+  NoiseBlanker(audio, audio);
+}
+
+/*****
+  Receive convolution framing.  Each block's decimated I/Q is collected in FFT_buffer after the
+  FFT_length - rxConvHop samples of overlap, and the FFT runs once rxConvHop samples are there.  Its
+  output, rxConvHop samples at the end of iFFT_buffer, is then played out a block per call while the
+  next ones are collected.  With the standard convolution rxConvHop is one block, and this is the usual
+  overlap-save with no wait.
+*****/
+static uint32_t rxConvFill = 0;    // Samples collected for the next FFT, a multiple of BUF_N_DF
+static uint32_t rxConvLength = 0;  // FFT_length and rxConvHop the collected samples are for
+static uint32_t rxConvHopSeen = 0;
+float32_t *rxFilteredIQ = iFFT_buffer + FFT_LENGTH;
+
+/*****
+  The mask the last block was filtered with, so a change of filter, mode or band can be faded in.
+  The previous mask stays in the filter mask cache, pinned there with FilterMaskPin().
+*****/
+static float32_t *rxMaskInUse = NULL;
+static uint32_t rxMaskLength = 0;
+
+/*****
+  Purpose: Crossfade from the output of the old filter mask to the new one over one block.  Both are
+           the same signal through two linear phase filters, so the gains are raised cosines that add
+           to one, and a part of the signal both filters pass keeps its level throughout.
+
+  Parameter list:
+    const float32_t *oldIQ      interleaved I/Q through the old mask
+    float32_t *newIQ            interleaved I/Q through the new mask, replaced by the crossfade
+    uint32_t count              complex samples
+
+  Return value;
+    void
+*****/
+static void RxMaskCrossfade(const float32_t *oldIQ, float32_t *newIQ, uint32_t count) {
+  for (uint32_t i = 0; i < count; i++) {
+    float32_t g = 0.5 - 0.5 * arm_cos_f32(PI * ((float32_t)i + 0.5) / (float32_t)count);
+    newIQ[2 * i] = oldIQ[2 * i] + g * (newIQ[2 * i] - oldIQ[2 * i]);
+    newIQ[2 * i + 1] = oldIQ[2 * i + 1] + g * (newIQ[2 * i + 1] - oldIQ[2 * i + 1]);
+  }
+}
+
+/*****
+  Purpose: Delay from the ADC to the audio output through the receive filters, leaving out the wait
+           for a block to fill and the time to process it: the decimator, the convolution filter and
+           the blocks it collects, the AGC look-ahead, any frame FIFOs and the two interpolators.  All of them are linear phase,
+           so the delay is the same at every audio frequency.  The CW audio filters are IIR and not
+           counted.
+
+  Parameter list:
+    void
+
+  Return value;
+    float32_t               delay in ms
+*****/
+float32_t RxFilterDelayMs() {
+  uint32_t audioDelay = (m_NumTaps - 1) / 2 + rxConvHop - BUF_N_DF;  // Samples at the decimated rate
+  uint32_t audioBlock = BUF_N_DF;
+  if (AGCMode != 0) {
+    audioDelay += attack_buffsize;
+  }
+  if ((NR_Index == 1 || NR_Index == 2 || (NR_Index == 4 && FFT_length > FFT_LENGTH)) && audioBlock < NR_FFT_L / 2) {
+    audioDelay += NR_FFT_L / 2;
+  }
+  if (NB_on != 0 && audioBlock < NB_FFT_SIZE) {
+    audioDelay += NB_FFT_SIZE;
+  }
+  // FIR_int1 has 48 taps at SR / DF1 and FIR_int2 32 taps at SR
+  float32_t adcDelay = RxDecimatorDelay() + DF * audioDelay + DF1 * (48 - 1) / 2.0 + (32 - 1) / 2.0;
+  return 1000.0 * adcDelay / SR[SampleRate].rate;
+}
+
 /*****
   Purpose: Read audio from Teensy Audio Library
              Calculate FFT for display
@@ -37,33 +174,45 @@ void ProcessIQData() {
      **********************************************************************************/
   float32_t audioMaxSquared;
   uint32_t AudioMaxIndex;
-  float rfGainValue;
   
   // are there at least N_BLOCKS buffers in each channel available ?
   if ((uint32_t)Q_in_L.available() > N_BLOCKS + 0 && (uint32_t)Q_in_R.available() > N_BLOCKS + 0) {
     usec = 0;
+    // The oldest queued sample arrived this long ago; the latency is timed from then
+    PROFILE_BEGIN_AT(profileLatency, Q_in_L.available() * BUFFER_SIZE);
+    PROFILE_BEGIN(profileTotal);
+    PROFILE_BEGIN(profileMark);
+    /**********************************************************************************
+        Receive front end, one pass over each block:
+          convert to float (samples standardized from > -1.0 to < 1.0),
+          RFGain for all bands and the RFgain value in the bands[currentBand] structure,
+          IQ amplitude and phase correction.  The I and Q channels are equalized and phase
+          corrected manually; the correction is applied to the L channel only, and the phase
+          correction mixes a little of one channel into the other.
+        All of these are linear, so UpdateIQFrontEnd() folds them into one 2x2 matrix that is only
+        recomputed when a gain, calibration factor or the mode changes.
+     **********************************************************************************/
+    UpdateIQFrontEnd();
     // get audio samples from the audio  buffers and convert them to float
     // read in 32 blocks á 128 samples in I and Q
+    // The wideband I/Q is interleaved [I, Q, I, Q . . .] and goes straight into the history of the
+    // first decimation stage; the blanker, display and NCO below all work on it there
+    float32_t *iq = RxDecimatorInput();
     for (unsigned i = 0; i < N_BLOCKS; i++) {
       sp_L1 = Q_in_R.readBuffer();
       sp_R1 = Q_in_L.readBuffer();
-
-
-      /**********************************************************************************  AFP 12-31-20
-          Using arm_Math library, convert to float one buffer_size.
-          Float_buffer samples are now standardized from > -1.0 to < 1.0
-      **********************************************************************************/
-      arm_q15_to_float(sp_L1, &float_buffer_L[BUFFER_SIZE * i], BUFFER_SIZE);  // convert int_buffer to float 32bit
-      arm_q15_to_float(sp_R1, &float_buffer_R[BUFFER_SIZE * i], BUFFER_SIZE);  // convert int_buffer to float 32bit
+      IQFrontEnd(sp_L1, sp_R1, &iq[2 * BUFFER_SIZE * i], BUFFER_SIZE);
       Q_in_L.freeBuffer();
       Q_in_R.freeBuffer();
     }
+    PROFILE_MARK(PROF_RX_FRONT_END, profileMark);
     //if (radioState == CW_TRANSMIT_STRAIGHT_STATE || radioState == CW_TRANSMIT_KEYER_STATE) {  //AFP 09-01-22
     //   return;
     //  }
     // Set frequency here only to minimize interruption to signal stream during tuning
     // This code was unnecessary in the revised tuning scheme.  KF5N July 22, 2023
-    if (centerTuneFlag == 1) {  //AFP 10-04-22
+    // While the display is moving memory the redraws are held until the next block
+    if (centerTuneFlag == 1 && displayBusy == 0) {  //AFP 10-04-22
       DrawBandWidthIndicatorBar();
       ShowFrequency();
 
@@ -72,27 +221,23 @@ void ProcessIQData() {
       //    SetFreq();            //AFP 10-04-22
       // BandInformation();
 
-
-    }                    //AFP 10-04-22
-    centerTuneFlag = 0;  //AFP 10-04-22
-    if (resetTuningFlag == 1) {
+      centerTuneFlag = 0;  //AFP 10-04-22
+    }                      //AFP 10-04-22
+    if (resetTuningFlag == 1 && displayBusy == 0) {
       ResetTuning();
+      resetTuningFlag = 0;
     }
-    resetTuningFlag = 0;
+    PROFILE_MARK(PROF_RX_TUNE_UI, profileMark);
 //=================== AFP 01-25-25 IQ Test Signals
 #ifdef IQ_REC_TEST
-    arm_scale_f32(sinBuffer2K, -.0002, float_buffer_L, BUFFER_SIZE * N_BLOCKS);  //AFP 01-25-25
-    arm_scale_f32(cosBuffer2K, .0002, float_buffer_R, BUFFER_SIZE * N_BLOCKS);
+    for (unsigned i = 0; i < BUFFER_SIZE * N_BLOCKS; i++) {  //AFP 01-25-25
+      iq[2 * i] = -.0002 * sinBuffer2K[i];
+      iq[2 * i + 1] = .0002 * cosBuffer2K[i];
+    }
+    IQFrontEndFloat(iq, BUFFER_SIZE * N_BLOCKS);  // Test signals get the same gain and IQ correction
 #endif
     //=====================
 
-
-    /*******************************
-            Set RFGain - for all bands
-    */
-    rfGainValue = pow(10, (float)rfGainAllBands / 20);
-    arm_scale_f32(float_buffer_L, rfGainValue, float_buffer_L, BUFFER_SIZE * N_BLOCKS);  //AFP 09-27-22
-    arm_scale_f32(float_buffer_R, rfGainValue, float_buffer_R, BUFFER_SIZE * N_BLOCKS);  //AFP 09-27-22
     /**********************************************************************************  AFP 12-31-20
         Remove DC offset to reduce centeral spike.  First read the Mean value of
         left and right channels.  Then fill L and R correction arrays with those Means
@@ -120,12 +265,6 @@ void ProcessIQData() {
 
     //===========================
 
-    /**********************************************************************************  AFP 12-31-20
-        Scale the data buffers by the RFgain value defined in bands[currentBand] structure
-    **********************************************************************************/
-    arm_scale_f32(float_buffer_L, bands[currentBand].RFgain, float_buffer_L, BUFFER_SIZE * N_BLOCKS);  //AFP 09-23-22
-    arm_scale_f32(float_buffer_R, bands[currentBand].RFgain, float_buffer_R, BUFFER_SIZE * N_BLOCKS);  //AFP 09-23-22
-
     /**********************************************************************************  AFP 12-31-20
       Clear Buffers
       This is to prevent overfilled queue buffers during each switching event
@@ -144,17 +283,14 @@ void ProcessIQData() {
       AudioInterrupts();
     }
     /**********************************************************************************  AFP 12-31-20
-      IQ amplitude and phase correction.  For this scaled down version the I an Q chnnels are
-      equalized and phase corrected manually. This is done by applying a correction, which is the difference, to
-      the L channel only.  The phase is corrected in the IQPhaseCorrection() function.
-
-      IQ amplitude and phase correction
+      IQ amplitude and phase correction is done in the front end above; the receive calibration
+      below changes the factors, which take effect from the next block.
     ***********************************************************************************************/
     //for(int k=0;k<2048;k++){
     //  Serial.println(float_buffer_L[k]);
     //}
 
-    if (recCalOnFlag == 1) {
+    if (recCalOnFlag == 1 && displayBusy == 0) {
       spectrum_zoom = SPECTRUM_ZOOM_1;
       if (updateCalDisplayFlag == 1) {
         CalibratePreamble(0);
@@ -259,22 +395,12 @@ void ProcessIQData() {
         Serial.println(adjAmplitude);
                Serial.print("adjdB= ");
         Serial.println(adjdB);*/
-    } else {
+    } else if (recCalOnFlag != 1) {
       recCalOnFlag = 0;
       //UpdateInfoWindow();
     }  //End Rec Cal
+    PROFILE_MARK(PROF_RX_CAL_UI, profileMark);
 
-    // Manual IQ amplitude and phase correction
-    // to be honest: we only correct the amplitude of the I channel ;-)
-    if (bands[currentBand].mode == DEMOD_LSB || bands[currentBand].mode == DEMOD_AM || bands[currentBand].mode == DEMOD_SAM) {
-      arm_scale_f32(float_buffer_L, -IQAmpCorrectionFactor[currentBand], float_buffer_L, BUFFER_SIZE * N_BLOCKS);  //AFP 04-14-22
-      IQPhaseCorrection(float_buffer_L, float_buffer_R, -IQPhaseCorrectionFactor[currentBand], BUFFER_SIZE * N_BLOCKS);
-    } else {
-      if (bands[currentBand].mode == DEMOD_USB || bands[currentBand].mode == DEMOD_AM || bands[currentBand].mode == DEMOD_SAM) {
-        arm_scale_f32(float_buffer_L, -IQAmpCorrectionFactor[currentBand], float_buffer_L, BUFFER_SIZE * N_BLOCKS);  //AFP 04-14-22
-        IQPhaseCorrection(float_buffer_L, float_buffer_R, IQPhaseCorrectionFactor[currentBand], BUFFER_SIZE * N_BLOCKS);
-      }
-    }
 
     /**********************************************************************************  AFP 12-31-20
         Perform a 256 point FFT for the spectrum display on the basis of the first 256 complex values
@@ -285,42 +411,29 @@ void ProcessIQData() {
      ***********************************************************************************************/
 
     if (spectrum_zoom == SPECTRUM_ZOOM_1) {  // && display_S_meter_or_spectrum_state == 1)
-      CalcZoom1Magn();
+      CalcZoom1Magn(iq, BUFFER_SIZE * N_BLOCKS);
       FFTupdated = true;  //AFP Moved to display function
+      PROFILE_MARK(PROF_RX_SPECTRUM, profileMark);
     }
     display_S_meter_or_spectrum_state++;
     if (radioState == CW_TRANSMIT_STRAIGHT_STATE || radioState == CW_TRANSMIT_KEYER_STATE) {  //AFP 09-01-22
       return;
     }
 
-    /**********************************************************************************  AFP 12-31-20
-        Frequency translation by Fs/4 without multiplication from Lyons (2011): chapter 13.1.2 page 646
-        together with the savings of not having to shift/rotate the FFT_buffer, this saves
-        about 1% of processor use
-
-        This is for +Fs/4 [moves receive frequency to the left in the spectrum display]
-           float_buffer_L contains I = real values
-           float_buffer_R contains Q = imaginary values
-           xnew(0) =  xreal(0) + jximag(0)
-               leave first value (DC component) as it is!
-           xnew(1) =  - ximag(1) + jxreal(1)
-    **********************************************************************************/
-    FreqShift1();
-    //===
-
-    //===
     /**********************************************************************************  AFP 12-31-20
         SPECTRUM_ZOOM_2 and larger here after frequency conversion!
         Spectrum zoom displays a magnified display of the data around the translated receive frequency.
-        Processing is done in the ZoomFFTExe(BUFFER_SIZE * N_BLOCKS) function.  For magnifications of 2x to 8X
+        Processing is done in the ZoomFFTExe(iq, BUFFER_SIZE * N_BLOCKS) function.  For magnifications of 2x to 8X
         Larger magnification are not needed in practice.
 
         Spectrum Zoom uses the shifted spectrum, so the center "hump" around DC is shifted by fs/4
+        ZoomFFTExe() applies the Fs/4 shift to its own copy; the receive chain does it in FreqShift2()
      **********************************************************************************/
     if (spectrum_zoom != SPECTRUM_ZOOM_1) {
       //AFP  Used to process Zoom>1 for display
-      ZoomFFTExe(BUFFER_SIZE * N_BLOCKS);  // there seems to be a BUG here, because the blocksize has to be adjusted according to magnification,
+      ZoomFFTExe(iq, BUFFER_SIZE * N_BLOCKS);  // there seems to be a BUG here, because the blocksize has to be adjusted according to magnification,
       // does not work for magnifications > 8
+      PROFILE_MARK(PROF_RX_ZOOM_FFT, profileMark);
     }
 
     /**********************************************************************************  AFP 12-31-20
@@ -330,12 +443,22 @@ void ProcessIQData() {
     //  CalibrateOptions(IQChoice);
     // }
 
+    /**********************************************************************************
+        RF noise blanker
+        Impulses are gated out here, while they are still a few samples long.  The spectrum display
+        above still shows them.
+     **********************************************************************************/
+    if (NB_RF_on != 0) {
+      RFNoiseBlanker(iq, BUFFER_SIZE * N_BLOCKS);
+      PROFILE_MARK(PROF_RX_RF_NB, profileMark);
+    }
+
     /*************************************************************************************************
         freq_conv2()
 
         FREQUENCY CONVERSION USING A SOFTWARE QUADRATURE OSCILLATOR
         Creates a new IF frequency to allow the tuning window to be moved anywhere in the current display.
-        THIS VERSION calculates the COS AND SIN WAVE on the fly - uses double precision float
+        The Fs/4 translation is folded into the same oscillator, so this is one complex multiply per sample.
 
         MAJOR ADVANTAGE: frequency conversion can be done for any frequency !
 
@@ -345,154 +468,185 @@ void ProcessIQData() {
         Lyons, R.G. (2011): Understanding Digital Processing. – Pearson, 3rd edition.
      *************************************************************************************************/
 
-    FreqShift2();  //AFP 12-14-21
+    FreqShift2(iq, BUFFER_SIZE * N_BLOCKS);  //AFP 12-14-21
+    PROFILE_MARK(PROF_RX_NCO, profileMark);
                    /**********************************************************************************  AFP 12-31-20
         Decimation
         Resample (Decimate) the shifted time signal, first by 4, then by 2.  Each time the
         signal is decimated by an even number, the spectrum is reversed.  Resampling twice
         returns the spectrum to the correct orientation.
         Signal has now been shifted to base band, leaving aliases at higher frequencies,
-        which are removed at each decimation step using the Arm combined decimate/filter function.
+        which are removed at each decimation step by the half-band filters in RxDecimate().
         If the statring sample rate is 192K SPS after the combined decimation, the sample rate is
         now 192K/8 = 24K SPS.  The array size is also reduced by 8, making FFT calculations much faster.
         The effective bandwidth (up to Nyquist frequency) is 12KHz.
      **********************************************************************************/
 
-    // decimation-by-4 in-place!
-    arm_fir_decimate_f32(&FIR_dec1_I, float_buffer_L, float_buffer_L, BUFFER_SIZE * N_BLOCKS);
-    arm_fir_decimate_f32(&FIR_dec1_Q, float_buffer_R, float_buffer_R, BUFFER_SIZE * N_BLOCKS);
-
-    // decimation-by-2 in-place
-    arm_fir_decimate_f32(&FIR_dec2_I, float_buffer_L, float_buffer_L, BUFFER_SIZE * N_BLOCKS / (uint32_t)DF1);
-    arm_fir_decimate_f32(&FIR_dec2_Q, float_buffer_R, float_buffer_R, BUFFER_SIZE * N_BLOCKS / (uint32_t)DF1);
+    // decimation-by-8, three half-band stages (Decimate.cpp).  The 24K SPS output goes straight into
+    // the new samples of the convolution buffer, interleaved as the FFT wants it.
+    if (FFT_length != rxConvLength || rxConvHop != rxConvHopSeen) {  // Resized: start collecting again
+      rxConvLength = FFT_length;
+      rxConvHopSeen = rxConvHop;
+      rxConvFill = 0;
+      memset(iFFT_buffer, 0, 2 * FFT_length * sizeof(float32_t));  // Silence until the first FFT
+    }
+    const uint32_t rxConvOverlap = FFT_length - rxConvHop;
+    float32_t *newIQ = &FFT_buffer[2 * (rxConvOverlap + rxConvFill)];
+    RxDecimate(newIQ, BUFFER_SIZE * N_BLOCKS);
+    PROFILE_MARK(PROF_RX_DECIMATE, profileMark);
+
+    // The skimmer decodes every CW signal in the decimated baseband, not just the one tuned in
+    if (cwSkimmerOn) {
+      CWSkimmer(newIQ, BUFFER_SIZE * N_BLOCKS / (uint32_t)DF);
+      PROFILE_MARK(PROF_RX_SKIMMER, profileMark);
+    }
 
 
 
     // =================  AFP 10-21-22 Level Adjust ===========
-    float freqKHzFcut;
-    float volScaleFactor;
-    if (bands[currentBand].mode == DEMOD_LSB) {
-      freqKHzFcut = -(float32_t)bands[currentBand].FLoCut * 0.001;
-    } else {
-      freqKHzFcut = (float32_t)bands[currentBand].FHiCut * 0.001;
-    }
-    volScaleFactor = 7.0874 * pow(freqKHzFcut, -1.232);
+    // This used to be 7.0874 * Fcut(kHz)^-1.232, which mostly undid the loss of the old decimation
+    // filters designed at the filter edge.  The half-band decimators are flat to 10KHz, so the level
+    // no longer depends on the filter width; 0.641 is what the old pair gave for a 3KHz filter, so SSB
+    // levels and the S-meter calibration are unchanged.
+    float volScaleFactor = 0.641;
     // sineTone(8);
     //       arm_scale_f32(sinBuffer2, volScaleFactor, float_buffer_L, FFT_length / 2);// use to calibrate SAM
     // arm_scale_f32(cosBuffer2, volScaleFactor, float_buffer_R, FFT_length / 2);
 
 
-    arm_scale_f32(float_buffer_L, volScaleFactor, float_buffer_L, FFT_length / 2);
-    arm_scale_f32(float_buffer_R, volScaleFactor, float_buffer_R, FFT_length / 2);
-
-
-
+    arm_scale_f32(newIQ, volScaleFactor, newIQ, 2 * BUF_N_DF);
 
-    //=================  AFP 10-21-22  =================
-    /**********************************************************************************  AFP 12-31-20
-        Digital FFT convolution
-        Filtering is accomplished by combinig (multiplying) spectra in the frequency domain.
-         basis for this was Lyons, R. (2011): Understanding Digital Processing.
-         "Fast FIR Filtering using the FFT", pages 688 - 694.
-         Method used here: overlap-and-save.
-
-        First, Create Complex time signal for CFFT routine.
-        Fill first block with Zeros
-        Then interleave RE and IM parts to create signal for FFT
-     **********************************************************************************/
-    // Prepare the audio signal buffers:
 
-    //------------------------------ ONLY FOR the VERY FIRST FFT: fill first samples with zeros
 
-    if (first_block) {  // fill real & imaginaries with zeros for the first BLOCKSIZE samples
-      for (unsigned i = 0; i < BUFFER_SIZE * N_BLOCKS / (uint32_t)(DF / 2.0); i++) {
-        FFT_buffer[i] = 0.0;
-      }
-      first_block = 0;
-    } else  // All other FFTs
 
-      //------------------------------ fill FFT_buffer with last events audio samples for all other FFT instances
-      for (unsigned i = 0; i < BUFFER_SIZE * N_BLOCKS / (uint32_t)(DF); i++) {
-        FFT_buffer[i * 2] = last_sample_buffer_L[i];      // real
-        FFT_buffer[i * 2 + 1] = last_sample_buffer_R[i];  // imaginary
+    // The FFT notch and NR keep tables of FFT_LENGTH bins; with a larger FFT their audio versions run
+    const int fftBinStages = (FFT_length <= FFT_LENGTH);
+    rxConvFill += BUF_N_DF;
+    int convFrame = (rxConvFill == rxConvHop);
+    if (convFrame) {
+      rxConvFill = 0;
+      //=================  AFP 10-21-22  =================
+      /**********************************************************************************  AFP 12-31-20
+          Digital FFT convolution
+          Filtering is accomplished by combinig (multiplying) spectra in the frequency domain.
+           basis for this was Lyons, R. (2011): Understanding Digital Processing.
+           "Fast FIR Filtering using the FFT", pages 688 - 694.
+           Method used here: overlap-and-save.
+
+          The recent samples are already at the end of FFT_buffer, interleaved RE and IM.
+          The start gets the overlap from the last FFT, or zeros for the very first one.
+       **********************************************************************************/
+      if (first_block) {
+        memset(FFT_buffer, 0, 2 * rxConvOverlap * sizeof(float32_t));
+        first_block = 0;
+      } else {
+        arm_copy_f32(last_sample_buffer, FFT_buffer, 2 * rxConvOverlap);
       }
+      arm_copy_f32(&FFT_buffer[2 * rxConvHop], last_sample_buffer, 2 * rxConvOverlap);  // copy recent samples to last_sample_buffer for next time!
 
-    for (unsigned i = 0; i < BUFFER_SIZE * N_BLOCKS / (uint32_t)(DF); i++) {  // copy recent samples to last_sample_buffer for next time!
-      last_sample_buffer_L[i] = float_buffer_L[i];
-      last_sample_buffer_R[i] = float_buffer_R[i];
-    }
-
-    //------------------------------ now fill recent audio samples into FFT_buffer (left channel: re, right channel: im)
-    for (unsigned i = 0; i < BUFFER_SIZE * N_BLOCKS / (uint32_t)(DF); i++) {
-      FFT_buffer[FFT_length + i * 2] = float_buffer_L[i];      // real
-      FFT_buffer[FFT_length + i * 2 + 1] = float_buffer_R[i];  // imaginary
-    }
-
-    /**********************************************************************************  AFP 12-31-20
-       Perform complex FFT on the audio time signals
-       calculation is performed in-place the FFT_buffer [re, im, re, im, re, im . . .]
-     **********************************************************************************/
-    arm_cfft_f32(S, FFT_buffer, 0, 1);
+      /**********************************************************************************  AFP 12-31-20
+         Perform complex FFT on the audio time signals
+         calculation is performed in-place the FFT_buffer [re, im, re, im, re, im . . .]
+       **********************************************************************************/
+      arm_cfft_f32(S, FFT_buffer, 0, 1);
 
-    /**********************************************************************************  AFP 12-31-20
-      Continuing FFT Convolution
-          Next, prepare the filter mask (done in the Filter.cpp file).  Only need to do this once for each filter setting.
-          Allows efficient real-time variable LP and HP audio filters, without the overhead of time-domain convolution filtering.
+      /**********************************************************************************  AFP 12-31-20
+        Continuing FFT Convolution
+            Next, prepare the filter mask (done in the Filter.cpp file).  Only need to do this once for each filter setting.
+            Allows efficient real-time variable LP and HP audio filters, without the overhead of time-domain convolution filtering.
 
-          After the Filter mask in the frequency domain is created, complex multiply  filter mask with the frequency domain audio data.
-          Filter mask previously calculated in setup Array of filter mask coefficients:
-          FIR_filter_mask[]
-     **********************************************************************************/
+            After the Filter mask in the frequency domain is created, complex multiply  filter mask with the frequency domain audio data.
+            Filter mask previously calculated in setup Array of filter mask coefficients:
+            FIR_filter_mask[]
+       **********************************************************************************/
 
-    arm_cmplx_mult_cmplx_f32(FFT_buffer, FIR_filter_mask, iFFT_buffer, FFT_length);
-    if (updateDisplayFlag == 1) {
-      for (int k = 0; k < 1024; k++) {
-        audioSpectBuffer[1024 - k] = (iFFT_buffer[k] * iFFT_buffer[k]);
+      arm_cmplx_mult_cmplx_f32(FFT_buffer, FIR_filter_mask, iFFT_buffer, FFT_length);
+      // A new filter is faded in over this frame: the spectrum also goes through the old mask, into
+      // FFT_buffer which is free from here on, and the two outputs are crossfaded after the inverse FFT
+      int maskCrossfade = (rxMaskInUse != NULL && rxMaskInUse != FIR_filter_mask && rxMaskLength == FFT_length);
+      if (maskCrossfade) {
+        arm_cmplx_mult_cmplx_f32(FFT_buffer, rxMaskInUse, FFT_buffer, FFT_length);
       }
-      for (int k = 0; k < 256; k++) {
+      rxMaskInUse = FIR_filter_mask;
+      rxMaskLength = FFT_length;
+      FilterMaskPin(rxMaskInUse);
+      PROFILE_MARK(PROF_RX_FFT, profileMark);
+      if (updateDisplayFlag == 1) {  // Between FFTs iFFT_buffer holds audio, so the display waits for one
+        // The audio spectrum and the S-meter are scaled for the FFT_LENGTH point FFT.  A smaller FFT has
+        // wider bins, each repeated to fill the display, and a tone in it is this much weaker.  A larger
+        // one has narrower bins, summed in groups, and a tone in it is this much stronger.
+        const unsigned stretch = FFT_length < FFT_LENGTH ? FFT_LENGTH / FFT_length : 1;
+        const unsigned group = FFT_length > FFT_LENGTH ? FFT_length / FFT_LENGTH : 1;
+        const float32_t norm = (float32_t)(stretch * stretch) / (float32_t)(group * group);
+        for (unsigned k = 0; k < 1024; k++) {
+          unsigned src = (k / 2 / stretch) * group * 2 + (k & 1);
+          float32_t sum = 0.0;
+          for (unsigned j = 0; j < group; j++) {
+            sum += iFFT_buffer[src + 2 * j] * iFFT_buffer[src + 2 * j];
+          }
+          audioSpectBuffer[1024 - k] = norm * sum;
+        }
+        // Each pixel is the mean of three bins, in dB at 18 pixels a decade: 15 * log10() mapped from
+        // 0..100 onto 0..120, plus 50.  USB, AM and SAM run the bins downward from the top.
+        float32_t audioBins[256];
+        int audioBinsReady = 1;
         if (bands[currentBand].mode == DEMOD_USB || bands[currentBand].mode == DEMOD_AM || bands[currentBand].mode == DEMOD_SAM) {  //AFP 10-26-22
-          //audioYPixel[k] = 20+  map((int)displayScale[currentScale].dBScale * log10f((audioSpectBuffer[1024 - k] + audioSpectBuffer[1024 - k + 1] + audioSpectBuffer[1024 - k + 2]) / 3), 0, 100, 0, 120);
-          audioYPixel[k] = 50 + map(15 * log10f((audioSpectBuffer[1024 - k] + audioSpectBuffer[1024 - k + 1] + audioSpectBuffer[1024 - k + 2]) / 3), 0, 100, 0, 120);
+          for (int k = 0; k < 256; k++) {
+            audioBins[k] = (audioSpectBuffer[1024 - k] + audioSpectBuffer[1024 - k + 1] + audioSpectBuffer[1024 - k + 2]) / 3;
+          }
         } else if (bands[currentBand].mode == DEMOD_LSB) {  //AFP 10-26-22
-          //audioYPixel[k] = 20+   map((int)displayScale[currentScale].dBScale * log10f((audioSpectBuffer[k] + audioSpectBuffer[k + 1] + audioSpectBuffer[k + 2]) / 3), 0, 100, 0, 120);
-          audioYPixel[k] = 50 + map(15 * log10f((audioSpectBuffer[k] + audioSpectBuffer[k + 1] + audioSpectBuffer[k + 2]) / 3), 0, 100, 0, 120);
-        }
-        if (audioYPixel[k] < 0)
-          audioYPixel[k] = 0;
-      }
-      if (recCalOnFlag != 1) {
-        arm_max_f32(audioSpectBuffer, 1024, &audioMaxSquared, &AudioMaxIndex);  // AFP 09-18-22 Max value of squared abin magnitued in audio
-        audioMaxSquaredAve = .5 * audioMaxSquared + .5 * audioMaxSquaredAve;    //AFP 09-18-22Running averaged values
-        if (freqCalFlag == 0) {                                                 //AFP 01-30-25
-          DisplaydbM();
+          for (int k = 0; k < 256; k++) {
+            audioBins[k] = (audioSpectBuffer[k] + audioSpectBuffer[k + 1] + audioSpectBuffer[k + 2]) / 3;
+          }
         } else {
+          audioBinsReady = 0;
+        }
+        if (audioBinsReady) {
+          SpectrumPixels(audioBins, audioYPixel, 256, 18.0, 50, 0, INT16_MAX);
+        }
+        if (recCalOnFlag != 1) {
+          arm_max_f32(audioSpectBuffer, 1024, &audioMaxSquared, &AudioMaxIndex);  // AFP 09-18-22 Max value of squared abin magnitued in audio
+          audioMaxSquaredAve = .5 * audioMaxSquared + .5 * audioMaxSquaredAve;    //AFP 09-18-22Running averaged values
+          if (freqCalFlag == 0) {                                                 //AFP 01-30-25
+            DisplaydbM();
+          } else {
+          }
         }
+        PROFILE_MARK(PROF_RX_AUDIO_SPECTRUM, profileMark);
+      }
+      /**********************************************************************************
+            Additional Convolution Processes:
+                // filter by just deleting bins - principle of Linrad
+
+          (automatic) notch filter = Tone killer --> the name is stolen from SNR ;-)
+          Steady carriers are found in the filtered bins and cut there, before the spectral NR so it
+          does not have to treat them as noise.  See FFTAutoNotch().
+          1 bin = SR[SampleRate].rate / DF / FFT_length = 46.9 Hz at 192K SPS
+       **********************************************************************************/
+      if (ANR_notchOn == 1 && bands[currentBand].mode != DEMOD_IQ && fftBinStages && FFT_length >= RX_FFT_NOTCH_MIN_LENGTH) {
+        FFTAutoNotch();
+        PROFILE_MARK(PROF_RX_NOTCH, profileMark);
+      }
+      if (NR_Index == 4 && bands[currentBand].mode != DEMOD_IQ && fftBinStages) {
+        FFTNoiseReduction();  // Spectral NR on the filtered spectrum, before the inverse FFT
+        PROFILE_MARK(PROF_RX_NR, profileMark);
       }
-    }
-    /**********************************************************************************
-          Additional Convolution Processes:
-              // filter by just deleting bins - principle of Linrad
-      only works properly when we have the right window function!
-
-        (automatic) notch filter = Tone killer --> the name is stolen from SNR ;-)
-        first test, we set a notch filter at 1kHz
-        which bin is that?
-        positive & negative frequency -1kHz and +1kHz --> delete 2 bins
-        we are not deleting one bin, but five bins for the test
-        1024 bins in 12ksps = 11.71Hz per bin
-        SR[SampleRate].rate / 8.0 / 1024 = bin BW
-        1000Hz / 11.71Hz = bin 85.333
-
-     **********************************************************************************/
 
-    /**********************************************************************************  AFP 12-31-20
-      After the frequency domain filter mask and other processes are complete, do a
-      complex inverse FFT to return to the time domain
-        (if sample rate = 192kHz, we are in 24ksps now, because we decimated by 8)
-        perform iFFT (in-place)  IFFT is selected by the IFFT flag=1 in the Arm CFFT function.
-     **********************************************************************************/
+      /**********************************************************************************  AFP 12-31-20
+        After the frequency domain filter mask and other processes are complete, do a
+        complex inverse FFT to return to the time domain
+          (if sample rate = 192kHz, we are in 24ksps now, because we decimated by 8)
+          perform iFFT (in-place)  IFFT is selected by the IFFT flag=1 in the Arm CFFT function.
+       **********************************************************************************/
 
-    arm_cfft_f32(iS, iFFT_buffer, 1, 1);
+      arm_cfft_f32(iS, iFFT_buffer, 1, 1);
+      if (maskCrossfade) {
+        arm_cfft_f32(iS, FFT_buffer, 1, 1);
+        RxMaskCrossfade(&FFT_buffer[2 * rxConvOverlap], &iFFT_buffer[2 * rxConvOverlap], rxConvHop);
+      }
+      PROFILE_MARK(PROF_RX_IFFT, profileMark);
+    }
+    rxFilteredIQ = &iFFT_buffer[2 * (rxConvOverlap + rxConvFill)];  // This block of the FFT output
 
     // Adjust for level alteration because of filters
 
@@ -503,6 +657,7 @@ void ProcessIQData() {
         AGC acts upon I & Q before demodulation on the decimated audio data in iFFT_buffer
      **********************************************************************************/
     AGC();  //AGC function works with time domain I and Q data buffers created in the last step
+    PROFILE_MARK(PROF_RX_AGC, profileMark);
 
     //============================  Demod  ========================
 
@@ -512,160 +667,151 @@ void ProcessIQData() {
             The demod mode is accomplished by selecting/combining the real and imaginary parts of the output of the IFFT process.
        **********************************************************************************/
     //===================== AFP 10-27-22  =========
+    /**********************************************************************************
+          Mono audio path
+            Every mode except DEMOD_IQ produces one audio channel.  From here to the q15 output only
+            float_buffer_L is processed, and the finished block is copied to the right channel as it is
+            handed to the play queue.  DEMOD_IQ keeps I and Q as separate channels; the single channel
+            EQ, NR, noise blanker and CW stages are skipped for it.
+       **********************************************************************************/
+    int stereoAudio = (bands[currentBand].mode == DEMOD_IQ);
 
     switch (bands[currentBand].mode) {
       case DEMOD_LSB:
-        for (unsigned i = 0; i < FFT_length / 2; i++) {
-          //if (bands[currentBand].mode == DEMOD_USB || bands[currentBand].mode == DEMOD_LSB ) {  // for SSB copy real part in both outputs
-          float_buffer_L[i] = iFFT_buffer[FFT_length + (i * 2)];
-
-          float_buffer_R[i] = float_buffer_L[i];
-          //}
+        for (unsigned i = 0; i < BUF_N_DF; i++) {
+          float_buffer_L[i] = rxFilteredIQ[i * 2];
         }
         break;
       case DEMOD_USB:
-        for (unsigned i = 0; i < FFT_length / 2; i++) {
-          // if (bands[currentBand].mode == DEMOD_USB || bands[currentBand].mode == DEMOD_LSB ) {  // for SSB copy real part in both outputs
-          float_buffer_L[i] = iFFT_buffer[FFT_length + (i * 2)];
-
-          float_buffer_R[i] = float_buffer_L[i];
-          audiotmp = AlphaBetaMag(iFFT_buffer[FFT_length + (i * 2)], iFFT_buffer[FFT_length + (i * 2) + 1]);
-          //}
+        for (unsigned i = 0; i < BUF_N_DF; i++) {
+          float_buffer_L[i] = rxFilteredIQ[i * 2];
         }
-
         break;
       case DEMOD_AM:
-        for (unsigned i = 0; i < FFT_length / 2; i++) {  // Magnitude estimation Lyons (2011): page 652 / libcsdr
-          audiotmp = AlphaBetaMag(iFFT_buffer[FFT_length + (i * 2)], iFFT_buffer[FFT_length + (i * 2) + 1]);
+        for (unsigned i = 0; i < BUF_N_DF; i++) {  // Magnitude estimation Lyons (2011): page 652 / libcsdr
+          audiotmp = AlphaBetaMag(rxFilteredIQ[i * 2], rxFilteredIQ[i * 2 + 1]);
           // DC removal filter -----------------------
           w = audiotmp + wold * 0.99f;  // Response to below 200Hz AFP 10-30-22
           float_buffer_L[i] = w - wold;
           wold = w;
         }
-        arm_biquad_cascade_df1_f32(&biquad_lowpass1, float_buffer_L, float_buffer_R, FFT_length / 2);
-        arm_copy_f32(float_buffer_R, float_buffer_L, FFT_length / 2);
+        arm_biquad_cascade_df1_f32(&biquad_lowpass1, float_buffer_L, float_buffer_L, BUF_N_DF);
 
         //===  Alternate AM detection - not quite as good as AlphaBetaMag AFP 10-30-22 ===
-        /*   for (unsigned i = 0; i < FFT_length / 2; i++) { //
-             audiotmp = sqrtf(iFFT_buffer[FFT_length + (i * 2)] * iFFT_buffer[FFT_length + (i * 2)]
-                              + iFFT_buffer[FFT_length + (i * 2) + 1] * iFFT_buffer[FFT_length + (i * 2) + 1]);
+        /*   for (unsigned i = 0; i < BUF_N_DF; i++) { //
+             audiotmp = sqrtf(rxFilteredIQ[i * 2] * rxFilteredIQ[i * 2]
+                              + rxFilteredIQ[i * 2 + 1] * rxFilteredIQ[i * 2 + 1]);
              // DC removal filter -------
              w = audiotmp + wold * 0.9999f; // yes, I want a superb bass response ;-)
              float_buffer_L[i] = w - wold;
 
              wold = w;
            }
-           arm_biquad_cascade_df1_f32 (&biquad_lowpass1, float_buffer_L, float_buffer_R, FFT_length / 2);
-           arm_copy_f32(float_buffer_R, float_buffer_L, FFT_length / 2);*/
+           arm_biquad_cascade_df1_f32 (&biquad_lowpass1, float_buffer_L, float_buffer_R, BUF_N_DF);
+           arm_copy_f32(float_buffer_R, float_buffer_L, BUF_N_DF);*/
         //  ===========================
         break;
       case DEMOD_SAM:  //AFP 11-03-22
         AMDecodeSAM();
         break;
+      case DEMOD_IQ:
+        DecodeIQ();
+        break;
     }
+    PROFILE_MARK(PROF_RX_DEMOD, profileMark);
     // == AFP 10-30-22
 
-    //============================  Receive EQ  ========================  AFP 08-08-22
-    if (receiveEQFlag == ON) {
-      DoReceiveEQ();
-      arm_copy_f32(float_buffer_L, float_buffer_R, FFT_length / 2);
-    }
-    //============================ End Receive EQ
+    // The receive EQ is folded into FIR_filter_mask, see ApplyReceiveEQToMask()
 
 
     /**********************************************************************************
       Noise Reduction
-      3 algorithms working 3-15-22
+      3 algorithms working 3-15-22, and a 4th that runs in the receive FFT
       NR_Kim
       Spectral NR
       LMS variable leak NR
        **********************************************************************************/
-    switch (NR_Index) {
+    switch (stereoAudio ? 0 : NR_Index) {
       case 0:  // NR Off
         break;
       case 1:  // Kim NR
-        Kim1_NR();
-        arm_scale_f32(float_buffer_L, 30, float_buffer_L, FFT_length / 2);
-        arm_scale_f32(float_buffer_R, 30, float_buffer_R, FFT_length / 2);
+        RunFramedStage(&rxNRFrames, Kim1_NR, NR_FFT_L / 2, float_buffer_L, BUF_N_DF);
+        arm_scale_f32(float_buffer_L, 30, float_buffer_L, BUF_N_DF);
         break;
       case 2:  // Spectral NR
-        SpectralNoiseReduction();
+        RunFramedStage(&rxNRFrames, SpectralNoiseReduction, NR_FFT_L / 2, float_buffer_L, BUF_N_DF);
         break;
       case 3:  // LMS NR
         ANR_notch = 0;
         Xanr();
-        arm_scale_f32(float_buffer_L, 1.5, float_buffer_L, FFT_length / 2);
-        arm_scale_f32(float_buffer_R, 2, float_buffer_R, FFT_length / 2);
+        arm_scale_f32(float_buffer_L, 2, float_buffer_L, BUF_N_DF);
+        break;
+      case 4:  // Spectral NR in the receive FFT, done by FFTNoiseReduction() before the inverse FFT
+        if (!fftBinStages) {  // Unless the FFT is too large for its tables: then the audio spectral NR
+          RunFramedStage(&rxNRFrames, SpectralNoiseReduction, NR_FFT_L / 2, float_buffer_L, BUF_N_DF);
+        }
         break;
     }
+    if (NR_Index != 0 && NR_Index != 4 && !stereoAudio) {
+      PROFILE_MARK(PROF_RX_NR, profileMark);
+    }
     //==================  End NR ============================
-    // ===========================Automatic Notch ==================
-    if (ANR_notchOn == 1) {
+    // The automatic notch works on the receive FFT bins, see FFTAutoNotch() above.  The small FFTs of
+    // the low latency modes are too coarse for that, and the large ones too fine for its tables, so
+    // there it is the LMS notch on the audio.
+    if (ANR_notchOn == 1 && !stereoAudio && (!fftBinStages || FFT_length < RX_FFT_NOTCH_MIN_LENGTH)) {
       ANR_notch = 1;
       Xanr();
-      arm_copy_f32(float_buffer_R, float_buffer_L, FFT_length / 2);  //AFP 10-21-22
+      PROFILE_MARK(PROF_RX_NOTCH, profileMark);
     }
-    // ====================End notch =================================
     /**********************************************************************************
       EXPERIMENTAL: noise blanker
       by Michael Wild
       **********************************************************************************/
 
     //=============================================================
-    if (NB_on != 0) {
-
-      NoiseBlanker(float_buffer_L, float_buffer_R);
-      arm_copy_f32(float_buffer_R, float_buffer_L, FFT_length / 2);
+    if (NB_on != 0 && !stereoAudio) {
+      RunFramedStage(&rxNBFrames, NoiseBlankerFrame, NB_FFT_SIZE, float_buffer_L, BUF_N_DF);
+      PROFILE_MARK(PROF_RX_NB, profileMark);
     }
 
 
-    if (T41State == CW_RECEIVE) {
+    if (T41State == CW_RECEIVE && !stereoAudio) {
       DoCWReceiveProcessing();  //AFP 09-19-22
 
       // ----------------------  CW Narrow band filters  AFP 10-18-22 -------------------------
-      if (CWFilterIndex != 5) {
-        switch (CWFilterIndex) {
-          case 0:                                                                                           // 0.8 KHz
-            arm_biquad_cascade_df2T_f32(&S1_CW_AudioFilter1, float_buffer_L, float_buffer_L_AudioCW, 256);  //AFP 10-18-22
-            arm_copy_f32(float_buffer_L_AudioCW, float_buffer_L, FFT_length / 2);                           //AFP 10-18-22
-            arm_copy_f32(float_buffer_L_AudioCW, float_buffer_R, FFT_length / 2);
-            break;
-          case 1:                                                                                           // 1.0 KHz
-            arm_biquad_cascade_df2T_f32(&S1_CW_AudioFilter2, float_buffer_L, float_buffer_L_AudioCW, 256);  //AFP 10-18-22
-            arm_copy_f32(float_buffer_L_AudioCW, float_buffer_L, FFT_length / 2);                           //AFP 10-18-22
-            arm_copy_f32(float_buffer_L_AudioCW, float_buffer_R, FFT_length / 2);
-            break;
-          case 2:                                                                                           // 1.3 KHz
-            arm_biquad_cascade_df2T_f32(&S1_CW_AudioFilter3, float_buffer_L, float_buffer_L_AudioCW, 256);  //AFP 10-18-22
-            arm_copy_f32(float_buffer_L_AudioCW, float_buffer_L, FFT_length / 2);                           //AFP 10-18-22
-            arm_copy_f32(float_buffer_L_AudioCW, float_buffer_R, FFT_length / 2);
-            break;
-          case 3:                                                                                           // 1.8 KHz
-            arm_biquad_cascade_df2T_f32(&S1_CW_AudioFilter4, float_buffer_L, float_buffer_L_AudioCW, 256);  //AFP 10-18-22
-            arm_copy_f32(float_buffer_L_AudioCW, float_buffer_L, FFT_length / 2);                           //AFP 10-18-22
-            arm_copy_f32(float_buffer_L_AudioCW, float_buffer_R, FFT_length / 2);
-            break;
-          case 4:                                                                                           // 2.0 KHz
-            arm_biquad_cascade_df2T_f32(&S1_CW_AudioFilter5, float_buffer_L, float_buffer_L_AudioCW, 256);  //AFP 10-18-22
-            arm_copy_f32(float_buffer_L_AudioCW, float_buffer_L, FFT_length / 2);                           //AFP 10-18-22
-            arm_copy_f32(float_buffer_L_AudioCW, float_buffer_R, FFT_length / 2);
-            break;
-          case 5:  //Off
-            break;
-        }
+      arm_biquad_cascade_df2T_instance_f32 *CWAudioFilter = NULL;
+      switch (CWFilterIndex) {
+        case 0:  // 0.8 KHz
+          CWAudioFilter = &S1_CW_AudioFilter1;
+          break;
+        case 1:  // 1.0 KHz
+          CWAudioFilter = &S1_CW_AudioFilter2;
+          break;
+        case 2:  // 1.3 KHz
+          CWAudioFilter = &S1_CW_AudioFilter3;
+          break;
+        case 3:  // 1.8 KHz
+          CWAudioFilter = &S1_CW_AudioFilter4;
+          break;
+        case 4:  // 2.0 KHz
+          CWAudioFilter = &S1_CW_AudioFilter5;
+          break;
+        case 5:  //Off
+          break;
+      }
+      if (CWAudioFilter != NULL) {
+        arm_biquad_cascade_df2T_f32(CWAudioFilter, float_buffer_L, float_buffer_L, BUF_N_DF);  //AFP 10-18-22
       }
+      PROFILE_MARK(PROF_RX_CW, profileMark);
     }
     //=========================  AFP 10-18-22 ===================
 
 
     // ======================================Interpolation  ================
 
-    arm_fir_interpolate_f32(&FIR_int1_I, float_buffer_L, iFFT_buffer, BUFFER_SIZE * N_BLOCKS / (uint32_t)(DF));  // Interpolatikon
-    arm_fir_interpolate_f32(&FIR_int1_Q, float_buffer_R, FFT_buffer, BUFFER_SIZE * N_BLOCKS / (uint32_t)(DF));
-
-    // interpolation-by-4
-    arm_fir_interpolate_f32(&FIR_int2_I, iFFT_buffer, float_buffer_L, BUFFER_SIZE * N_BLOCKS / (uint32_t)(DF1));
-    arm_fir_interpolate_f32(&FIR_int2_Q, FFT_buffer, float_buffer_R, BUFFER_SIZE * N_BLOCKS / (uint32_t)(DF1));
+    RxInterpolate(float_buffer_L, float_buffer_R, stereoAudio);
+    PROFILE_MARK(PROF_RX_INTERPOLATE, profileMark);
 
     /**********************************************************************************  AFP 12-31-20
       Digital Volume Control
@@ -673,12 +819,12 @@ void ProcessIQData() {
 
 
 
-    if (mute == 1) {
-      arm_scale_f32(float_buffer_L, 0.0, float_buffer_L, BUFFER_SIZE * N_BLOCKS);
-      arm_scale_f32(float_buffer_R, 0.0, float_buffer_R, BUFFER_SIZE * N_BLOCKS);
-    } else if (mute == 0) {
-      arm_scale_f32(float_buffer_L, DF * VolumeToAmplification(audioVolume), float_buffer_L, BUFFER_SIZE * N_BLOCKS);
-      arm_scale_f32(float_buffer_R, DF * VolumeToAmplification(audioVolume), float_buffer_R, BUFFER_SIZE * N_BLOCKS);
+    if (mute == 1 || mute == 0) {
+      float32_t audioGain = (mute == 1) ? 0.0 : DF * VolumeToAmplification(audioVolume);
+      arm_scale_f32(float_buffer_L, audioGain, float_buffer_L, BUFFER_SIZE * N_BLOCKS);
+      if (stereoAudio) {
+        arm_scale_f32(float_buffer_R, audioGain, float_buffer_R, BUFFER_SIZE * N_BLOCKS);
+      }
     }
     /**********************************************************************************  AFP 12-31-20
       CONVERT TO INTEGER AND PLAY AUDIO
@@ -688,7 +834,11 @@ void ProcessIQData() {
       sp_L1 = Q_out_L.getBuffer();
       sp_R1 = Q_out_R.getBuffer();
       arm_float_to_q15(&float_buffer_L[BUFFER_SIZE * i], sp_L1, BUFFER_SIZE);
-      arm_float_to_q15(&float_buffer_R[BUFFER_SIZE * i], sp_R1, BUFFER_SIZE);
+      if (stereoAudio) {
+        arm_float_to_q15(&float_buffer_R[BUFFER_SIZE * i], sp_R1, BUFFER_SIZE);
+      } else {
+        arm_copy_q15(sp_L1, sp_R1, BUFFER_SIZE);  // Mono: same audio in both ears
+      }
       Q_out_L.playBuffer();  // play it !
       Q_out_R.playBuffer();  // play it !
     }
@@ -696,6 +846,9 @@ void ProcessIQData() {
     if (auto_codec_gain == 1) {
       Codec_gain();
     }
+    PROFILE_MARK(PROF_RX_OUTPUT, profileMark);
+    PROFILE_MARK(PROF_RX_TOTAL, profileTotal);
+    PROFILE_MARK(PROF_RX_LATENCY, profileLatency);
     elapsed_micros_sum = elapsed_micros_sum + usec;
     elapsed_micros_idx_t++;
     // end of if(audio blocks available)
@@ -706,6 +859,46 @@ void ProcessIQData() {
     DisplayClock();
   }
 }
+
+/*****
+  Purpose: Runs ProcessIQData() until fewer than N_BLOCKS + 1 blocks are queued, so a backlog built up
+           while the display was busy is worked off at once instead of overflowing the queues (the n_clear
+           path in ProcessIQData()).
+
+           Once the spectrum FFT has published a frame, display data are no longer computed until
+           ShowSpectrum() has taken its snapshot and asks for the next one.
+
+  Parameter list:
+    void
+
+  Return value:
+    void
+*****/
+void DrainReceiveAudio() {
+  do {
+    ProcessIQData();
+    if (spectrumFrameReady == 1) {
+      updateDisplayFlag = 0;
+    }
+  } while ((uint32_t)Q_in_L.available() > N_BLOCKS && (uint32_t)Q_in_R.available() > N_BLOCKS);
+}
+
+/*****
+  Purpose: Receive scheduler.  Drains the queued audio, reading the filter and tuning encoders on either
+           side so knob changes reach the audio with the least delay.  Called by ShowSpectrum() between
+           drawing steps.
+
+  Parameter list:
+    void
+
+  Return value:
+    void
+*****/
+void ServiceReceiveDSP() {
+  FilterSetSSB();
+  DrainReceiveAudio();
+  EncoderCenterTune();
+}
 /*====
   Purpose: Auto Tune calibrate the receive IQ
 
@@ -0,0 +1,221 @@
+#ifndef BEENHERE
+#include "SDT.h"
+#endif
+
+#if defined(DSP_PROFILER)
+/*****
+  Per-stage timing of ProcessIQData() and ExciterIQData().
+
+  Each stage is timed with the ARM DWT cycle counter (on the host build the shim backs ARM_DWT_CYCCNT
+  with std::chrono, so the numbers are host cycles at a nominal 528MHz).  For every stage we keep the
+  call count, min, max and sum in cycles, plus a log histogram with 4 bins per octave from 2^6 to 2^26
+  cycles (0.12us to 127ms at 528MHz) so the 99th percentile can be reported without storing samples.
+*****/
+#define PROFILE_OCTAVE_FIRST 6
+#define PROFILE_OCTAVES 20
+#define PROFILE_BINS_PER_OCTAVE 4
+#define PROFILE_BINS (PROFILE_OCTAVES * PROFILE_BINS_PER_OCTAVE)
+
+static const char *const profileStageNames[PROF_STAGE_COUNT] = {
+  "rx front end",
+  "rx tune ui",
+  "rx cal ui",
+  "rx spectrum",
+  "rx zoom fft",
+  "rx rf nb",
+  "rx nco",
+  "rx decimate",
+  "rx skimmer",
+  "rx fft",
+  "rx audio spec",
+  "rx ifft",
+  "rx agc",
+  "rx demod",
+  "rx nr",
+  "rx notch",
+  "rx nb",
+  "rx cw",
+  "rx interp",
+  "rx output",
+  "rx total",
+  "tx q15->float",
+  "tx decimate",
+  "tx level",
+  "tx ssb mod",
+  "tx iq corr",
+  "tx interp",
+  "tx output",
+  "tx total",
+  "rx latency"
+};
+
+DMAMEM uint32_t profileCount[PROF_STAGE_COUNT];
+DMAMEM uint32_t profileMin[PROF_STAGE_COUNT];
+DMAMEM uint32_t profileMax[PROF_STAGE_COUNT];
+DMAMEM uint64_t profileSum[PROF_STAGE_COUNT];
+DMAMEM uint32_t profileHistogram[PROF_STAGE_COUNT][PROFILE_BINS];
+
+/*****
+  Purpose: Map a cycle count to its log histogram bin
+
+  Parameter list:
+    uint32_t cycles         elapsed cycles
+
+  Return value:
+    int                     bin index, 0 to PROFILE_BINS - 1
+*****/
+static inline int ProfileBin(uint32_t cycles) {
+  if (cycles < (1UL << PROFILE_OCTAVE_FIRST)) return 0;
+  int msb = 31 - __builtin_clz(cycles);
+  int bin = (msb - PROFILE_OCTAVE_FIRST) * PROFILE_BINS_PER_OCTAVE + (int)((cycles >> (msb - 2)) & 3);
+  return bin < PROFILE_BINS ? bin : PROFILE_BINS - 1;
+}
+
+/*****
+  Purpose: Upper edge of a histogram bin, in cycles
+
+  Parameter list:
+    int bin                 bin index
+
+  Return value:
+    uint32_t                largest cycle count that falls in the bin
+*****/
+static uint32_t ProfileBinUpperEdge(int bin) {
+  int msb = bin / PROFILE_BINS_PER_OCTAVE + PROFILE_OCTAVE_FIRST;
+  int sub = bin % PROFILE_BINS_PER_OCTAVE;
+  return ((uint32_t)(5 + sub) << (msb - 2)) - 1;
+}
+
+/*****
+  Purpose: Clear all stage statistics
+
+  Parameter list:
+    void
+
+  Return value:
+    void
+*****/
+void ProfilerReset() {
+  memset(profileCount, 0, sizeof(profileCount));
+  memset(profileMax, 0, sizeof(profileMax));
+  memset(profileSum, 0, sizeof(profileSum));
+  memset(profileHistogram, 0, sizeof(profileHistogram));
+  for (int i = 0; i < PROF_STAGE_COUNT; i++) {
+    profileMin[i] = 0xFFFFFFFF;
+  }
+}
+
+/*****
+  Purpose: Make sure the DWT cycle counter is running and clear the statistics.  DMAMEM is not
+           zeroed at startup, so this must be called from setup() before the first block is timed.
+
+  Parameter list:
+    void
+
+  Return value:
+    void
+*****/
+void ProfilerInit() {
+  ARM_DEMCR |= ARM_DEMCR_TRCENA;
+  ARM_DWT_CTRL |= ARM_DWT_CTRL_CYCCNTENA;
+  ProfilerReset();
+}
+
+/*****
+  Purpose: Record the cycles spent since mark against a stage and restart the mark.  Called through the
+           PROFILE_MARK() macro so the instrumentation compiles away without DSP_PROFILER.
+
+  Parameter list:
+    int stage               ProfileStage being closed
+    uint32_t &mark          cycle count when the stage started; set to now on return
+
+  Return value:
+    void
+*****/
+void ProfileRecord(int stage, uint32_t &mark) {
+  uint32_t now = ARM_DWT_CYCCNT;
+  uint32_t cycles = now - mark;  // Unsigned difference survives counter wrap
+  mark = now;
+
+  profileCount[stage]++;
+  profileSum[stage] += cycles;
+  if (cycles < profileMin[stage]) profileMin[stage] = cycles;
+  if (cycles > profileMax[stage]) profileMax[stage] = cycles;
+  profileHistogram[stage][ProfileBin(cycles)]++;
+}
+
+/*****
+  Purpose: Summarize one stage in microseconds
+
+  Parameter list:
+    int stage               ProfileStage to summarize
+    struct profileSummary *summary    filled with the stage name, count and min/mean/p99/max in us
+
+  Return value:
+    int                     0 if stage is out of range, 1 otherwise
+*****/
+int ProfilerGetStage(int stage, struct profileSummary *summary) {
+  if (stage < 0 || stage >= PROF_STAGE_COUNT) return 0;
+
+  float32_t cyclesPerMicro = (float32_t)F_CPU_ACTUAL / 1000000.0;
+  uint32_t count = profileCount[stage];
+  summary->name = profileStageNames[stage];
+  summary->count = count;
+  if (count == 0) {
+    summary->minUs = summary->meanUs = summary->p99Us = summary->maxUs = 0.0;
+    return 1;
+  }
+  // p99 is the upper edge of the bin holding the 99th percentile, never more than the true max
+  uint32_t target = count - count / 100;
+  uint32_t seen = 0;
+  uint32_t p99 = profileMax[stage];
+  for (int bin = 0; bin < PROFILE_BINS; bin++) {
+    seen += profileHistogram[stage][bin];
+    if (seen >= target) {
+      p99 = ProfileBinUpperEdge(bin);
+      break;
+    }
+  }
+  if (p99 > profileMax[stage]) p99 = profileMax[stage];
+  summary->minUs = (float32_t)profileMin[stage] / cyclesPerMicro;
+  summary->meanUs = (float32_t)((double)profileSum[stage] / count) / cyclesPerMicro;
+  summary->p99Us = (float32_t)p99 / cyclesPerMicro;
+  summary->maxUs = (float32_t)profileMax[stage] / cyclesPerMicro;
+  return 1;
+}
+
+/*****
+  Purpose: Print a table of every stage that has run, with its share of the block time budget
+
+  Parameter list:
+    Print &out              where to write the table, usually Serial
+
+  Return value:
+    void
+*****/
+void ProfilerReport(Print &out) {
+  struct profileSummary s;
+  float32_t rxBudgetUs = 1000000.0 * BUFFER_SIZE * N_BLOCKS / SR[SampleRate].rate;
+  float32_t txBudgetUs = 1000000.0 * BUFFER_SIZE * N_B_EX / SR[SampleRate].rate;
+
+  out.printf("DSP profile (us)      count      min     mean      p99      max  %%budget\n");
+  for (int i = 0; i < PROF_STAGE_COUNT; i++) {
+    ProfilerGetStage(i, &s);
+    if (s.count == 0 || i == PROF_RX_LATENCY) continue;
+    float32_t budgetUs = i <= PROF_RX_TOTAL ? rxBudgetUs : txBudgetUs;
+    out.printf("%-15s %11lu %8.1f %8.1f %8.1f %8.1f %8.1f\n", s.name, (unsigned long)s.count,
+               s.minUs, s.meanUs, s.p99Us, s.maxUs, 100.0 * s.meanUs / budgetUs);
+  }
+
+  // Receive latency: the measured part is from the oldest sample of a block reaching the input queue
+  // to its audio being queued.  The filters delay the signal further by their group delay, and the
+  // audio library holds about two more 128 sample blocks before the codec plays them.
+  ProfilerGetStage(PROF_RX_LATENCY, &s);
+  if (s.count == 0) return;
+  float32_t filterMs = RxFilterDelayMs();
+  out.printf("rx latency (ms), block %lu samples: queue + processing mean %.2f p99 %.2f max %.2f, "
+             "filters %.2f, total mean %.2f\n",
+             (unsigned long)(BUFFER_SIZE * N_BLOCKS), s.meanUs / 1000.0, s.p99Us / 1000.0, s.maxUs / 1000.0,
+             filterMs, s.meanUs / 1000.0 + filterMs);
+}
+#endif  // DSP_PROFILER
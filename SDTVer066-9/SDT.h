@@ -206,6 +206,8 @@ extern struct maps myMapFiles[];
 #define AUDIO_SPECTRUM_BOTTOM SPECTRUM_BOTTOM
 #define MAX_WATERFALL_WIDTH 512  // Pixel width of waterfall
 #define MAX_WATERFALL_ROWS 170   // Waterfall rows
+#define NCO_SEGMENT 64  // Samples between exact re-anchoring of the receive NCO in NCOMix()
+#define SPECTRUM_SLICE_COLUMNS 64  // Spectrum columns ShowSpectrum() draws per call before returning to loop()
 
 #define WATERFALL_RIGHT_X (WATERFALL_LEFT_X + MAX_WATERFALL_WIDTH)    // 3 + 512
 #define WATERFALL_TOP_Y (SPECTRUM_TOP_Y + SPECTRUM_HEIGHT + 5)        // 130 + 120 + 5 = 255
@@ -287,10 +289,16 @@ extern struct maps myMapFiles[];
 
 #define SAM_PLL_HILBERT_STAGES 7              // AFP 11-02-22
 #define OUT_IDX (3 * SAM_PLL_HILBERT_STAGES)  // AFP 11-02-22
+#define SAM_DSB 0                             // samSideband: both sidebands, or only the lower or upper one
+#define SAM_LSB 1
+#define SAM_USB 2
 #define MAX_DECODE_CHARS 32                   // Max chars that can appear on decoder line.  Increased to 32.  KF5N October 29, 2023
 #define DECODER_BUFFER_SIZE 128               // Max chars in binary search string with , . ?
 #define DECODER_CAP_VALUE 6.0
 #define DITLENGTH_DELTA 5  // Number of milliseconds to change ditLEngth with encoder
+#define CW_DECODE_TONE_HZ 750.0  // Centre of the decoder's tone detector
+#define CW_DECODE_SAMPLE_RATE 24000  // The decoder sees the audio after decimation
+#define CW_TONE_THRESHOLD 0.02   // Tone amplitude for key down, where correlation times Goertzel passed 50
 #define HISTOGRAM_ELEMENTS 750
 #define LOWEST_ATOM_TIME 20                                   // 60WPM has an atom of 20ms
 #define HIGHEST_ATOM_TIME 240                                 // 5WPM has an atom of 240ms
@@ -325,7 +333,16 @@ extern struct maps myMapFiles[];
 #define ENCODER_DELAY 100L  // Menu options scroll too fast!
 
 //--------------------- decoding stuff
-#define FFT_LENGTH 512
+#define FFT_LENGTH 512     // Standard receive convolution; FFT_length is smaller in the low latency modes
+#define RX_LATENCY_NORMAL 0  // Receive block sizes, see SetRxLatencyMode()
+#define RX_LATENCY_LOW 1
+#define RX_LATENCY_LOWEST 2
+#define RX_CONV_MAX_LENGTH 2048  // Largest receive convolution FFT, see SetRxConvolution()
+#define RX_CONV_MAX_TAPS (RX_CONV_MAX_LENGTH / 4 + 1)
+#define RX_CONV_STANDARD 0  // Receive convolution sizes, see SetRxConvMode()
+#define RX_CONV_EFFICIENT 1
+#define RX_CONV_SHARP 2
+#define FILTER_MASK_CACHE_SIZE 8  // Receive filter masks of FFT_LENGTH complex bins kept, see InitFilterMask()
 #define NOISE_SAMPLE_SIZE 500
 #define SD_MULTIPLIER 3
 #define NOISE_MULTIPLIER 0.5   // Signal must be this many time greater than the noise floor
@@ -811,7 +828,6 @@ extern float32_t audioMaxSquaredAve;
 extern float32_t corrResult;      //AFP 02-02-22
 extern uint32_t corrResultIndex;  //AFP 02-02-22
 
-extern float32_t sinBuffer[];  //AFP 02-02-22
 extern float32_t sinBuffer2[];
 extern float32_t sinBuffer3[];
 extern float32_t sinBuffer4[];  // AFP 01-31-25
@@ -826,7 +842,6 @@ extern float32_t cosBuffer6[];
 
 
 extern float32_t float_Corr_Buffer[];  //AFP 02-02-22
-extern float32_t aveCorrResult;        //AFP 02-02-22
 extern float32_t magFFTResults[];
 extern long tempSigTime;
 extern int audioTempPrevious;
@@ -839,26 +854,14 @@ extern float sigDuration;
 extern float gapStartData;
 extern float gapDurationData;
 extern int audioValuePrevious;
-extern float goertzelMagnitude;
 extern float min_gain_dB, max_gain_dB;  //set desired gain range
 extern float gain_dB;                   //computed desired gain value in dB
 extern boolean use_HP_filter;           //enable the software HP filter to get rid of DC?
 extern float knee_dBFS, comp_ratio, attack_sec, release_sec;
-extern float32_t corrResultR;           //AFP 02-02-22
-extern uint32_t corrResultIndexR;       //AFP 02-02-22
-extern float32_t corrResultL;           //AFP 02-02-22
-extern uint32_t corrResultIndexL;       //AFP 02-02-22
-extern float32_t aveCorrResult;         //AFP 02-02-22
-extern float32_t aveCorrResultR;        //AFP 02-06-22
-extern float32_t aveCorrResultL;        //AFP 02-06-22
-extern float32_t float_Corr_BufferR[];  //AFP 02-06-22
-extern float32_t float_Corr_BufferL[];  //AFP 02-06-22
-extern float32_t combinedCoeff;         //AFP 02-06-22
+extern float32_t cwToneLevel;
 extern int CWCoeffLevelOld;
 extern float CWLevelTimer;
 extern float CWLevelTimerOld;
-extern float32_t combinedCoeff2;
-extern float32_t combinedCoeff2Old;
 extern float swr;
 extern float Pf_W;
 extern float Pr_W;
@@ -954,7 +957,6 @@ extern float32_t coeffs12K_8K_LPF_FIR[];
 //==
 extern const uint32_t N_B_EX;
 extern float32_t recEQ_Level[];
-extern float32_t recEQ_LevelScale[];
 
 extern float32_t EQ_Band1Coeffs[];
 extern float32_t EQ_Band2Coeffs[];
@@ -971,55 +973,10 @@ extern float32_t EQ_Band12Coeffs[];
 extern float32_t EQ_Band13Coeffs[];
 extern float32_t EQ_Band14Coeffs[];
 
-//Setup for EQ filters
-extern float32_t rec_EQ_Band1_state[];
-extern float32_t rec_EQ_Band2_state[];
-extern float32_t rec_EQ_Band3_state[];
-extern float32_t rec_EQ_Band4_state[];
-extern float32_t rec_EQ_Band5_state[];
-extern float32_t rec_EQ_Band6_state[];
-extern float32_t rec_EQ_Band7_state[];
-extern float32_t rec_EQ_Band8_state[];
-extern float32_t rec_EQ_Band9_state[];
-extern float32_t rec_EQ_Band10_state[];
-extern float32_t rec_EQ_Band11_state[];
-extern float32_t rec_EQ_Band12_state[];
-extern float32_t rec_EQ_Band13_state[];
-extern float32_t rec_EQ_Band14_state[];
-
-extern float32_t rec_EQ1_float_buffer_L[];
-extern float32_t rec_EQ2_float_buffer_L[];
-extern float32_t rec_EQ3_float_buffer_L[];
-extern float32_t rec_EQ4_float_buffer_L[];
-extern float32_t rec_EQ5_float_buffer_L[];
-extern float32_t rec_EQ6_float_buffer_L[];
-extern float32_t rec_EQ7_float_buffer_L[];
-extern float32_t rec_EQ8_float_buffer_L[];
-extern float32_t rec_EQ9_float_buffer_L[];
-extern float32_t rec_EQ10_float_buffer_L[];
-extern float32_t rec_EQ11_float_buffer_L[];
-extern float32_t rec_EQ12_float_buffer_L[];
-extern float32_t rec_EQ13_float_buffer_L[];
-extern float32_t rec_EQ14_float_buffer_L[];
-
 extern float32_t FIR_Hilbert_coeffs90[];
 extern float32_t FIR_Hilbert_coeffs0[];
 
 extern int NumExBlocks;
-extern float32_t EQ_Band1_state[];
-extern float32_t EQ_Band2_state[];
-extern float32_t EQ_Band3_state[];
-extern float32_t EQ_Band4_state[];
-extern float32_t EQ_Band5_state[];
-extern float32_t EQ_Band6_state[];
-extern float32_t EQ_Band7_state[];
-extern float32_t EQ_Band8_state[];
-extern float32_t EQ_Band9_state[];
-extern float32_t EQ_Band10_state[];
-extern float32_t EQ_Band11_state[];
-extern float32_t EQ_Band12_state[];
-extern float32_t EQ_Band13_state[];
-extern float32_t EQ_Band14_state[];
 
 extern float EQBand1GaindB;
 extern float EQBand2GaindB;
@@ -1051,55 +1008,10 @@ extern float EQBand12Scale;
 extern float EQBand13Scale;
 extern float EQBand14Scale;
 
-//EQ filter instances
-extern arm_biquad_cascade_df2T_instance_f32 S1_Rec;
-extern arm_biquad_cascade_df2T_instance_f32 S2_Rec;
-extern arm_biquad_cascade_df2T_instance_f32 S3_Rec;
-extern arm_biquad_cascade_df2T_instance_f32 S4_Rec;
-extern arm_biquad_cascade_df2T_instance_f32 S5_Rec;
-extern arm_biquad_cascade_df2T_instance_f32 S6_Rec;
-extern arm_biquad_cascade_df2T_instance_f32 S7_Rec;
-extern arm_biquad_cascade_df2T_instance_f32 S8_Rec;
-extern arm_biquad_cascade_df2T_instance_f32 S9_Rec;
-extern arm_biquad_cascade_df2T_instance_f32 S10_Rec;
-extern arm_biquad_cascade_df2T_instance_f32 S11_Rec;
-extern arm_biquad_cascade_df2T_instance_f32 S12_Rec;
-extern arm_biquad_cascade_df2T_instance_f32 S13_Rec;
-extern arm_biquad_cascade_df2T_instance_f32 S14_Rec;
-
 // ================= start  AFP 10-02-22 ===========
-extern arm_biquad_cascade_df2T_instance_f32 S1_Xmt;
-extern arm_biquad_cascade_df2T_instance_f32 S2_Xmt;
-extern arm_biquad_cascade_df2T_instance_f32 S3_Xmt;
-extern arm_biquad_cascade_df2T_instance_f32 S4_Xmt;
-extern arm_biquad_cascade_df2T_instance_f32 S5_Xmt;
-extern arm_biquad_cascade_df2T_instance_f32 S6_Xmt;
-extern arm_biquad_cascade_df2T_instance_f32 S7_Xmt;
-extern arm_biquad_cascade_df2T_instance_f32 S8_Xmt;
-extern arm_biquad_cascade_df2T_instance_f32 S9_Xmt;
-extern arm_biquad_cascade_df2T_instance_f32 S10_Xmt;
-extern arm_biquad_cascade_df2T_instance_f32 S11_Xmt;
-extern arm_biquad_cascade_df2T_instance_f32 S12_Xmt;
-extern arm_biquad_cascade_df2T_instance_f32 S13_Xmt;
-extern arm_biquad_cascade_df2T_instance_f32 S14_Xmt;
 
 extern float32_t xmtEQ_Level[];
 
-extern float32_t xmt_EQ1_float_buffer_L[];
-extern float32_t xmt_EQ2_float_buffer_L[];
-extern float32_t xmt_EQ3_float_buffer_L[];
-extern float32_t xmt_EQ4_float_buffer_L[];
-extern float32_t xmt_EQ5_float_buffer_L[];
-extern float32_t xmt_EQ6_float_buffer_L[];
-extern float32_t xmt_EQ7_float_buffer_L[];
-extern float32_t xmt_EQ8_float_buffer_L[];
-extern float32_t xmt_EQ9_float_buffer_L[];
-extern float32_t xmt_EQ10_float_buffer_L[];
-extern float32_t xmt_EQ11_float_buffer_L[];
-extern float32_t xmt_EQ12_float_buffer_L[];
-extern float32_t xmt_EQ13_float_buffer_L[];
-extern float32_t xmt_EQ14_float_buffer_L[];
-
 // ================= end  AFP 10-02-22 ===========
 
 extern arm_biquad_cascade_df2T_instance_f32 S1_EXcite;
@@ -1138,30 +1050,18 @@ extern float32_t float_buffer_L13_EX[];
 extern float32_t float_buffer_L14_EX[];
 
 //Hilbert FIR Filter
-
-extern float32_t FIR_Hilbert_state_L[];
-extern float32_t FIR_Hilbert_state_R[];
-
 extern float32_t FIR_Hilbert_coeffs_45[];     //AFP 01-16-22
 extern float32_t FIR_Hilbert_coeffs_neg_45[];  //AFP 01-16-22
 
-
-extern arm_fir_instance_f32 FIR_Hilbert_L;
-extern arm_fir_instance_f32 FIR_Hilbert_R;
-
 extern float32_t CW_Filter_Coeffs2[];        //AFP 10-25-22
 extern arm_fir_instance_f32 FIR_CW_DecodeL;  //AFP 10-25-22
-extern arm_fir_instance_f32 FIR_CW_DecodeR;  //AFP 10-25-22
 extern float32_t FIR_CW_DecodeL_state[];     //AFP 10-25-22
-extern float32_t FIR_CW_DecodeR_state[];     //AFP 10-25-22
 
 extern arm_fir_decimate_instance_f32 FIR_dec1_EX_I;
 extern arm_fir_decimate_instance_f32 FIR_dec1_EX_Q;
 extern arm_fir_decimate_instance_f32 FIR_dec2_EX_I;
 extern arm_fir_decimate_instance_f32 FIR_dec2_EX_Q;
 //==
-extern arm_fir_decimate_instance_f32 FIR_dec3_EX_I;
-extern arm_fir_decimate_instance_f32 FIR_dec3_EX_Q;
 //==
 
 extern arm_fir_interpolate_instance_f32 FIR_int1_EX_I;
@@ -1169,8 +1069,6 @@ extern arm_fir_interpolate_instance_f32 FIR_int1_EX_Q;
 extern arm_fir_interpolate_instance_f32 FIR_int2_EX_I;
 extern arm_fir_interpolate_instance_f32 FIR_int2_EX_Q;
 //==
-extern arm_fir_interpolate_instance_f32 FIR_int3_EX_I;
-extern arm_fir_interpolate_instance_f32 FIR_int3_EX_Q;
 //==
 extern float32_t FIR_dec1_EX_I_state[];  //48 + (uint16_t) BUFFER_SIZE * (uint32_t) N_B - 1
 extern float32_t FIR_dec1_EX_Q_state[];
@@ -1180,16 +1078,12 @@ extern float32_t FIR_dec2_EX_I_state[];  //DEC2STATESIZE
 //extern float32_t  FIR_dec2_EX_coeffs[];
 extern float32_t FIR_dec2_EX_Q_state[];
 //==
-extern float32_t FIR_dec3_EX_I_state[];
-extern float32_t FIR_dec3_EX_Q_state[];
 //==
 extern float32_t FIR_int2_EX_I_state[];
 extern float32_t FIR_int2_EX_Q_state[];
 extern float32_t FIR_int1_EX_coeffs[];
 extern float32_t FIR_int2_EX_coeffs[];
 //==
-extern float32_t FIR_int3_EX_I_state[];
-extern float32_t FIR_int3_EX_Q_state[];
 //==
 extern float32_t FIR_int1_EX_I_state[];
 extern float32_t FIR_int1_EX_Q_state[];
@@ -1210,6 +1104,7 @@ extern long NCOFreq;  // AFP 04-16-22
 extern long stepFineTune;
 extern long stepFineTune2;
 extern float32_t NCO_INC;  // AFP 04-16-22
+extern uint32_t ncoPhase;
 extern double OSC_COS;
 extern double OSC_SIN;
 extern double Osc_Vect_Q;
@@ -1370,6 +1265,9 @@ extern struct config_t {
   int receiveEQFlag = 0;
   int xmitEQFlag = 0;
   int CWToneIndex = 0;
+  int NB_RF_on = 0;  // Impulse blanker on the wideband I/Q
+  int rxLatencyMode = 0;  // Receive block size, RX_LATENCY_xxx
+  int rxConvMode = 0;     // Receive convolution FFT and filter length, RX_CONV_xxx
   
   float32_t TransmitPowerLevelCW = 0.0;  // Power level factors by mode
   float32_t TransmitPowerLevelSSB = 0.0;
@@ -1407,10 +1305,6 @@ extern arm_biquad_casd_df1_inst_f32 biquad_lowpass1;
 extern arm_biquad_casd_df1_inst_f32 IIR_biquad_Zoom_FFT_I;
 extern arm_biquad_casd_df1_inst_f32 IIR_biquad_Zoom_FFT_Q;
 
-extern arm_fir_decimate_instance_f32 FIR_dec1_I;
-extern arm_fir_decimate_instance_f32 FIR_dec1_Q;
-extern arm_fir_decimate_instance_f32 FIR_dec2_I;
-extern arm_fir_decimate_instance_f32 FIR_dec2_Q;
 extern arm_fir_decimate_instance_f32 Fir_Zoom_FFT_Decimate_I;
 extern arm_fir_decimate_instance_f32 Fir_Zoom_FFT_Decimate_Q;
 extern arm_fir_interpolate_instance_f32 FIR_int1_I;
@@ -1475,7 +1369,7 @@ extern bool timeflag;
 extern bool volumeChangeFlag;
 extern bool volumeChangeFlag2;
 extern char freqBuffer[];
-//extern char *bigMorseCodeTree;
+extern char *bigMorseCodeTree;
 extern char decodeBuffer[];
 extern const char DEGREE_SYMBOL[];
 extern char keyboardBuffer[];
@@ -1545,6 +1439,7 @@ extern uint8_t LastSampleRate;
 extern uint8_t minute10_old;
 extern uint8_t minute1_old;
 extern uint8_t NB_on;
+extern uint8_t NB_RF_on;
 extern uint8_t NB_test;
 extern uint8_t notchIndex;
 extern uint8_t notchButtonState;
@@ -1650,15 +1545,12 @@ extern int agc_slope;
 extern int agc_thresh;
 extern int ANR_buff_size;
 extern int ANR_delay;
-extern int ANR_dline_size;
-extern int ANR_in_idx;
-extern int ANR_mask;
 extern int ANR_position;
 extern int ANR_taps;
 extern int attack_buffsize;
 extern int audioVolume;
 extern int audioVolumeOld;
-extern int audioYPixel[];
+extern int16_t audioYPixel[];
 extern int bandswitchPins[];
 extern int button9State;
 extern int buttonRead;
@@ -1680,6 +1572,9 @@ extern int dcfSilenceTimer;
 extern int dcfTheSecond;
 extern int dcfPulseTime;
 extern int decoderFlag;
+extern uint8_t cwSkimmerOn;
+extern uint8_t rxLatencyMode;
+extern uint8_t rxConvMode;
 extern int demodIndex;
 extern int directFreqFlag;
 extern int EEPROMChoice;
@@ -1770,8 +1665,9 @@ extern int zoom_sample_ptr;
 extern int zoomIndex;
 extern float currentRF_OutAttenTemp;
 extern int updateDisplayFlag;
+extern int spectrumFrameReady;
+extern int displayBusy;
 extern int updateCalDisplayFlag;
-extern const int DEC2STATESIZE;
 extern const int INT1_STATE_SIZE;
 extern const int INT2_STATE_SIZE;
 extern const int myInput;
@@ -1803,6 +1699,7 @@ extern const uint32_t NR_add_counter;
 
 extern uint32_t BUF_N_DF;
 extern uint32_t FFT_length;
+extern uint32_t rxConvHop;
 //extern const uint32_t FFT_L ;
 extern int32_t gapHistogram[];
 extern uint32_t in_index;
@@ -1913,8 +1810,6 @@ extern float32_t d[3 * SAM_PLL_HILBERT_STAGES + 3];
 extern float32_t a[];
 extern float32_t abs_ring[];
 extern float32_t abs_out_sample;
-extern float32_t ai, bi, aq, bq;
-extern float32_t ai_ps, bi_ps, aq_ps, bq_ps;
 extern float32_t pll_fmax;
 extern int zeta_help;
 extern float32_t zeta;    // PLL step response: smaller, slower response 1.0 - 0.1
@@ -1925,7 +1820,6 @@ extern float32_t omega_min;
 extern float32_t omega_max;
 extern float32_t g1;
 extern float32_t g2;
-extern float32_t phzerror;
 extern float32_t det;
 extern float32_t fil_out;
 extern float32_t del_out;
@@ -1936,29 +1830,22 @@ extern float32_t tauR;  // original 0.02;
 extern float32_t tauI;  // original 1.4;
 extern float32_t dc;
 extern float32_t dc_insert;
-extern float32_t dcu;
-extern float32_t dc_insertu;
 extern float32_t mtauR;
 extern float32_t mtauI;
 extern float32_t onem_mtauR;
 extern float32_t onem_mtauI;
 extern uint8_t fade_leveler;
+extern uint8_t samSideband;
 
-extern float32_t ANR_d[];
 extern float32_t ANR_den_mult;
 extern float32_t ANR_gamma;
-extern float32_t ANR_lidx;
 extern float32_t ANR_lidx_min;
 extern float32_t ANR_lidx_max;
 extern float32_t ANR_lincr;
 extern float32_t ANR_ldecr;
-extern float32_t ANR_ngamma;
 extern float32_t ANR_two_mu;
-extern float32_t ANR_w[];
 extern float32_t attack_mult;
-extern float32_t audio;
 extern float32_t audiotmp;
-extern float32_t audiou;
 extern float32_t audioSpectBuffer[];
 extern float32_t b[];
 extern float32_t bass;
@@ -2002,12 +1889,6 @@ extern float32_t fil_out;
 extern float32_t /*DMAMEM*/ FIR_Coef_I[];
 extern float32_t /*DMAMEM*/ FIR_Coef_Q[];
 
-extern float32_t /*DMAMEM*/ FIR_dec1_I_state[];
-extern float32_t /*DMAMEM*/ FIR_dec2_I_state[];
-extern float32_t /*DMAMEM*/ FIR_dec3_I_state[];
-extern float32_t /*DMAMEM*/ FIR_dec1_Q_state[];
-extern float32_t /*DMAMEM*/ FIR_dec2_Q_state[];
-extern float32_t /*DMAMEM*/ FIR_dec3_Q_state[];
 
 extern float32_t /*DMAMEM*/ FIR_int1_I_state[];
 extern float32_t /*DMAMEM*/ FIR_int2_I_state[];
@@ -2016,14 +1897,12 @@ extern float32_t /*DMAMEM*/ FIR_int1_Q_state[];
 extern float32_t /*DMAMEM*/ FIR_int2_Q_state[];
 extern float32_t /*DMAMEM*/ FIR_int3_Q_state[];
 
-extern float32_t /*DMAMEM*/ FIR_dec1_coeffs[];
-extern float32_t /*DMAMEM*/ FIR_dec2_coeffs[];
-extern float32_t /*DMAMEM*/ FIR_dec3_coeffs[];
 extern float32_t /*DMAMEM*/ FIR_int1_coeffs[];
 extern float32_t /*DMAMEM*/ FIR_int2_coeffs[];
 extern float32_t /*DMAMEM*/ FIR_int3_coeffs[];
 
-extern float32_t /*DMAMEM*/ FIR_filter_mask[];
+extern float32_t *FIR_filter_mask;  // An entry of the filter mask cache, see InitFilterMask()
+extern float32_t *rxFilteredIQ;     // This block of the receive convolution output, in iFFT_buffer
 
 extern float32_t /*DMAMEM*/ Fir_Zoom_FFT_Decimate_I_state[];
 extern float32_t /*DMAMEM*/ Fir_Zoom_FFT_Decimate_Q_state[];
@@ -2032,7 +1911,6 @@ extern float32_t fixed_gain;
 extern float32_t float_buffer_L[];
 extern float32_t float_buffer_R[];
 extern float32_t float_buffer_L_CW[];       //AFP 09-01-22
-extern float32_t float_buffer_R_CW[];       //AFP 09-01-22
 extern float32_t float_buffer_R_AudioCW[];  //AFP 10-18-22
 extern float32_t float_buffer_L2[];
 extern float32_t float_buffer_R2[];
@@ -2074,8 +1952,7 @@ extern float32_t K_est;
 extern float32_t K_est_old;
 extern float32_t K_est_mult;
 extern float32_t last_dc_level;
-extern float32_t /*DMAMEM*/ last_sample_buffer_L[];
-extern float32_t /*DMAMEM*/ last_sample_buffer_R[];
+extern float32_t /*DMAMEM*/ last_sample_buffer[];
 extern float32_t L_BufferOffset[];
 extern float32_t LPFcoeff;
 extern float32_t LMS_errsig1[];
@@ -2136,15 +2013,11 @@ extern float32_t NR_last_sample_buffer_R[];
 extern float32_t NR_X[][3];
 extern float32_t NR_E[][15];
 extern float32_t NR_M[];
-extern float32_t NR_Nest[][2];  //
 extern float32_t NR_vk;
 extern float32_t NR_lambda[];
 extern float32_t NR_Gts[][2];
 extern float32_t NR_G[];
-extern float32_t NR_SNR_prio[];
-extern float32_t NR_SNR_post[];
 extern float32_t NR_SNR_post_pos;
-extern float32_t NR_Hk_old[];
 extern float32_t NR_VAD;
 extern float32_t NR_VAD_thresh;
 extern float32_t NR_long_tone[][2];
@@ -2154,6 +2027,7 @@ extern float32_t NR_long_tone_thresh;
 extern float32_t NR_gain_smooth_alpha;
 extern float32_t NR_temp_sum;
 extern float32_t NB_thresh;
+extern float32_t NB_RF_thresh;
 extern float32_t offsetDisplayDB;
 
 extern float32_t onemfast_backmult;
@@ -2248,8 +2122,6 @@ extern float32_t FFT_buffer[] __attribute__((aligned(4)));
 extern float32_t FFT_ring_buffer_x[];
 extern float32_t FFT_ring_buffer_y[];
 
-extern float32_t float_buffer_L_3[];
-extern float32_t float_buffer_R_3[];
 
 
 extern const float32_t atanTable[];
@@ -2290,6 +2162,7 @@ float32_t AlphaBetaMag(float32_t inphase, float32_t quadrature);
 void AltNoiseBlanking(float *insamp, int Nsam, float *E);
 void AMDemodAM();
 void AMDecodeSAM();  // AFP 11-03-22
+void ApplyReceiveEQToMask(float32_t *mask, int mode);
 void AssignEEPROMObjectToVariable();
 void autotuneRec(float *amp, float *phase, float gain_coarse_max, float gain_coarse_min,
                  float phase_coarse_max, float phase_coarse_min,
@@ -2319,7 +2192,7 @@ void ButtonNR();
 int ButtonSetNoiseFloor();
 void ButtonZoom();
 
-void CalcZoom1Magn();
+void CalcZoom1Magn(const float32_t *IQ, uint32_t blockSize);
 void CalcFIRCoeffs(float *coeffs_I, int numCoeffs, float32_t fc, float32_t Astop, int type, float dfc, float Fsamprate);
 void CalcCplxFIRCoeffs(float *coeffs_I, float *coeffs_Q, int numCoeffs, float32_t FLoCut, float32_t FHiCut, float SampleRate);
 void CalcNotchBins();
@@ -2347,7 +2220,14 @@ int CWOptions();
 void CW_DecodeLevelDisplay();
 void CW_ExciterIQData();  // AFP 08-18-22
 void CW_PA_Calibrate();
+void CWSkimmer(const float32_t *IQ, uint32_t blockSize);
+void CWSkimmerReport(Print &out);
+void CWSkimmerReset();
+void CWSkimmerShowSpots(Print &out);
+void CWToneDetector(const float32_t *in, float32_t *envelope, uint32_t blockSize);
+void CWToneDetectorInit(float32_t toneHz, float32_t sampleRate);
 void SSB_PA_Calibrate();
+void SSBModulate(float32_t *I_buffer, float32_t *Q_buffer);
 
 void printLPFState();
 void printBPFState();
@@ -2363,9 +2243,7 @@ void DisplayIncrementField();
 void Dit();
 void DoCWDecoding(int audioValue);
 void DoCWReceiveProcessing();  //AFP 09-19-22
-void DoExciterEQ();
 void DoGapHistogram(long valGap);
-void DoReceiveEQ();
 void DrawSignalPlotFrame();
 void DoSignalHistogram(long val);
 void DoSignalPlot(float val);
@@ -2374,6 +2252,7 @@ void DoSWRCal();
 void DoPaddleFlip();
 void DoXmitIQCalibrate();
 void DoReceiveCalibrate();
+void DrainReceiveAudio();
 void DrawActiveLetter(int row, int horizontalSpacer, int whichLetterIndex, int keyWidth, int keyHeight);
 void DrawBandWidthIndicatorBar();  // AFP 03-27-22 Layers
 void DrawBodePlotContainer();
@@ -2400,6 +2279,7 @@ void EncoderFineTune();
 void EncoderFilter();
 void EncoderCenterTune();
 void EncoderVolume();
+float32_t EqualizerGain(const float32_t *bandLevels, float32_t freq, float32_t sampleRate);
 int EqualizerRecOptions();
 int EqualizerXmtOptions();
 void EraseMenus();
@@ -2409,7 +2289,12 @@ void EraseSpectrumDisplayContainer();
 void EraseSpectrumWindow();
 void ExecuteButtonPress(int val);
 
+void FFTAutoNotch();
+void FFTAutoNotchReset();
+void FFTNoiseReduction();
+void FFTNoiseReductionReset();
 void FilterBandwidth();
+void FilterMaskPin(const float32_t *mask);
 void FilterOverlay();
 void FilterSetSSB();
 int FindCountry(char *prefix);
@@ -2417,10 +2302,10 @@ int ValidEEPROMData();
 int FirstTimeSDCard();
 void FormatFrequency(long f, char *b);
 int FrequencyOptions();
-void FreqShift1();
-void FreqShift2();
+void FreqShift1(const float32_t *IQ_in, float32_t *I_out, float32_t *Q_out, uint32_t blocksize);
+void FreqShift2(float32_t *IQ_buffer, uint32_t blocksize);
+void NCOMix(float32_t *IQ_buffer, uint32_t blocksize, double freqHz);
 void FreqShiftEx(long freqShiftAmt);
-float goertzel_mag(int numSamples, int TARGET_FREQUENCY, int SAMPLING_RATE, float *data);
 int GetEncoderValue(int minValue, int maxValue, int startValue, int increment, char prompt[]);
 int GetEncoderValuePower(int minValue, int maxValue, int startValue, int increment, char prompt[]);
 float GetEncoderValueCW(float minValue, float maxValue, float startValue, int increment, char prompt[]);
@@ -2447,15 +2332,20 @@ int InitializeSDCard();
 void InitializeDataArrays();
 void InitFilterMask();
 void InitLMSNoiseReduction();
+void InitRxDecimator();
+void InitSSBModulator();
 void initTempMon(uint16_t freq, uint32_t lowAlarmTemp, uint32_t highAlarmTemp, uint32_t panicAlarmTemp);
 int IQOptions();
 void IQPhaseCorrection(float32_t *I_buffer, float32_t *Q_buffer, float32_t factor, uint32_t blocksize);
 void IQXPhaseCorrection(float32_t *I_buffer, float32_t *Q_buffer, float32_t factor, uint32_t blocksize);
+void UpdateIQFrontEnd();
+void IQFrontEnd(const q15_t *I_in, const q15_t *Q_in, float32_t *IQ_out, uint32_t blocksize);
+void IQFrontEndFloat(float32_t *IQ_buffer, uint32_t blocksize);
 float32_t Izero(float32_t x);
 
 void JackClusteredArrayMax(int32_t *array, int32_t elements, int32_t *maxCount, int32_t *maxIndex, int32_t *firstDit, int32_t spread);
 
-void Kim1_NR();
+void Kim1_NR(float32_t *audio, uint32_t count);
 void KeyOn();
 void KeyRingOn();
 void KeyTipOn();
@@ -2471,6 +2361,7 @@ int ModeOptions();
 //DB2OO, 29-AUG-23: added
 void MorseCharacterClear(void);
 void MorseCharacterDisplay(char currentLetter);
+void MorseDecoderRedraw();
 void MoveBodeCursor();  // Bode
 void MoveStopFreqBode();
 void MyDelay(unsigned long millisWait);
@@ -2485,10 +2376,12 @@ int NROptions();
 //int  PostProcessorAudio();
 float PlotCalSpectrum(int x1, int cal_bins[2], int capture_bins);
 float PlotCalSpectrumFreq(int x1, int cal_bins[2], int capture_bins);
+void PrewarmFilterMasks();
 void ProcessIQDataBode();  //Bode
 int ProcessButtonPress(int valPin);
 void ProcessEqualizerChoices(int EQType, char *title);
 void ProcessIQData();
+void ServiceReceiveDSP();
 void ProcessIQData2();
 void ProcessIQDataFreq();
 uint16_t read16(File &f);
@@ -2499,7 +2392,14 @@ void RedrawDisplayScreen();
 void ResetHistograms();
 void ResetTuning();  // AFP 10-11-22
 int RFOptions();
+void RFNoiseBlanker(float32_t *IQ, uint32_t blockSize);
 void ResetZoom(int zoomIndex1);  // AFP 11-06-22
+float32_t RxConvolutionMACs();
+void RxDecimate(float32_t *IQ_out, uint32_t blockSize);
+float32_t *RxDecimatorInput();
+uint32_t RxDecimatorDelay();
+float32_t RxFilterDelayMs();
+void RxInterpolate(float32_t *audioL, float32_t *audioR, int stereo);
 
 int SampleOptions();
 void scanner();
@@ -2535,6 +2435,10 @@ void SetKeyType();
 void SetKeyPowerUp();
 void SetRF_InAtten(int attenIn);    // AFP 04-12-24
 void SetRF_OutAtten(int attenOut);  // AFP 04-12-24
+void SetRxConvMode(int mode);
+void SetRxConvolution(uint32_t fftLength, uint32_t taps);
+void SetRxFFTInstances();
+void SetRxLatencyMode(int mode);
 int SetSecondaryMenuIndex();
 void SetSidetoneVolume();  // Abandon this function if encoder-based sidetone volume works.  KF5N August 29, 2023
 void SetSideToneVolume();  // This function uses encoder to set sidetone volume.  KF5N August 29, 2023
@@ -2554,6 +2458,7 @@ void sineTone3(int numCycles);
 void sineTone6(int numCycles);
 int SpectrumOptions();
 
+void TaperFilterMask(const arm_cfft_instance_f32 *S, float32_t *mask, uint32_t fftLength, uint32_t taps);
 void TurnOffInitializingMessage();
 
 void UpdateInfoWindow();
@@ -2568,6 +2473,7 @@ void ShowMenu(const char *menu[], int where);
 void ShowMessageOnWaterfall(String message);  // G0ORX
 void ShowName();
 void ShowNotch();
+void ShowSAMCarrierOffset();
 void ShowSpectrum();
 float ShowSpectrum2();
 float ShowSpectrumFreq();
@@ -2578,8 +2484,9 @@ void BandInformation();
 float32_t sign(float32_t x);
 void sineTone(long freqSideTone);
 int SmallMenuSelection(const char *options[], int optionCount, int defaultOpion);
-void SpectralNoiseReduction(void);
+void SpectralNoiseReduction(float32_t *audio, uint32_t count);
 void SpectralNoiseReductionInit();
+void SpectrumPixels(const float32_t *power, int16_t *pixels, uint32_t count, float32_t dBScale, int16_t offset, int16_t low, int16_t high);
 void Splash();
 int SubmenuSelect(const char *options[], int numberOfChoices, int defaultStart);
 void TwoToneTest();
@@ -2622,11 +2529,79 @@ int Xmit_IQ_Cal();  //AFP 09-21-22
 
 void ZoomFFTPrep();
 void ZoomFFTPrep2();
-void ZoomFFTExe(uint32_t blockSize);
+void ZoomFFTExe(const float32_t *IQ, uint32_t blockSize);
 void ZoomFFTExeCal(uint32_t blockSize);
 void setup_cw_transmit_mode();
 void ProcessIQDataTXCal();
 
+#if defined(DSP_PROFILER)
+//====================== DSP profiler (Profiler.cpp) ===========
+enum ProfileStage {
+  PROF_RX_FRONT_END,  // q15->float, RF gains and IQ correction
+  PROF_RX_TUNE_UI,
+  PROF_RX_CAL_UI,
+  PROF_RX_SPECTRUM,
+  PROF_RX_ZOOM_FFT,
+  PROF_RX_RF_NB,
+  PROF_RX_NCO,
+  PROF_RX_DECIMATE,
+  PROF_RX_SKIMMER,
+  PROF_RX_FFT,
+  PROF_RX_AUDIO_SPECTRUM,
+  PROF_RX_IFFT,
+  PROF_RX_AGC,
+  PROF_RX_DEMOD,
+  PROF_RX_NR,
+  PROF_RX_NOTCH,
+  PROF_RX_NB,
+  PROF_RX_CW,
+  PROF_RX_INTERPOLATE,
+  PROF_RX_OUTPUT,
+  PROF_RX_TOTAL,  // Stages up to here are charged against the receive block budget
+  PROF_TX_Q15_TO_FLOAT,
+  PROF_TX_DECIMATE,
+  PROF_TX_LEVEL,
+  PROF_TX_SSB_MOD,
+  PROF_TX_IQ_CORRECTION,
+  PROF_TX_INTERPOLATE,
+  PROF_TX_OUTPUT,
+  PROF_TX_TOTAL,
+  PROF_RX_LATENCY,  // Oldest input sample to audio queued, not part of the cycle budget
+  PROF_STAGE_COUNT
+};
+
+struct profileSummary {
+  const char *name;
+  uint32_t count;
+  float32_t minUs;
+  float32_t meanUs;
+  float32_t p99Us;
+  float32_t maxUs;
+};
+
+void ProfilerInit();
+void ProfilerReset();
+void ProfileRecord(int stage, uint32_t &mark);
+int ProfilerGetStage(int stage, struct profileSummary *summary);
+void ProfilerReport(Print &out);
+
+#define PROFILE_BEGIN(mark) uint32_t mark = ARM_DWT_CYCCNT
+// Start the mark samplesAgo ADC samples in the past, for timings that include queueing
+#define PROFILE_BEGIN_AT(mark, samplesAgo) \
+  uint32_t mark = ARM_DWT_CYCCNT - (uint32_t)((float32_t)(samplesAgo) * (float32_t)F_CPU_ACTUAL / (float32_t)SR[SampleRate].rate)
+#define PROFILE_MARK(stage, mark) ProfileRecord(stage, mark)
+#else
+#define PROFILE_BEGIN(mark) \
+  do { \
+  } while (0)
+#define PROFILE_BEGIN_AT(mark, samplesAgo) \
+  do { \
+  } while (0)
+#define PROFILE_MARK(stage, mark) \
+  do { \
+  } while (0)
+#endif  // DSP_PROFILER
+
 #if defined(V12_AUDIO_DISPLAY)
 extern float32_t mic_audio_buffer[];
 void ShowTXAudio();
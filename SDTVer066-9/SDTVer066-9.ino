@@ -740,8 +740,8 @@ const char *labels[] = { "Select", "Menu Up", "Band Up",
 
 const char *secondaryChoices[][14] = {
   //=================== AFP 03-30-24 V012 Bode Plot
-  { "Power level", "Gain", "RF In Atten", "RF Out Atten", "Antenna", "100W PA", "XVTR", "Cancel" },                         //RF
-  { "WPM", "Straight Key", "Keyer", "CW Filter", "Paddle Flip", "Sidetone Note", "Sidetone Vol", "Xmit Delay", "Cancel" },  // CW             0
+  { "Power level", "Gain", "RF In Atten", "RF Out Atten", "Antenna", "100W PA", "XVTR", "Blanker", "Cancel" },                         //RF
+  { "WPM", "Straight Key", "Keyer", "CW Filter", "Paddle Flip", "Sidetone Note", "Sidetone Vol", "Xmit Delay", "Skimmer", "Rx Latency", "Cancel" },  // CW             0
 
 
   //#else
@@ -754,7 +754,7 @@ const char *secondaryChoices[][14] = {
   { "Set floor", "Cancel" },                                                                                              // Noise floor    6
   { "Set Mic Gain", "Cancel" },                                                                                           // Mic gain       7
   { "On", "Off", "Set Threshold", "Set Ratio", "Set Attack", "Set Decay", "Cancel" },                                     // Mic options    8
-  { "On", "Off", "EQRcSet", "Cancel" },                                                                                   // index = 9                                                                                // EQ Rec         9
+  { "On", "Off", "EQRcSet", "Rx Filter", "Cancel" },                                                                           // index = 9                                                                                // EQ Rec         9
   { "On", "Off", "EQTxSet", "Cancel" },                                                                                   // EQ Trx         10
 
   { "Freq Cal", "Rec IQ Cal", "Xmit IQ Cal", "SSB PA Cal", "CW PA Cal", "Two Tone Test", "R Freq Offset", "SWR Cal","Cancel" },  // Calibrate      11
@@ -776,6 +776,7 @@ int switchThreshholds[] = { 921, 873, 817,
                             127, 67, 1 };
 
 uint32_t FFT_length = FFT_LENGTH;
+uint32_t rxConvHop = FFT_LENGTH / 2;  // New samples per receive convolution FFT, a multiple of BUF_N_DF
 
 extern "C" uint32_t set_arm_clock(uint32_t frequency);
 
@@ -947,53 +948,6 @@ int currentRF_OutAtten = 0;
 const uint32_t N_B_EX = 16;
 //================== Receive EQ Variables================= AFP 08-08-22
 float32_t recEQ_Level[14];
-float32_t recEQ_LevelScale[14];
-//Setup for EQ filters
-float32_t rec_EQ1_float_buffer_L[256];
-float32_t rec_EQ2_float_buffer_L[256];
-float32_t rec_EQ3_float_buffer_L[256];
-float32_t rec_EQ4_float_buffer_L[256];
-float32_t rec_EQ5_float_buffer_L[256];
-float32_t rec_EQ6_float_buffer_L[256];
-float32_t rec_EQ7_float_buffer_L[256];
-float32_t rec_EQ8_float_buffer_L[256];
-float32_t rec_EQ9_float_buffer_L[256];
-float32_t rec_EQ10_float_buffer_L[256];
-float32_t rec_EQ11_float_buffer_L[256];
-float32_t rec_EQ12_float_buffer_L[256];
-float32_t rec_EQ13_float_buffer_L[256];
-float32_t rec_EQ14_float_buffer_L[256];
-
-float32_t rec_EQ_Band1_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };  //declare and zero biquad state variables
-float32_t rec_EQ_Band2_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t rec_EQ_Band3_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t rec_EQ_Band4_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t rec_EQ_Band5_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t rec_EQ_Band6_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t rec_EQ_Band7_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t rec_EQ_Band8_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };  //declare and zero biquad state variables
-float32_t rec_EQ_Band9_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t rec_EQ_Band10_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t rec_EQ_Band11_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t rec_EQ_Band12_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t rec_EQ_Band13_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t rec_EQ_Band14_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-
-//EQ filter instances
-arm_biquad_cascade_df2T_instance_f32 S1_Rec = { IIR_NUMSTAGES, rec_EQ_Band1_state, EQ_Band1Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S2_Rec = { IIR_NUMSTAGES, rec_EQ_Band2_state, EQ_Band2Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S3_Rec = { IIR_NUMSTAGES, rec_EQ_Band3_state, EQ_Band3Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S4_Rec = { IIR_NUMSTAGES, rec_EQ_Band4_state, EQ_Band4Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S5_Rec = { IIR_NUMSTAGES, rec_EQ_Band5_state, EQ_Band5Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S6_Rec = { IIR_NUMSTAGES, rec_EQ_Band6_state, EQ_Band6Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S7_Rec = { IIR_NUMSTAGES, rec_EQ_Band7_state, EQ_Band7Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S8_Rec = { IIR_NUMSTAGES, rec_EQ_Band8_state, EQ_Band8Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S9_Rec = { IIR_NUMSTAGES, rec_EQ_Band9_state, EQ_Band9Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S10_Rec = { IIR_NUMSTAGES, rec_EQ_Band10_state, EQ_Band10Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S11_Rec = { IIR_NUMSTAGES, rec_EQ_Band11_state, EQ_Band11Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S12_Rec = { IIR_NUMSTAGES, rec_EQ_Band12_state, EQ_Band12Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S13_Rec = { IIR_NUMSTAGES, rec_EQ_Band13_state, EQ_Band13Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S14_Rec = { IIR_NUMSTAGES, rec_EQ_Band14_state, EQ_Band14Coeffs };
 
 //=================== AFP 09-04-23 V012 Quad Si5351 variables
 int iCount;
@@ -1015,52 +969,6 @@ long long freq1;
 // ===============================  AFP 10-02-22 ================
 //Setup for Xmit EQ filters
 float32_t DMAMEM xmtEQ_Level[14];
-//EQBuffers
-float32_t DMAMEM xmt_EQ1_float_buffer_L[256];
-float32_t DMAMEM xmt_EQ2_float_buffer_L[256];
-float32_t DMAMEM xmt_EQ3_float_buffer_L[256];
-float32_t DMAMEM xmt_EQ4_float_buffer_L[256];
-float32_t DMAMEM xmt_EQ5_float_buffer_L[256];
-float32_t DMAMEM xmt_EQ6_float_buffer_L[256];
-float32_t DMAMEM xmt_EQ7_float_buffer_L[256];
-float32_t DMAMEM xmt_EQ8_float_buffer_L[256];
-float32_t DMAMEM xmt_EQ9_float_buffer_L[256];
-float32_t DMAMEM xmt_EQ10_float_buffer_L[256];
-float32_t DMAMEM xmt_EQ11_float_buffer_L[256];
-float32_t DMAMEM xmt_EQ12_float_buffer_L[256];
-float32_t DMAMEM xmt_EQ13_float_buffer_L[256];
-float32_t DMAMEM xmt_EQ14_float_buffer_L[256];
-
-float32_t xmt_EQ_Band1_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };  //declare and zero biquad state variables
-float32_t xmt_EQ_Band2_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t xmt_EQ_Band3_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t xmt_EQ_Band4_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t xmt_EQ_Band5_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t xmt_EQ_Band6_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t xmt_EQ_Band7_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t xmt_EQ_Band8_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t xmt_EQ_Band9_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t xmt_EQ_Band10_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t xmt_EQ_Band11_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t xmt_EQ_Band12_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t xmt_EQ_Band13_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t xmt_EQ_Band14_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-
-//EQ filter instances
-arm_biquad_cascade_df2T_instance_f32 S1_Xmt = { IIR_NUMSTAGES, xmt_EQ_Band1_state, EQ_Band1Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S2_Xmt = { IIR_NUMSTAGES, xmt_EQ_Band2_state, EQ_Band2Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S3_Xmt = { IIR_NUMSTAGES, xmt_EQ_Band3_state, EQ_Band3Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S4_Xmt = { IIR_NUMSTAGES, xmt_EQ_Band4_state, EQ_Band4Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S5_Xmt = { IIR_NUMSTAGES, xmt_EQ_Band5_state, EQ_Band5Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S6_Xmt = { IIR_NUMSTAGES, xmt_EQ_Band6_state, EQ_Band6Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S7_Xmt = { IIR_NUMSTAGES, xmt_EQ_Band7_state, EQ_Band7Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S8_Xmt = { IIR_NUMSTAGES, xmt_EQ_Band8_state, EQ_Band8Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S9_Xmt = { IIR_NUMSTAGES, xmt_EQ_Band9_state, EQ_Band9Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S10_Xmt = { IIR_NUMSTAGES, xmt_EQ_Band10_state, EQ_Band10Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S11_Xmt = { IIR_NUMSTAGES, xmt_EQ_Band11_state, EQ_Band11Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S12_Xmt = { IIR_NUMSTAGES, xmt_EQ_Band12_state, EQ_Band12Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S13_Xmt = { IIR_NUMSTAGES, xmt_EQ_Band13_state, EQ_Band13Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S14_Xmt = { IIR_NUMSTAGES, xmt_EQ_Band14_state, EQ_Band14Coeffs };
 // ===============================End xmit EQ filter setup  AFP 10-02-22 ================
 
 // HP BiQuad IIR DC filter
@@ -1068,20 +976,10 @@ float32_t HP_DC_Butter_state[6] = { 0, 0, 0, 0, 0, 0 };
 float32_t HP_DC_Butter_state2[2] = { 0, 0 };                                                          // AFP 11-04-11
 arm_biquad_cascade_df2T_instance_f32 s1_Receive = { 3, HP_DC_Butter_state, HP_DC_Filter_Coeffs };     //AFP 09-23-22
 arm_biquad_cascade_df2T_instance_f32 s1_Receive2 = { 1, HP_DC_Butter_state2, HP_DC_Filter_Coeffs2 };  //AFP 11-04-22
-//Hilbert FIR Filters
-float32_t FIR_Hilbert_state_L[100 + 256 - 1];
-float32_t FIR_Hilbert_state_R[100 + 256 - 1];
-arm_fir_instance_f32 FIR_Hilbert_L;
-arm_fir_instance_f32 FIR_Hilbert_R;
-
-
-
 
 // CW decode Filters
 arm_fir_instance_f32 FIR_CW_DecodeL;  //AFP 10-25-22
-arm_fir_instance_f32 FIR_CW_DecodeR;  //AFP 10-25-22
 float32_t FIR_CW_DecodeL_state[64 + 256 - 1];
-float32_t FIR_CW_DecodeR_state[64 + 256 - 1];
 
 //Decimation and Interpolation Filters
 arm_fir_decimate_instance_f32 FIR_dec1_EX_I;
@@ -1097,12 +995,6 @@ arm_fir_interpolate_instance_f32 FIR_int1_EX_Q;
 arm_fir_interpolate_instance_f32 FIR_int2_EX_I;
 arm_fir_interpolate_instance_f32 FIR_int2_EX_Q;
 
-arm_fir_decimate_instance_f32 FIR_dec3_EX_I;
-arm_fir_decimate_instance_f32 FIR_dec3_EX_Q;
-arm_fir_interpolate_instance_f32 FIR_int3_EX_I;
-arm_fir_interpolate_instance_f32 FIR_int3_EX_Q;
-float32_t FIR_dec3_EX_I_state[267];
-float32_t FIR_dec3_EX_Q_state[267];
 
 //==
 
@@ -1120,8 +1012,6 @@ float32_t DMAMEM FIR_dec2_EX_Q_state[535];
 
 
 
-//float32_t DMAMEM FIR_int3_EX_coeffs[24];
-float32_t DMAMEM FIR_int3_EX_coeffs[24];
 //==
 
 float32_t DMAMEM FIR_int2_EX_I_state[519];
@@ -1129,8 +1019,6 @@ float32_t DMAMEM FIR_int2_EX_Q_state[519];
 float32_t DMAMEM FIR_int1_EX_coeffs[48];
 float32_t DMAMEM FIR_int2_EX_coeffs[48];
 //==
-float32_t DMAMEM FIR_int3_EX_I_state[519];
-float32_t DMAMEM FIR_int3_EX_Q_state[519];
 //==
 float32_t DMAMEM FIR_int1_EX_I_state[279];
 float32_t DMAMEM FIR_int1_EX_Q_state[279];
@@ -1199,10 +1087,6 @@ arm_biquad_casd_df1_inst_f32 biquad_lowpass1;
 arm_biquad_casd_df1_inst_f32 IIR_biquad_Zoom_FFT_I;
 arm_biquad_casd_df1_inst_f32 IIR_biquad_Zoom_FFT_Q;
 
-arm_fir_decimate_instance_f32 FIR_dec1_I;
-arm_fir_decimate_instance_f32 FIR_dec1_Q;
-arm_fir_decimate_instance_f32 FIR_dec2_I;
-arm_fir_decimate_instance_f32 FIR_dec2_Q;
 arm_fir_decimate_instance_f32 Fir_Zoom_FFT_Decimate_I;
 arm_fir_decimate_instance_f32 Fir_Zoom_FFT_Decimate_Q;
 arm_fir_interpolate_instance_f32 FIR_int1_I;
@@ -1235,6 +1119,7 @@ int stepFineTuneOld = 0;
 long stepFineTune = 50UL;
 long stepFineTune2 = 50UL;
 float32_t NCO_INC;
+uint32_t ncoPhase = 0;  // Receive NCO phase, 2^32 = one cycle.  Fs/4 and fine tune combined, see FreqShift2()
 double OSC_COS;
 double OSC_SIN;
 double Osc_Vect_Q = 1.0;
@@ -1257,24 +1142,14 @@ float32_t cosBuffer3[256];
 float32_t cosBuffer4[256];  // AFP 01-31-25
 float32_t cosBuffer5[256];  // AFP 01-31-25
 float32_t cosBuffer6[2048];
-float32_t sinBuffer[256];
 float32_t sinBuffer2[256];
 float32_t sinBuffer3[256];
 float32_t sinBuffer4[256];  // AFP 01-31-25
 float32_t sinBuffer5[256];
 float32_t sinBuffer6[2048];  // AFP 01-31-25
-float32_t aveCorrResult;
-float32_t aveCorrResultR;
-float32_t aveCorrResultL;
 float32_t magFFTResults[256];
 float32_t float_Corr_Buffer[511];
-float32_t corrResultR;
-uint32_t corrResultIndexR;
-float32_t corrResultL;
-uint32_t corrResultIndexL;
-float32_t combinedCoeff;
-float32_t combinedCoeff2;
-float32_t combinedCoeff2Old;
+float32_t cwToneLevel;  // Tone amplitude the CW decoder saw in the last block
 int CWCoeffLevelOld = 0.0;
 float CWLevelTimer = 0.0;
 float CWLevelTimerOld = 0.0;
@@ -1286,8 +1161,6 @@ float gain_dB = 0.0;                            //computed desired gain value in
 boolean use_HP_filter = true;                   //enable the software HP filter to get rid of DC?
 float knee_dBFS, comp_ratio, attack_sec, release_sec;
 // ===========
-float32_t float_Corr_BufferR[511];
-float32_t float_Corr_BufferL[511];
 long tempSigTime = 0;
 
 //int audioTemp           = 0;  KF5N
@@ -1296,7 +1169,6 @@ float sigStart = 0.0;
 float sigDuration = 0.0;
 float gapStartData = 0.0;
 float gapDurationData = 0.0;
-float goertzelMagnitude;
 float swr;
 float Pf_W;
 float Pr_W;
@@ -1461,6 +1333,7 @@ uint8_t LastSampleRate = SAMPLE_RATE_192K;
 uint8_t minute10_old;
 uint8_t minute1_old;
 uint8_t NB_on = 0;
+uint8_t NB_RF_on = 0;  // Impulse blanker on the wideband I/Q, RFNoiseBlanker()
 uint8_t NB_test = 0;
 uint8_t notchButtonState = 0;
 uint8_t notchIndex = 0;
@@ -1645,9 +1518,6 @@ int agc_slope = 100;
 int agc_thresh = 30;
 int ANR_buff_size = FFT_length / 2.0;
 int ANR_delay = 16;
-int ANR_dline_size = ANR_DLINE_SIZE;
-int ANR_in_idx = 0;
-int ANR_mask = ANR_dline_size - 1;
 int ANR_position = 0;
 int ANR_taps = 64;
 int attack_buffsize;
@@ -1657,7 +1527,7 @@ float corrPlotYValue;
 int volumeFunction = AUDIO_VOLUME;  // G0ORX
 int setCorrPlotDecimalFlag = 0;
 
-int audioYPixel[256];  // Greg was 1024 2/26/2023
+int16_t audioYPixel[256];  // Greg was 1024 2/26/2023
 int audioPostProcessorCells[AUDIO_POST_PROCESSOR_BANDS];
 
 int bandswitchPins[] = {
@@ -1689,6 +1559,9 @@ int dcfSilenceTimer;
 int dcfTheSecond;
 int dcfPulseTime;
 int decoderFlag = DECODER_STATE;  // Startup state for decoder
+uint8_t cwSkimmerOn = 0;         // Multi-channel decoder, CWSkimmer()
+uint8_t rxLatencyMode = RX_LATENCY_NORMAL;  // Receive block size, SetRxLatencyMode()
+uint8_t rxConvMode = RX_CONV_STANDARD;       // Receive convolution FFT and filter length, SetRxConvMode()
 int demodIndex = 0;               //AFP 2-10-21
 int directFreqFlag = 0;
 int EEPROMChoice;
@@ -1769,11 +1642,12 @@ int zoom_sample_ptr = 0;
 int zoomIndex = 1;                 //AFP 9-26-22
 int tuneIndex = DEFAULTFREQINDEX;  //AFP 2-10-21
 int updateDisplayFlag = 1;
+int spectrumFrameReady = 0;  // Set by the spectrum FFT when pixelnew[] holds a frame ShowSpectrum() has not drawn yet
+int displayBusy = 0;         // Set while the RA8875 moves memory; ProcessIQData() then leaves the display alone
 int updateCalDisplayFlag = 0;
 int xrState;  // Is the T41 in xmit or rec state? 1 = rec, 0 = xmt
 
 const int BW_indicator_y = SPECTRUM_TOP_Y + SPECTRUM_HEIGHT + 2;
-const int DEC2STATESIZE = n_dec2_taps + (BUFFER_SIZE * N_B / (uint32_t)DF1) - 1;
 const int INT1_STATE_SIZE = 24 + BUFFER_SIZE * N_B / (uint32_t)DF - 1;
 const int INT2_STATE_SIZE = 8 + BUFFER_SIZE * N_B / (uint32_t)DF1 - 1;
 const int myInput = AUDIO_INPUT_LINEIN;
@@ -1905,24 +1779,16 @@ float32_t d[3 * SAM_PLL_HILBERT_STAGES + 3];
 
 float32_t abs_ring[RB_SIZE];
 float32_t abs_out_sample;
-float32_t ai, bi, aq, bq;
-float32_t ai_ps, bi_ps, aq_ps, bq_ps;
-float32_t ANR_d[ANR_DLINE_SIZE];
 float32_t ANR_den_mult = 6.25e-10;
 float32_t ANR_gamma = 0.1;
-float32_t ANR_lidx = 120.0;
 float32_t ANR_lidx_min = 120.0;
 float32_t ANR_lidx_max = 200.0;
 float32_t ANR_lincr = 1.0;
 float32_t ANR_ldecr = 3.0;
-float32_t ANR_ngamma = 0.001;
 float32_t ANR_two_mu = 0.0001;
-float32_t ANR_w[ANR_DLINE_SIZE];
 float32_t attack_mult;
-float32_t audio;
 float32_t audiotmp = 0.0f;
-float32_t audiou;
-float32_t audioSpectBuffer[1024];  // This can't be DMAMEM.  It will break the S-Meter.  KF5N October 10, 2023
+float32_t audioSpectBuffer[1024 + 3];  // Bins 1 to 1024 are written, and the audio display reads two past them.  This can't be DMAMEM.  It will break the S-Meter.  KF5N October 10, 2023
 float32_t bass = 0.0;
 float32_t farnsworthValue;
 int currentMicThreshold;  // Don't need to define here, will happen with EEPROMRead().  KF5N August 27, 2023
@@ -1954,7 +1820,7 @@ float32_t dbm_old = -145.0;
 float32_t dbmhz = -145.0;
 float32_t decay_mult;
 float32_t display_offset;
-float32_t DMAMEM FFT_buffer[FFT_LENGTH * 2] __attribute__((aligned(4)));
+float32_t DMAMEM FFT_buffer[RX_CONV_MAX_LENGTH * 2] __attribute__((aligned(4)));
 float32_t DMAMEM FFT_spec[1024];
 float32_t DMAMEM FFT_spec_old[1024];
 float32_t dsI;
@@ -1964,24 +1830,14 @@ float32_t fast_backmult;
 float32_t fast_decay_mult;
 
 
-float32_t DMAMEM FIR_Coef_I[(FFT_LENGTH / 2) + 1];
-float32_t DMAMEM FIR_Coef_Q[(FFT_LENGTH / 2) + 1];
-float32_t DMAMEM FIR_dec1_I_state[n_dec1_taps + (uint16_t)BUFFER_SIZE * (uint32_t)N_B - 1];
-float32_t DMAMEM FIR_dec2_I_state[DEC2STATESIZE];
-float32_t DMAMEM FIR_dec2_coeffs[n_dec2_taps];
-float32_t DMAMEM FIR_dec2_Q_state[DEC2STATESIZE];
-float32_t DMAMEM FIR_dec3_I_state[DEC2STATESIZE];
-float32_t DMAMEM FIR_dec3_coeffs[n_dec2_taps];
-float32_t DMAMEM FIR_dec3_Q_state[DEC2STATESIZE];
+float32_t DMAMEM FIR_Coef_I[RX_CONV_MAX_TAPS];
+float32_t DMAMEM FIR_Coef_Q[RX_CONV_MAX_TAPS];
 
 float32_t DMAMEM FIR_int2_I_state[INT2_STATE_SIZE];
 float32_t DMAMEM FIR_int2_Q_state[INT2_STATE_SIZE];
 float32_t DMAMEM FIR_int1_coeffs[48];
 float32_t DMAMEM FIR_int2_coeffs[32];
 float32_t DMAMEM FIR_int3_coeffs[32];
-float32_t DMAMEM FIR_dec1_Q_state[n_dec1_taps + (uint16_t)BUFFER_SIZE * (uint16_t)N_B - 1];
-float32_t DMAMEM FIR_dec1_coeffs[n_dec1_taps];
-float32_t DMAMEM FIR_filter_mask[FFT_LENGTH * 2] __attribute__((aligned(4)));
 float32_t DMAMEM FIR_int1_I_state[INT1_STATE_SIZE];
 float32_t DMAMEM FIR_int1_Q_state[INT1_STATE_SIZE];
 float32_t DMAMEM Fir_Zoom_FFT_Decimate_I_state[4 + BUFFER_SIZE * N_B - 1];
@@ -1993,11 +1849,8 @@ float32_t DMAMEM float_buffer_R[BUFFER_SIZE * N_B];
 
 float32_t DMAMEM float_buffer_L2[BUFFER_SIZE * N_B];
 float32_t DMAMEM float_buffer_R2[BUFFER_SIZE * N_B];
-float32_t DMAMEM float_buffer_L_3[BUFFER_SIZE * N_B];
-float32_t DMAMEM float_buffer_R_3[BUFFER_SIZE * N_B];
 
 float32_t DMAMEM float_buffer_L_CW[256];       //AFP 09-01-22
-float32_t DMAMEM float_buffer_R_CW[256];       //AFP 09-01-22
 float32_t DMAMEM float_buffer_R_AudioCW[256];  //AFP 10-18-22
 float32_t DMAMEM float_buffer_L_AudioCW[256];  //AFP 10-18-22
 float32_t hang_backaverage;
@@ -2008,7 +1861,7 @@ float32_t hang_level;
 float32_t hangtime;
 float32_t hh1 = 0.0;
 float32_t hh2 = 0.0;
-float32_t DMAMEM iFFT_buffer[FFT_LENGTH * 2 + 1];
+float32_t DMAMEM iFFT_buffer[RX_CONV_MAX_LENGTH * 2 + 1];
 float32_t I_old = 0.2;
 float32_t I_sum;
 float32_t IIR_biquad_Zoom_FFT_I_state[IIR_biquad_Zoom_FFT_N_stages * 4];
@@ -2022,8 +1875,7 @@ float32_t K_est = 1.0;
 float32_t K_est_old = 0.0;
 float32_t K_est_mult = 1.0 / K_est;
 float32_t last_dc_level = 0.0f;
-float32_t DMAMEM last_sample_buffer_L[BUFFER_SIZE * N_DEC_B];
-float32_t DMAMEM last_sample_buffer_R[BUFFER_SIZE * N_DEC_B];
+float32_t DMAMEM last_sample_buffer[RX_CONV_MAX_LENGTH];  // Interleaved I/Q, the FFT_length - rxConvHop samples the receive FFT overlaps
 float32_t DMAMEM L_BufferOffset[BUFFER_SIZE * N_B];
 float32_t LMS_errsig1[256 + 10];
 float32_t LMS_NormCoeff_f32[MAX_LMS_TAPS + MAX_LMS_DELAY];
@@ -2071,15 +1923,11 @@ float32_t DMAMEM NR_last_sample_buffer_R[NR_FFT_L / 2];
 float32_t DMAMEM NR_X[NR_FFT_L / 2][3];
 float32_t DMAMEM NR_E[NR_FFT_L / 2][15];
 float32_t DMAMEM NR_M[NR_FFT_L / 2];
-float32_t DMAMEM NR_Nest[NR_FFT_L / 2][2];  //
 float32_t NR_vk;
 float32_t DMAMEM NR_lambda[NR_FFT_L / 2];
 float32_t DMAMEM NR_Gts[NR_FFT_L / 2][2];
 float32_t DMAMEM NR_G[NR_FFT_L / 2];
-float32_t DMAMEM NR_SNR_prio[NR_FFT_L / 2];
-float32_t DMAMEM NR_SNR_post[NR_FFT_L / 2];
 float32_t NR_SNR_post_pos;
-float32_t DMAMEM NR_Hk_old[NR_FFT_L / 2];
 float32_t NR_VAD = 0.0;
 float32_t NR_VAD_thresh = 6.0;
 float32_t DMAMEM NR_long_tone[NR_FFT_L / 2][2];
@@ -2089,6 +1937,7 @@ float32_t NR_long_tone_thresh = 12000;
 float32_t NR_gain_smooth_alpha = 0.25;
 float32_t NR_temp_sum = 0.0;
 float32_t NB_thresh = 2.5;
+float32_t NB_RF_thresh = 8.0;  // Impulse over average amplitude, 18 dB
 float32_t offsetDisplayDB = 10.0;
 
 
@@ -2104,7 +1953,6 @@ float32_t omega_min = TPI * -pll_fmax * 1 / 24000;
 float32_t omega_max = TPI * pll_fmax * 1 / 24000;
 float32_t g1 = 1.0 - exp(-2.0 * omegaN * zeta * 1 / 24000);
 float32_t g2 = -g1 + 2.0 * (1 - exp(-omegaN * zeta * 1 / 24000) * cosf(omegaN * 1 / 24000 * sqrtf(1.0 - zeta * zeta)));
-float32_t phzerror = 0.0;
 float32_t det = 0.0;
 float32_t fil_out = 0.0;
 float32_t del_out = 0.0;
@@ -2115,13 +1963,12 @@ float32_t tauR = 0.02;  // original 0.02;
 float32_t tauI = 1.4;   // original 1.4;
 float32_t dc = 0.0;
 float32_t dc_insert = 0.0;
-float32_t dcu = 0.0;
-float32_t dc_insertu = 0.0;
-float32_t mtauR = exp(-1 / 24000 * tauR);
+float32_t mtauR = exp(-1.0 / (24000 * tauR));
 float32_t onem_mtauR = 1.0 - mtauR;
-float32_t mtauI = exp(-1 / 24000 * tauI);
+float32_t mtauI = exp(-1.0 / (24000 * tauI));
 float32_t onem_mtauI = 1.0 - mtauI;
 uint8_t fade_leveler = 1;
+uint8_t samSideband = SAM_DSB;  // SAM_DSB, SAM_LSB or SAM_USB
 
 float32_t onemfast_backmult;
 float32_t onemhang_backmult;
@@ -2275,11 +2122,12 @@ time_t getTeensy3Time() {
 *****/
 void Codec_gain() {
   static uint32_t timer = 0;
+  const uint32_t calls = N_B / N_BLOCKS;  // Calls per 2048 sample block, what the waits below are counted in
   timer++;
   if (timer > 10000) timer = 10000;
   if (half_clip == 1)  // did clipping almost occur?
   {
-    if (timer >= 20)  // 100  // has enough time passed since the last gain decrease?
+    if (timer >= 20 * calls)  // 100  // has enough time passed since the last gain decrease?
     {
       if (bands[currentBand].RFgain != 0)  // yes - is this NOT zero?
       {
@@ -2297,7 +2145,7 @@ void Codec_gain() {
     }
   } else if (quarter_clip == 0)  // no clipping occurred
   {
-    if (timer >= 50)  // 500   // has it been long enough since the last increase?
+    if (timer >= 50 * calls)  // 500   // has it been long enough since the last increase?
     {
       bands[currentBand].RFgain += 1;  // increase gain by one step, 1.5dB
       timer = 0;                       // reset the timer to prevent this from executing too often
@@ -2499,41 +2347,17 @@ void InitializeDataArrays() {
   CLEAR_VAR(NR_M);                     //memset(NR_M, 0, 512);
   CLEAR_VAR(NR_lambda);                //memset(NR_lambda, 0, 512);
   CLEAR_VAR(NR_G);                     //memset(NR_G, 0, 512);
-  CLEAR_VAR(NR_SNR_prio);              //memset(NR_SNR_prio, 0, 512);
-  CLEAR_VAR(NR_SNR_post);              //memset(NR_SNR_post, 0, 512);
-  CLEAR_VAR(NR_Hk_old);                //memset(NR_Hk_old, 0, 512);
   CLEAR_VAR(NR_X);                     //memset(NR_X, 0, 1536);
-  CLEAR_VAR(NR_Nest);                  //memset(NR_Nest, 0, 1024);
   CLEAR_VAR(NR_Gts);                   //memset(NR_Gts, 0, 1024);
   CLEAR_VAR(NR_E);                     //memset(NR_E, 0, 7680);
-  CLEAR_VAR(ANR_d);                    //memset(ANR_d, 0, 2048);
-  CLEAR_VAR(ANR_w);                    //memset(ANR_w, 0, 2048);
   CLEAR_VAR(LMS_StateF32);             //memset(LMS_StateF32, 0, 1408);  // 96 + 256 * 4
   CLEAR_VAR(LMS_NormCoeff_f32);        //memset(LMS_NormCoeff_f32, 0, 1408);
   CLEAR_VAR(LMS_nr_delay);             //memset(LMS_nr_delay, 0, 2312);
 
-  CalcCplxFIRCoeffs(FIR_Coef_I, FIR_Coef_Q, m_NumTaps, (float32_t)bands[currentBand].FLoCut, (float32_t)bands[currentBand].FHiCut, (float)SR[SampleRate].rate / DF);
-
   /****************************************************************************************
 	   init complex FFTs
 	****************************************************************************************/
-  switch (FFT_length) {
-    case 2048:
-      S = &arm_cfft_sR_f32_len2048;
-      iS = &arm_cfft_sR_f32_len2048;
-      maskS = &arm_cfft_sR_f32_len2048;
-      break;
-    case 1024:
-      S = &arm_cfft_sR_f32_len1024;
-      iS = &arm_cfft_sR_f32_len1024;
-      maskS = &arm_cfft_sR_f32_len1024;
-      break;
-    case 512:
-      S = &arm_cfft_sR_f32_len512;
-      iS = &arm_cfft_sR_f32_len512;
-      maskS = &arm_cfft_sR_f32_len512;
-      break;
-  }
+  SetRxFFTInstances();
   spec_FFT = &arm_cfft_sR_f32_len512;  //Changed specification to 512 instance
   NR_FFT = &arm_cfft_sR_f32_len256;
   NR_iFFT = &arm_cfft_sR_f32_len256;
@@ -2577,44 +2401,9 @@ void InitializeDataArrays() {
   /****************************************************************************************
 	   Initiate decimation and interpolation FIR filters
 	****************************************************************************************/
-  // Decimation filter 1, M1 = DF1
-  //    CalcFIRCoeffs(FIR_dec1_coeffs, 25, (float32_t)5100.0, 80, 0, 0.0, (float32_t)SR[SampleRate].rate);
-  CalcFIRCoeffs(FIR_dec1_coeffs, n_dec1_taps, (float32_t)(n_desired_BW * 1000.0), n_att, 0, 0.0, (float32_t)SR[SampleRate].rate);
-
-  if (arm_fir_decimate_init_f32(&FIR_dec1_I, n_dec1_taps, (uint32_t)DF1, FIR_dec1_coeffs, FIR_dec1_I_state, BUFFER_SIZE * N_BLOCKS)) {
-    while (1)
-      ;
-  }
-
-  if (arm_fir_decimate_init_f32(&FIR_dec1_Q, n_dec1_taps, (uint32_t)DF1, FIR_dec1_coeffs, FIR_dec1_Q_state, BUFFER_SIZE * N_BLOCKS)) {
-    while (1)
-      ;
-  }
-
-  // Decimation filter 2, M2 = DF2
-  CalcFIRCoeffs(FIR_dec2_coeffs, n_dec2_taps, (float32_t)(n_desired_BW * 1000.0), n_att, 0, 0.0, (float32_t)(SR[SampleRate].rate / DF1));
-  if (arm_fir_decimate_init_f32(&FIR_dec2_I, n_dec2_taps, (uint32_t)DF2, FIR_dec2_coeffs, FIR_dec2_I_state, BUFFER_SIZE * N_BLOCKS / (uint32_t)DF1)) {
-    while (1)
-      ;
-  }
-
-  if (arm_fir_decimate_init_f32(&FIR_dec2_Q, n_dec2_taps, (uint32_t)DF2, FIR_dec2_coeffs, FIR_dec2_Q_state, BUFFER_SIZE * N_BLOCKS / (uint32_t)DF1)) {
-    while (1)
-      ;
-  }
+  // Decimation filters, M = DF1 * DF2
+  InitRxDecimator();
 
-
-  CalcFIRCoeffs(FIR_dec3_coeffs, n_dec1_taps, (float32_t)(n_desired_BW * 1000.0), n_att, 0, 0.0, (float32_t)SR[SampleRate].rate);
-
-  if (arm_fir_decimate_init_f32(&FIR_dec1_I, n_dec1_taps, (uint32_t)DF1, FIR_dec1_coeffs, FIR_dec1_I_state, BUFFER_SIZE * N_BLOCKS)) {
-    while (1)
-      ;
-  }
-
-  if (arm_fir_decimate_init_f32(&FIR_dec1_Q, n_dec1_taps, (uint32_t)DF1, FIR_dec1_coeffs, FIR_dec1_Q_state, BUFFER_SIZE * N_BLOCKS)) {
-    while (1)
-      ;
-  }
   // Interpolation filter 1, L1 = 2
   // not sure whether I should design with the final sample rate ??
   // yes, because the interpolation filter is AFTER the upsampling, so it has to be in the target sample rate!
@@ -3108,22 +2897,8 @@ void setup() {
   digitalWrite(TFT_SCLK, HIGH);
   pinMode(TFT_CS, OUTPUT);
   digitalWrite(TFT_CS, HIGH);
-  //===================================================
-  //  AFP 02-17-25 New Hilbert transforms @ 12K SPS to allow better response at lower frequencies
-
-
-
-
-  arm_fir_init_f32(&FIR_Hilbert_L, 100, FIR_Hilbert_coeffs_45, FIR_Hilbert_state_L, 128);  //AFP01-16-22
-  arm_fir_init_f32(&FIR_Hilbert_R, 100, FIR_Hilbert_coeffs_neg_45, FIR_Hilbert_state_R, 128);
-  // arm_fir_init_f32(&FIR_Hilbert_L, 100, FIR_Hilbert_coeffs_45, FIR_Hilbert_state_L, 256);  //AFP01-16-22
-  //arm_fir_init_f32(&FIR_Hilbert_R, 100, FIR_Hilbert_coeffs_neg_45, FIR_Hilbert_state_R, 256);
-
-
-
   //====================================================================
   arm_fir_init_f32(&FIR_CW_DecodeL, 64, CW_Filter_Coeffs2, FIR_CW_DecodeL_state, 256);  //AFP 10-25-22
-  arm_fir_init_f32(&FIR_CW_DecodeR, 64, CW_Filter_Coeffs2, FIR_CW_DecodeR_state, 256);
   arm_fir_decimate_init_f32(&FIR_dec1_EX_I, 48, 4, coeffs192K_10K_LPF_FIR, FIR_dec1_EX_I_state, 2048);
   arm_fir_decimate_init_f32(&FIR_dec1_EX_Q, 48, 4, coeffs192K_10K_LPF_FIR, FIR_dec1_EX_Q_state, 2048);
   arm_fir_decimate_init_f32(&FIR_dec2_EX_I, 24, 2, coeffs48K_8K_LPF_FIR, FIR_dec2_EX_I_state, 512);
@@ -3134,12 +2909,6 @@ void setup() {
   arm_fir_interpolate_init_f32(&FIR_int2_EX_I, 4, 32, coeffs192K_10K_LPF_FIR, FIR_int2_EX_I_state, 512);
   arm_fir_interpolate_init_f32(&FIR_int2_EX_Q, 4, 32, coeffs192K_10K_LPF_FIR, FIR_int2_EX_Q_state, 512);
 
-  arm_fir_decimate_init_f32(&FIR_dec3_EX_I, 24, 2, coeffs12K_8K_LPF_FIR, FIR_dec3_EX_I_state, 256);  //3rd Decimate Excite 2x to 12K SPS
-  arm_fir_decimate_init_f32(&FIR_dec3_EX_Q, 24, 2, coeffs12K_8K_LPF_FIR, FIR_dec3_EX_Q_state, 256);
-  //2x interpolate fron 12K to 24K sps 4K LPF
-  arm_fir_interpolate_init_f32(&FIR_int3_EX_I, 2, 48, coeffs12K_8K_LPF_FIR, FIR_int3_EX_I_state, 128);
-  arm_fir_interpolate_init_f32(&FIR_int3_EX_Q, 2, 48, coeffs12K_8K_LPF_FIR, FIR_int3_EX_Q_state, 128);
-
   //====
 
   //====
@@ -3260,12 +3029,7 @@ void setup() {
   splitOn = 0;  // Split VFO not active
   SetupMode(bands[currentBand].mode);
 
-  float32_t theta = 0.0;            //AFP 10-25-22
-  for (int kf = 0; kf < 255; kf++)  //Calc sine wave
-  {
-    theta = kf * 0.19634950849362;  // Simplify terms: theta = kf * 2 * PI * freqSideTone / 24000  JJP 6/28/23
-    sinBuffer[kf] = sin(theta);
-  }
+  CWToneDetectorInit(CW_DECODE_TONE_HZ, CW_DECODE_SAMPLE_RATE);
 
   SetKeyPowerUp();  // Use keyType and paddleFlip to configure key GPIs.  KF5N August 27, 2023
   SetDitLength(currentWPM);
@@ -3286,7 +3050,11 @@ void setup() {
   ShowName();
 
   ShowBandwidth();
+  SetRxLatencyMode(rxLatencyMode);  // The block size and filter length saved in EEPROM, before the masks are sized for them
+  SetRxConvMode(rxConvMode);
+  PrewarmFilterMasks();
   FilterBandwidth();
+  InitSSBModulator();  // Needs the transmit EQ settings from EEPROM
   ShowFrequency();
   Debug("Current band = " + String(currentBand,DEC));
   SetBand();
@@ -3309,6 +3077,9 @@ void setup() {
   decoderFlag = 0;
   freqCalFlag = 0;  //AFP 01-30-25
   SetupMyCompressors(use_HP_filter, 0.0, comp_ratio, 0.01, 0.01);
+#if defined(DSP_PROFILER)
+  ProfilerInit();
+#endif  // DSP_PROFILER
   Debug("Setup complete");
 }
 //============================================================== END setup() =================================================================
@@ -3333,7 +3104,7 @@ elapsedMicros usec = 0;  // Automatically increases as time passes; no ++ necess
   Return value:
     void
 *****/
-int Ncnt;
+unsigned long debugStatusTimer;
 FASTRUN void loop()  // Replaced entire loop() with Greg's code  JJP  7/14/23
 {
 #ifdef MAIN_BOARD_ATTINY_SHUTDOWN
@@ -3344,18 +3115,25 @@ FASTRUN void loop()  // Replaced entire loop() with Greg's code  JJP  7/14/23
 #endif
 
   #ifdef DEBUG
-  // Print some status variables roughly every 10 seconds for debug purposes
-  Ncnt += 1;
-  if (Ncnt == 100){
-    Ncnt = 0;
+  // Print some status variables every 10 seconds for debug purposes.  Timed rather than counted,
+  // because loop() now runs once per ShowSpectrum() slice instead of once per full spectrum frame.
+  if (millis() - debugStatusTimer >= 10000UL) {
+    debugStatusTimer = millis();
     printLPFState();
     printBPFState();
     printRFState();
     Serial.println("free  ram = " + String(freeram(),DEC));
     Serial.println("audio mem = " + String(AudioMemoryUsage(),DEC));
+#if defined(DSP_PROFILER)
+    ProfilerReport(Serial);
+#endif  // DSP_PROFILER
   }
   #endif
 
+  if (cwSkimmerOn) {
+    CWSkimmerShowSpots(Serial);  // Callsigns the skimmer found in ProcessIQData()
+  }
+
   int pushButtonSwitchIndex = -1;
   valPin = ReadSelectedPushButton();  // Poll UI push buttons
   if (valPin != BOGUS_PIN_READ)       // If a button was pushed...
@@ -3415,6 +3193,7 @@ FASTRUN void loop()  // Replaced entire loop() with Greg's code  JJP  7/14/23
         }
         lastState = SSB_RECEIVE_STATE;
         ShowSpectrum();
+        ShowSAMCarrierOffset();
         break;
       }
       //================  SSB Transmit State =============
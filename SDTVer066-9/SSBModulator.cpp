@@ -0,0 +1,99 @@
+#ifndef BEENHERE
+#include "SDT.h"
+#endif
+
+/*****
+  SSB modulator for the exciter, at the 24K SPS rate after decimation.
+
+  The microphone audio is real, so its spectrum has both sidebands.  One overlap-save FFT convolution
+  with a complex filter that only passes positive frequencies turns it into the I/Q pair of a single
+  sideband.  The mask holds the transmit bandpass, the transmit equalizer and the 90 degree phase
+  shift, so all three cost one 512 point FFT, one complex multiply and one inverse FFT per 256 samples.
+
+  The output sideband is the one the old Hilbert pair made (Q lags I by 90 degrees).  ExciterIQData()
+  still picks USB or LSB with the sign of I when it applies the IQ correction.
+*****/
+#define TX_SSB_FFT_LENGTH 512
+#define TX_SSB_BLOCK (TX_SSB_FFT_LENGTH / 2)     // New samples per call
+#define TX_SSB_TAPS (TX_SSB_FFT_LENGTH / 2 + 1)  // Longest filter overlap-save can run without wrapping
+#define TX_SSB_LO_HZ 200.0                       // -6 dB edges of the transmit passband
+#define TX_SSB_HI_HZ 3000.0
+#define TX_SSB_GAIN 3.5  // Same I and Q level as the Hilbert pair
+
+static float32_t DMAMEM txSSBMask[TX_SSB_FFT_LENGTH * 2];
+static float32_t DMAMEM txSSBBuffer[TX_SSB_FFT_LENGTH * 2];
+static float32_t txSSBHistory[TX_SSB_BLOCK];
+
+/*****
+  Purpose: Build the transmit filter mask from the passband, the transmit EQ settings and the level,
+           and clear the overlap history.  Call again whenever xmitEQFlag or xmtEQ_Level[] change.
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+void InitSSBModulator() {
+  const arm_cfft_instance_f32 *txS = &arm_cfft_sR_f32_len512;
+  float32_t sampleRate = (float32_t)SR[SampleRate].rate / DF;
+  float32_t coeffsI[TX_SSB_TAPS];
+  float32_t coeffsQ[TX_SSB_TAPS];
+
+  // The same windowed complex bandpass the receive filter uses, from the low edge up to the high edge
+  CalcCplxFIRCoeffs(coeffsI, coeffsQ, TX_SSB_TAPS, TX_SSB_LO_HZ, TX_SSB_HI_HZ, sampleRate);
+  memset(txSSBMask, 0, sizeof(txSSBMask));
+  for (int i = 0; i < TX_SSB_TAPS; i++) {
+    txSSBMask[i * 2] = coeffsI[i] * TX_SSB_GAIN;
+    txSSBMask[i * 2 + 1] = coeffsQ[i] * TX_SSB_GAIN;
+  }
+  arm_cfft_f32(txS, txSSBMask, 0, 1);
+
+  if (xmitEQFlag == ON) {
+    // Scale both halves alike so the opposite sideband keeps its suppression.  The EQ gain is real,
+    // so the filter stays linear phase.
+    for (int i = 0; i < TX_SSB_FFT_LENGTH; i++) {
+      int bin = (i < TX_SSB_FFT_LENGTH / 2) ? i : i - TX_SSB_FFT_LENGTH;
+      float32_t gain = EqualizerGain(xmtEQ_Level, fabsf((float32_t)bin * sampleRate / TX_SSB_FFT_LENGTH), sampleRate);
+      txSSBMask[i * 2] *= gain;
+      txSSBMask[i * 2 + 1] *= gain;
+    }
+    // Back to TX_SSB_TAPS taps with a Hann window so the convolution does not wrap
+    TaperFilterMask(txS, txSSBMask, TX_SSB_FFT_LENGTH, TX_SSB_TAPS);
+  }
+
+  memset(txSSBHistory, 0, sizeof(txSSBHistory));
+}
+
+/*****
+  Purpose: Turn a block of transmit audio into single sideband I and Q
+
+  Parameter list:
+    float32_t *I_buffer       audio in, I out
+    float32_t *Q_buffer       Q out, TX_SSB_BLOCK (256) samples each
+
+  Return value;
+    void
+*****/
+void SSBModulate(float32_t *I_buffer, float32_t *Q_buffer) {
+  const arm_cfft_instance_f32 *txS = &arm_cfft_sR_f32_len512;
+
+  // Last block, then this one, as a complex signal with no imaginary part
+  for (int i = 0; i < TX_SSB_BLOCK; i++) {
+    txSSBBuffer[i * 2] = txSSBHistory[i];
+    txSSBBuffer[i * 2 + 1] = 0.0;
+    txSSBBuffer[(TX_SSB_BLOCK + i) * 2] = I_buffer[i];
+    txSSBBuffer[(TX_SSB_BLOCK + i) * 2 + 1] = 0.0;
+  }
+  arm_copy_f32(I_buffer, txSSBHistory, TX_SSB_BLOCK);
+
+  arm_cfft_f32(txS, txSSBBuffer, 0, 1);
+  arm_cmplx_mult_cmplx_f32(txSSBBuffer, txSSBMask, txSSBBuffer, TX_SSB_FFT_LENGTH);
+  arm_cfft_f32(txS, txSSBBuffer, 1, 1);
+
+  // The second half is clear of the circular wrap
+  for (int i = 0; i < TX_SSB_BLOCK; i++) {
+    I_buffer[i] = txSSBBuffer[(TX_SSB_BLOCK + i) * 2];
+    Q_buffer[i] = txSSBBuffer[(TX_SSB_BLOCK + i) * 2 + 1];
+  }
+}
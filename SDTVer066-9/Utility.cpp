@@ -210,6 +210,111 @@ void IQPhaseCorrection(float32_t *I_buffer, float32_t *Q_buffer, float32_t facto
   }
 }  // end IQphase_correction
 
+/*****
+  Receive front end coefficients.  q15 -> float, both RF gains, the IQ amplitude correction and the
+  IQ phase correction are all linear, so they fold into one 2x2 matrix:
+      I = m11 * Iq15 + m12 * Qq15
+      Q = m21 * Iq15 + m22 * Qq15
+  The matrix includes the 1/32768 q15 scale.  It is rebuilt only when one of the inputs changes.
+*****/
+static struct {
+  int valid;
+  int rfGainAllBands;
+  int RFgain;
+  int mode;
+  float32_t ampCorrection;
+  float32_t phaseCorrection;
+  float32_t m11, m12, m21, m22;
+} iqFrontEnd;
+
+/*****
+  Purpose: Rebuild the receive front end matrix if a gain, calibration value or the mode has changed
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+void UpdateIQFrontEnd() {
+  int mode = bands[currentBand].mode;
+  if (iqFrontEnd.valid && iqFrontEnd.rfGainAllBands == rfGainAllBands && iqFrontEnd.RFgain == bands[currentBand].RFgain
+      && iqFrontEnd.mode == mode && iqFrontEnd.ampCorrection == IQAmpCorrectionFactor[currentBand]
+      && iqFrontEnd.phaseCorrection == IQPhaseCorrectionFactor[currentBand]) {
+    return;
+  }
+  iqFrontEnd.valid = 1;
+  iqFrontEnd.rfGainAllBands = rfGainAllBands;
+  iqFrontEnd.RFgain = bands[currentBand].RFgain;
+  iqFrontEnd.mode = mode;
+  iqFrontEnd.ampCorrection = IQAmpCorrectionFactor[currentBand];
+  iqFrontEnd.phaseCorrection = IQPhaseCorrectionFactor[currentBand];
+
+  float32_t gain = pow(10, (float)rfGainAllBands / 20) * (float32_t)bands[currentBand].RFgain / 32768.0;
+  float32_t amp = 1.0;
+  float32_t phase = 0.0;
+  if (mode == DEMOD_LSB || mode == DEMOD_AM || mode == DEMOD_SAM) {  // Same sign choices as the former arm_scale_f32()/IQPhaseCorrection() calls  AFP 04-14-22
+    amp = -IQAmpCorrectionFactor[currentBand];
+    phase = -IQPhaseCorrectionFactor[currentBand];
+  } else if (mode == DEMOD_USB) {
+    amp = -IQAmpCorrectionFactor[currentBand];
+    phase = IQPhaseCorrectionFactor[currentBand];
+  }
+  iqFrontEnd.m11 = amp * gain;
+  iqFrontEnd.m22 = gain;
+  if (phase < 0.0) {  // mix a bit of the corrected I into Q
+    iqFrontEnd.m12 = 0.0;
+    iqFrontEnd.m21 = phase * amp * gain;
+  } else {  // mix a bit of Q into I
+    iqFrontEnd.m12 = phase * gain;
+    iqFrontEnd.m21 = 0.0;
+  }
+}
+
+/*****
+  Purpose: Receive front end in one pass: convert q15 I and Q to float and apply the gain and IQ correction
+           matrix built by UpdateIQFrontEnd()
+
+  Parameter list:
+    const q15_t *I_in, *Q_in          raw samples from the audio queues
+    float32_t *IQ_out                 corrected float samples, interleaved I, Q
+    uint32_t blocksize                number of samples
+
+  Return value;
+    void
+*****/
+void IQFrontEnd(const q15_t *I_in, const q15_t *Q_in, float32_t *IQ_out, uint32_t blocksize) {
+  const float32_t m11 = iqFrontEnd.m11, m12 = iqFrontEnd.m12, m21 = iqFrontEnd.m21, m22 = iqFrontEnd.m22;
+  for (uint32_t i = 0; i < blocksize; i++) {
+    float32_t inI = (float32_t)I_in[i];
+    float32_t inQ = (float32_t)Q_in[i];
+    IQ_out[2 * i] = m11 * inI + m12 * inQ;
+    IQ_out[2 * i + 1] = m21 * inI + m22 * inQ;
+  }
+}
+
+/*****
+  Purpose: Apply the receive front end matrix to samples that are already float (+-1.0 full scale), in place.
+           Used for the IQ_REC_TEST signals.
+
+  Parameter list:
+    float32_t *IQ_buffer              samples to correct, interleaved I, Q
+    uint32_t blocksize                number of samples
+
+  Return value;
+    void
+*****/
+void IQFrontEndFloat(float32_t *IQ_buffer, uint32_t blocksize) {
+  const float32_t m11 = iqFrontEnd.m11 * 32768.0, m12 = iqFrontEnd.m12 * 32768.0;
+  const float32_t m21 = iqFrontEnd.m21 * 32768.0, m22 = iqFrontEnd.m22 * 32768.0;
+  for (uint32_t i = 0; i < blocksize; i++) {
+    float32_t inI = IQ_buffer[2 * i];
+    float32_t inQ = IQ_buffer[2 * i + 1];
+    IQ_buffer[2 * i] = m11 * inI + m12 * inQ;
+    IQ_buffer[2 * i + 1] = m21 * inI + m22 * inQ;
+  }
+}
+
 /*****
   Purpose: Calculate sinc function
 
@@ -0,0 +1,488 @@
+// Host build only: portable implementations of the CMSIS-DSP functions the
+// sketch calls. These mirror the CMSIS reference code paths (state layouts,
+// coefficient ordering, FFT scaling) rather than aiming for speed.
+#include <string.h>
+#include <math.h>
+#include <vector>
+#include <map>
+#include <complex>
+#include "arm_math.h"
+#include "arm_const_structs.h"
+
+#define CFFT_INSTANCE(n) const arm_cfft_instance_f32 arm_cfft_sR_f32_len##n = { n, 0, 0, 0 };
+CFFT_INSTANCE(16)
+CFFT_INSTANCE(32)
+CFFT_INSTANCE(64)
+CFFT_INSTANCE(128)
+CFFT_INSTANCE(256)
+CFFT_INSTANCE(512)
+CFFT_INSTANCE(1024)
+CFFT_INSTANCE(2048)
+CFFT_INSTANCE(4096)
+
+namespace {
+
+struct FFTPlan {
+  std::vector<float> cosTab, sinTab;
+  std::vector<uint32_t> bitRev;
+};
+
+const FFTPlan &GetPlan(uint32_t n) {
+  static std::map<uint32_t, FFTPlan> plans;
+  auto it = plans.find(n);
+  if (it != plans.end()) return it->second;
+  FFTPlan &p = plans[n];
+  p.cosTab.resize(n / 2);
+  p.sinTab.resize(n / 2);
+  for (uint32_t i = 0; i < n / 2; i++) {
+    p.cosTab[i] = (float)cos(2.0 * M_PI * i / n);
+    p.sinTab[i] = (float)sin(2.0 * M_PI * i / n);
+  }
+  uint32_t bits = 0;
+  while ((1u << bits) < n) bits++;
+  p.bitRev.resize(n);
+  for (uint32_t i = 0; i < n; i++) {
+    uint32_t r = 0;
+    for (uint32_t b = 0; b < bits; b++)
+      if (i & (1u << b)) r |= 1u << (bits - 1 - b);
+    p.bitRev[i] = r;
+  }
+  return p;
+}
+
+}  // namespace
+
+extern "C" {
+
+/*****
+  Radix-2 decimation-in-frequency FFT on interleaved complex data. The inverse
+  transform is scaled by 1/N like the CMSIS version.
+*****/
+void arm_cfft_f32(const arm_cfft_instance_f32 *S, float32_t *p1, uint8_t ifftFlag, uint8_t bitReverseFlag) {
+  const uint32_t n = S->fftLen;
+  const FFTPlan &plan = GetPlan(n);
+  const float sgn = ifftFlag ? 1.0f : -1.0f;
+
+  for (uint32_t half = n / 2, stride = 1; half >= 1; half >>= 1, stride <<= 1) {
+    for (uint32_t start = 0; start < n; start += 2 * half) {
+      for (uint32_t k = 0; k < half; k++) {
+        uint32_t a = start + k;
+        uint32_t b = a + half;
+        float ar = p1[2 * a], ai = p1[2 * a + 1];
+        float br = p1[2 * b], bi = p1[2 * b + 1];
+        p1[2 * a] = ar + br;
+        p1[2 * a + 1] = ai + bi;
+        float dr = ar - br;
+        float di = ai - bi;
+        float c = plan.cosTab[k * stride];
+        float s = sgn * plan.sinTab[k * stride];
+        p1[2 * b] = dr * c - di * s;
+        p1[2 * b + 1] = dr * s + di * c;
+      }
+    }
+  }
+
+  if (bitReverseFlag) {
+    for (uint32_t i = 0; i < n; i++) {
+      uint32_t r = plan.bitRev[i];
+      if (r > i) {
+        float tr = p1[2 * i], ti = p1[2 * i + 1];
+        p1[2 * i] = p1[2 * r];
+        p1[2 * i + 1] = p1[2 * r + 1];
+        p1[2 * r] = tr;
+        p1[2 * r + 1] = ti;
+      }
+    }
+  }
+
+  if (ifftFlag) {
+    const float inv = 1.0f / (float)n;
+    for (uint32_t i = 0; i < 2 * n; i++) p1[i] *= inv;
+  }
+}
+
+void arm_cmplx_mult_cmplx_f32(const float32_t *pSrcA, const float32_t *pSrcB, float32_t *pDst, uint32_t numSamples) {
+  for (uint32_t i = 0; i < numSamples; i++) {
+    float a = pSrcA[2 * i], b = pSrcA[2 * i + 1];
+    float c = pSrcB[2 * i], d = pSrcB[2 * i + 1];
+    pDst[2 * i] = a * c - b * d;
+    pDst[2 * i + 1] = a * d + b * c;
+  }
+}
+
+void arm_cmplx_mag_f32(const float32_t *pSrc, float32_t *pDst, uint32_t numSamples) {
+  for (uint32_t i = 0; i < numSamples; i++)
+    pDst[i] = sqrtf(pSrc[2 * i] * pSrc[2 * i] + pSrc[2 * i + 1] * pSrc[2 * i + 1]);
+}
+
+void arm_cmplx_mag_squared_f32(const float32_t *pSrc, float32_t *pDst, uint32_t numSamples) {
+  for (uint32_t i = 0; i < numSamples; i++)
+    pDst[i] = pSrc[2 * i] * pSrc[2 * i] + pSrc[2 * i + 1] * pSrc[2 * i + 1];
+}
+
+void arm_cmplx_mult_real_f32(const float32_t *pSrcCmplx, const float32_t *pSrcReal, float32_t *pCmplxDst, uint32_t numSamples) {
+  for (uint32_t i = 0; i < numSamples; i++) {
+    pCmplxDst[2 * i] = pSrcCmplx[2 * i] * pSrcReal[i];
+    pCmplxDst[2 * i + 1] = pSrcCmplx[2 * i + 1] * pSrcReal[i];
+  }
+}
+
+void arm_biquad_cascade_df2T_init_f32(arm_biquad_cascade_df2T_instance_f32 *S, uint8_t numStages, const float32_t *pCoeffs, float32_t *pState) {
+  S->numStages = numStages;
+  S->pCoeffs = pCoeffs;
+  S->pState = pState;
+  memset(pState, 0, 2u * numStages * sizeof(float32_t));
+}
+
+void arm_biquad_cascade_df2T_f32(const arm_biquad_cascade_df2T_instance_f32 *S, const float32_t *pSrc, float32_t *pDst, uint32_t blockSize) {
+  const float32_t *c = S->pCoeffs;
+  float32_t *st = S->pState;
+  const float32_t *in = pSrc;
+  for (uint32_t stage = 0; stage < S->numStages; stage++) {
+    float b0 = c[0], b1 = c[1], b2 = c[2], a1 = c[3], a2 = c[4];
+    float d1 = st[0], d2 = st[1];
+    for (uint32_t i = 0; i < blockSize; i++) {
+      float x = in[i];
+      float y = b0 * x + d1;
+      d1 = b1 * x + a1 * y + d2;
+      d2 = b2 * x + a2 * y;
+      pDst[i] = y;
+    }
+    st[0] = d1;
+    st[1] = d2;
+    c += 5;
+    st += 2;
+    in = pDst;
+  }
+}
+
+void arm_biquad_cascade_df1_init_f32(arm_biquad_casd_df1_inst_f32 *S, uint8_t numStages, const float32_t *pCoeffs, float32_t *pState) {
+  S->numStages = numStages;
+  S->pCoeffs = pCoeffs;
+  S->pState = pState;
+  memset(pState, 0, 4u * numStages * sizeof(float32_t));
+}
+
+void arm_biquad_cascade_df1_f32(const arm_biquad_casd_df1_inst_f32 *S, const float32_t *pSrc, float32_t *pDst, uint32_t blockSize) {
+  const float32_t *c = S->pCoeffs;
+  float32_t *st = S->pState;
+  const float32_t *in = pSrc;
+  for (uint32_t stage = 0; stage < S->numStages; stage++) {
+    float b0 = c[0], b1 = c[1], b2 = c[2], a1 = c[3], a2 = c[4];
+    float x1 = st[0], x2 = st[1], y1 = st[2], y2 = st[3];
+    for (uint32_t i = 0; i < blockSize; i++) {
+      float x = in[i];
+      float y = b0 * x + b1 * x1 + b2 * x2 + a1 * y1 + a2 * y2;
+      x2 = x1;
+      x1 = x;
+      y2 = y1;
+      y1 = y;
+      pDst[i] = y;
+    }
+    st[0] = x1;
+    st[1] = x2;
+    st[2] = y1;
+    st[3] = y2;
+    c += 5;
+    st += 4;
+    in = pDst;
+  }
+}
+
+void arm_fir_init_f32(arm_fir_instance_f32 *S, uint16_t numTaps, const float32_t *pCoeffs, float32_t *pState, uint32_t blockSize) {
+  S->numTaps = numTaps;
+  S->pCoeffs = pCoeffs;
+  S->pState = pState;
+  memset(pState, 0, (numTaps + blockSize - 1u) * sizeof(float32_t));
+}
+
+void arm_fir_f32(const arm_fir_instance_f32 *S, const float32_t *pSrc, float32_t *pDst, uint32_t blockSize) {
+  const uint32_t numTaps = S->numTaps;
+  float32_t *state = S->pState;
+  memcpy(state + numTaps - 1, pSrc, blockSize * sizeof(float32_t));
+  for (uint32_t n = 0; n < blockSize; n++) {
+    float acc = 0.0f;
+    const float32_t *px = state + n;
+    for (uint32_t k = 0; k < numTaps; k++) acc += px[k] * S->pCoeffs[k];
+    pDst[n] = acc;
+  }
+  memmove(state, state + blockSize, (numTaps - 1) * sizeof(float32_t));
+}
+
+arm_status arm_fir_decimate_init_f32(arm_fir_decimate_instance_f32 *S, uint16_t numTaps, uint8_t M, const float32_t *pCoeffs, float32_t *pState, uint32_t blockSize) {
+  if ((blockSize % M) != 0) return ARM_MATH_LENGTH_ERROR;
+  S->numTaps = numTaps;
+  S->pCoeffs = pCoeffs;
+  S->M = M;
+  S->pState = pState;
+  memset(pState, 0, (numTaps + blockSize - 1u) * sizeof(float32_t));
+  return ARM_MATH_SUCCESS;
+}
+
+void arm_fir_decimate_f32(const arm_fir_decimate_instance_f32 *S, const float32_t *pSrc, float32_t *pDst, uint32_t blockSize) {
+  const uint32_t numTaps = S->numTaps;
+  const uint32_t M = S->M;
+  float32_t *state = S->pState;
+  float32_t *cur = state + numTaps - 1;
+  float32_t *ps = state;
+  for (uint32_t blk = blockSize / M; blk > 0; blk--) {
+    for (uint32_t i = 0; i < M; i++) *cur++ = *pSrc++;
+    float acc = 0.0f;
+    for (uint32_t k = 0; k < numTaps; k++) acc += S->pCoeffs[k] * ps[k];
+    ps += M;
+    *pDst++ = acc;
+  }
+  memmove(state, ps, (numTaps - 1) * sizeof(float32_t));
+}
+
+arm_status arm_fir_interpolate_init_f32(arm_fir_interpolate_instance_f32 *S, uint8_t L, uint16_t numTaps, const float32_t *pCoeffs, float32_t *pState, uint32_t blockSize) {
+  if ((numTaps % L) != 0) return ARM_MATH_LENGTH_ERROR;
+  S->L = L;
+  S->pCoeffs = pCoeffs;
+  S->phaseLength = numTaps / L;
+  S->pState = pState;
+  memset(pState, 0, (blockSize + S->phaseLength - 1u) * sizeof(float32_t));
+  return ARM_MATH_SUCCESS;
+}
+
+void arm_fir_interpolate_f32(const arm_fir_interpolate_instance_f32 *S, const float32_t *pSrc, float32_t *pDst, uint32_t blockSize) {
+  const uint32_t phaseLen = S->phaseLength;
+  const uint32_t L = S->L;
+  float32_t *state = S->pState;
+  float32_t *cur = state + phaseLen - 1;
+  float32_t *ps = state;
+  for (uint32_t blk = 0; blk < blockSize; blk++) {
+    *cur++ = *pSrc++;
+    for (uint32_t j = 1; j <= L; j++) {
+      float acc = 0.0f;
+      const float32_t *pc = S->pCoeffs + (L - j);
+      for (uint32_t k = 0; k < phaseLen; k++) acc += ps[k] * pc[k * L];
+      *pDst++ = acc;
+    }
+    ps++;
+  }
+  memmove(state, ps, (phaseLen - 1) * sizeof(float32_t));
+}
+
+void arm_lms_init_f32(arm_lms_instance_f32 *S, uint16_t numTaps, float32_t *pCoeffs, float32_t *pState, float32_t mu, uint32_t blockSize) {
+  S->numTaps = numTaps;
+  S->pCoeffs = pCoeffs;
+  S->pState = pState;
+  S->mu = mu;
+  memset(pState, 0, (numTaps + blockSize - 1u) * sizeof(float32_t));
+}
+
+void arm_lms_f32(const arm_lms_instance_f32 *S, const float32_t *pSrc, float32_t *pRef, float32_t *pOut, float32_t *pErr, uint32_t blockSize) {
+  const uint32_t numTaps = S->numTaps;
+  float32_t *state = S->pState;
+  float32_t *cur = state + numTaps - 1;
+  float32_t *ps = state;
+  for (uint32_t n = 0; n < blockSize; n++) {
+    *cur++ = *pSrc++;
+    float acc = 0.0f;
+    for (uint32_t k = 0; k < numTaps; k++) acc += S->pCoeffs[k] * ps[k];
+    *pOut++ = acc;
+    float e = *pRef++ - acc;
+    *pErr++ = e;
+    float w = e * S->mu;
+    for (uint32_t k = 0; k < numTaps; k++) S->pCoeffs[k] += w * ps[k];
+    ps++;
+  }
+  memmove(state, ps, (numTaps - 1) * sizeof(float32_t));
+}
+
+void arm_lms_norm_init_f32(arm_lms_norm_instance_f32 *S, uint16_t numTaps, float32_t *pCoeffs, float32_t *pState, float32_t mu, uint32_t blockSize) {
+  S->numTaps = numTaps;
+  S->pCoeffs = pCoeffs;
+  S->pState = pState;
+  S->mu = mu;
+  S->energy = 0.0f;
+  S->x0 = 0.0f;
+  memset(pState, 0, (numTaps + blockSize - 1u) * sizeof(float32_t));
+}
+
+void arm_lms_norm_f32(arm_lms_norm_instance_f32 *S, const float32_t *pSrc, float32_t *pRef, float32_t *pOut, float32_t *pErr, uint32_t blockSize) {
+  const uint32_t numTaps = S->numTaps;
+  float32_t *state = S->pState;
+  float32_t *cur = state + numTaps - 1;
+  float32_t *ps = state;
+  float energy = S->energy;
+  float x0 = S->x0;
+  for (uint32_t n = 0; n < blockSize; n++) {
+    *cur++ = *pSrc;
+    float in = *pSrc++;
+    energy -= x0 * x0;
+    energy += in * in;
+    float acc = 0.0f;
+    for (uint32_t k = 0; k < numTaps; k++) acc += S->pCoeffs[k] * ps[k];
+    *pOut++ = acc;
+    float e = *pRef++ - acc;
+    *pErr++ = e;
+    float w = e * S->mu / (energy + 0.000000119209289f);
+    for (uint32_t k = 0; k < numTaps; k++) S->pCoeffs[k] += w * ps[k];
+    x0 = *ps;
+    ps++;
+  }
+  S->energy = energy;
+  S->x0 = x0;
+  memmove(state, ps, (numTaps - 1) * sizeof(float32_t));
+}
+
+void arm_scale_f32(const float32_t *pSrc, float32_t scale, float32_t *pDst, uint32_t blockSize) {
+  for (uint32_t i = 0; i < blockSize; i++) pDst[i] = pSrc[i] * scale;
+}
+
+void arm_add_f32(const float32_t *pSrcA, const float32_t *pSrcB, float32_t *pDst, uint32_t blockSize) {
+  for (uint32_t i = 0; i < blockSize; i++) pDst[i] = pSrcA[i] + pSrcB[i];
+}
+
+void arm_sub_f32(const float32_t *pSrcA, const float32_t *pSrcB, float32_t *pDst, uint32_t blockSize) {
+  for (uint32_t i = 0; i < blockSize; i++) pDst[i] = pSrcA[i] - pSrcB[i];
+}
+
+void arm_mult_f32(const float32_t *pSrcA, const float32_t *pSrcB, float32_t *pDst, uint32_t blockSize) {
+  for (uint32_t i = 0; i < blockSize; i++) pDst[i] = pSrcA[i] * pSrcB[i];
+}
+
+void arm_offset_f32(const float32_t *pSrc, float32_t offset, float32_t *pDst, uint32_t blockSize) {
+  for (uint32_t i = 0; i < blockSize; i++) pDst[i] = pSrc[i] + offset;
+}
+
+void arm_negate_f32(const float32_t *pSrc, float32_t *pDst, uint32_t blockSize) {
+  for (uint32_t i = 0; i < blockSize; i++) pDst[i] = -pSrc[i];
+}
+
+void arm_abs_f32(const float32_t *pSrc, float32_t *pDst, uint32_t blockSize) {
+  for (uint32_t i = 0; i < blockSize; i++) pDst[i] = fabsf(pSrc[i]);
+}
+
+void arm_copy_f32(const float32_t *pSrc, float32_t *pDst, uint32_t blockSize) {
+  memmove(pDst, pSrc, blockSize * sizeof(float32_t));
+}
+
+void arm_copy_q15(const q15_t *pSrc, q15_t *pDst, uint32_t blockSize) {
+  memmove(pDst, pSrc, blockSize * sizeof(q15_t));
+}
+
+void arm_fill_f32(float32_t value, float32_t *pDst, uint32_t blockSize) {
+  for (uint32_t i = 0; i < blockSize; i++) pDst[i] = value;
+}
+
+void arm_dot_prod_f32(const float32_t *pSrcA, const float32_t *pSrcB, uint32_t blockSize, float32_t *result) {
+  float acc = 0.0f;
+  for (uint32_t i = 0; i < blockSize; i++) acc += pSrcA[i] * pSrcB[i];
+  *result = acc;
+}
+
+void arm_max_f32(const float32_t *pSrc, uint32_t blockSize, float32_t *pResult, uint32_t *pIndex) {
+  float m = pSrc[0];
+  uint32_t idx = 0;
+  for (uint32_t i = 1; i < blockSize; i++)
+    if (pSrc[i] > m) {
+      m = pSrc[i];
+      idx = i;
+    }
+  *pResult = m;
+  *pIndex = idx;
+}
+
+void arm_min_f32(const float32_t *pSrc, uint32_t blockSize, float32_t *pResult, uint32_t *pIndex) {
+  float m = pSrc[0];
+  uint32_t idx = 0;
+  for (uint32_t i = 1; i < blockSize; i++)
+    if (pSrc[i] < m) {
+      m = pSrc[i];
+      idx = i;
+    }
+  *pResult = m;
+  *pIndex = idx;
+}
+
+void arm_max_q15(const q15_t *pSrc, uint32_t blockSize, q15_t *pResult, uint32_t *pIndex) {
+  q15_t m = pSrc[0];
+  uint32_t idx = 0;
+  for (uint32_t i = 1; i < blockSize; i++)
+    if (pSrc[i] > m) {
+      m = pSrc[i];
+      idx = i;
+    }
+  *pResult = m;
+  *pIndex = idx;
+}
+
+void arm_mean_f32(const float32_t *pSrc, uint32_t blockSize, float32_t *pResult) {
+  float acc = 0.0f;
+  for (uint32_t i = 0; i < blockSize; i++) acc += pSrc[i];
+  *pResult = acc / (float)blockSize;
+}
+
+void arm_var_f32(const float32_t *pSrc, uint32_t blockSize, float32_t *pResult) {
+  if (blockSize <= 1) {
+    *pResult = 0.0f;
+    return;
+  }
+  float mean;
+  arm_mean_f32(pSrc, blockSize, &mean);
+  float acc = 0.0f;
+  for (uint32_t i = 0; i < blockSize; i++) acc += (pSrc[i] - mean) * (pSrc[i] - mean);
+  *pResult = acc / (float)(blockSize - 1);
+}
+
+void arm_std_f32(const float32_t *pSrc, uint32_t blockSize, float32_t *pResult) {
+  float var;
+  arm_var_f32(pSrc, blockSize, &var);
+  *pResult = sqrtf(var);
+}
+
+void arm_rms_f32(const float32_t *pSrc, uint32_t blockSize, float32_t *pResult) {
+  float acc;
+  arm_power_f32(pSrc, blockSize, &acc);
+  *pResult = sqrtf(acc / (float)blockSize);
+}
+
+void arm_power_f32(const float32_t *pSrc, uint32_t blockSize, float32_t *pResult) {
+  float acc = 0.0f;
+  for (uint32_t i = 0; i < blockSize; i++) acc += pSrc[i] * pSrc[i];
+  *pResult = acc;
+}
+
+void arm_q15_to_float(const q15_t *pSrc, float32_t *pDst, uint32_t blockSize) {
+  for (uint32_t i = 0; i < blockSize; i++) pDst[i] = (float32_t)pSrc[i] / 32768.0f;
+}
+
+void arm_float_to_q15(const float32_t *pSrc, q15_t *pDst, uint32_t blockSize) {
+  for (uint32_t i = 0; i < blockSize; i++) {
+    float v = pSrc[i] * 32768.0f;
+    int32_t q = (v >= 2147483647.0f) ? INT32_MAX : (v <= -2147483648.0f) ? INT32_MIN : (int32_t)v;
+    if (q > 32767) q = 32767;
+    if (q < -32768) q = -32768;
+    pDst[i] = (q15_t)q;
+  }
+}
+
+float32_t arm_sin_f32(float32_t x) {
+  return sinf(x);
+}
+
+float32_t arm_cos_f32(float32_t x) {
+  return cosf(x);
+}
+
+/*****
+  Cross-correlation, output length 2 * max(srcALen, srcBLen) - 1 like CMSIS.
+  Output index i corresponds to lag (i - (srcBLen - 1)).
+*****/
+void arm_correlate_f32(const float32_t *pSrcA, uint32_t srcALen, const float32_t *pSrcB, uint32_t srcBLen, float32_t *pDst) {
+  const uint32_t outLen = 2 * (srcALen > srcBLen ? srcALen : srcBLen) - 1;
+  for (uint32_t i = 0; i < outLen; i++) {
+    int32_t lag = (int32_t)i - (int32_t)(srcBLen - 1);
+    float acc = 0.0f;
+    for (uint32_t k = 0; k < srcBLen; k++) {
+      int32_t a = lag + (int32_t)k;
+      if (a >= 0 && a < (int32_t)srcALen) acc += pSrcA[a] * pSrcB[k];
+    }
+    pDst[i] = acc;
+  }
+}
+
+}  // extern "C"
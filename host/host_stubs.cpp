@@ -0,0 +1,234 @@
+// Host build only: definitions behind the shim headers. Hardware calls are
+// no-ops, time comes from std::chrono, and registers are plain memory.
+#include <Arduino.h>
+#include <chrono>
+#include <OpenAudio_ArduinoLibrary.h>
+#include <TimeLib.h>
+#include <Wire.h>
+#include <SPI.h>
+#include <SD.h>
+#include <EEPROM.h>
+#include <utility/imxrt_hw.h>
+
+HostSerial Serial(stderr);
+HostSerial SerialUSB1(nullptr);
+HostSerial Serial1(nullptr);
+CrashReportClass CrashReport;
+TwoWire Wire;
+TwoWire Wire1;
+TwoWire Wire2;
+SPIClass SPI;
+SDClass SD;
+EEPROMClass EEPROM;
+teensy3_clock_class Teensy3Clock;
+
+// Heap markers the sketch's DEBUG free-RAM report reads.
+unsigned long _heap_start;
+unsigned long _heap_end;
+char *__brkval = (char *)&_heap_end;
+
+namespace {
+const auto hostEpoch = std::chrono::steady_clock::now();
+volatile uint32_t hostRegisters[64];
+volatile uint32_t hostPadRegisters[64];
+time_t hostTimeOffset = 0;
+uint64_t hostSkippedNanos = 0;  // delay() advances the clock instead of sleeping
+
+uint64_t HostNanos() {
+  return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - hostEpoch).count() + hostSkippedNanos;
+}
+}  // namespace
+
+#define PIN_ENTRY(n) { nullptr, nullptr, &hostPadRegisters[n], 0 }
+const struct digital_pin_bitband_and_config_table_struct digital_pin_to_info_PGM[] = {
+  PIN_ENTRY(0), PIN_ENTRY(1), PIN_ENTRY(2), PIN_ENTRY(3), PIN_ENTRY(4), PIN_ENTRY(5), PIN_ENTRY(6), PIN_ENTRY(7),
+  PIN_ENTRY(8), PIN_ENTRY(9), PIN_ENTRY(10), PIN_ENTRY(11), PIN_ENTRY(12), PIN_ENTRY(13), PIN_ENTRY(14), PIN_ENTRY(15),
+  PIN_ENTRY(16), PIN_ENTRY(17), PIN_ENTRY(18), PIN_ENTRY(19), PIN_ENTRY(20), PIN_ENTRY(21), PIN_ENTRY(22), PIN_ENTRY(23),
+  PIN_ENTRY(24), PIN_ENTRY(25), PIN_ENTRY(26), PIN_ENTRY(27), PIN_ENTRY(28), PIN_ENTRY(29), PIN_ENTRY(30), PIN_ENTRY(31),
+  PIN_ENTRY(32), PIN_ENTRY(33), PIN_ENTRY(34), PIN_ENTRY(35), PIN_ENTRY(36), PIN_ENTRY(37), PIN_ENTRY(38), PIN_ENTRY(39),
+  PIN_ENTRY(40), PIN_ENTRY(41), PIN_ENTRY(42), PIN_ENTRY(43), PIN_ENTRY(44), PIN_ENTRY(45), PIN_ENTRY(46), PIN_ENTRY(47),
+  PIN_ENTRY(48), PIN_ENTRY(49), PIN_ENTRY(50), PIN_ENTRY(51), PIN_ENTRY(52), PIN_ENTRY(53), PIN_ENTRY(54), PIN_ENTRY(55),
+};
+
+volatile uint32_t *host_reg32(int index) {
+  return &hostRegisters[index & 63];
+}
+
+uint32_t host_cycle_count(void) {
+  return (uint32_t)(HostNanos() * 528 / 1000);  // F_CPU_ACTUAL
+}
+
+uint32_t millis(void) {
+  return (uint32_t)(HostNanos() / 1000000ULL);
+}
+
+uint32_t micros(void) {
+  return (uint32_t)(HostNanos() / 1000ULL);
+}
+
+void delay(uint32_t msec) {
+  hostSkippedNanos += (uint64_t)msec * 1000000ULL;
+}
+
+void delayMicroseconds(uint32_t usec) {
+  hostSkippedNanos += (uint64_t)usec * 1000ULL;
+}
+
+void yield(void) {}
+void pinMode(uint8_t, uint8_t) {}
+void digitalWrite(uint8_t, uint8_t) {}
+uint8_t digitalRead(uint8_t) {
+  return HIGH;  // Buttons released, PTT and paddles open.
+}
+void digitalToggle(uint8_t) {}
+int analogRead(uint8_t) {
+  return 1023;  // No push button pressed.
+}
+void analogWrite(uint8_t, int) {}
+void analogReadResolution(unsigned int) {}
+void analogWriteResolution(unsigned int) {}
+void attachInterrupt(uint8_t, void (*)(void), int) {}
+void detachInterrupt(uint8_t) {}
+void __disable_irq(void) {}
+void __enable_irq(void) {}
+
+long random(long howbig) {
+  return howbig > 0 ? rand() % howbig : 0;
+}
+
+long random(long howsmall, long howbig) {
+  return howsmall >= howbig ? howsmall : howsmall + random(howbig - howsmall);
+}
+
+void randomSeed(unsigned long seed) {
+  srand((unsigned)seed);
+}
+
+long map(long x, long in_min, long in_max, long out_min, long out_max) {
+  if (in_max == in_min) return out_min;
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+float tempmonGetTemp(void) {
+  return 40.0f;
+}
+
+extern "C" uint32_t set_arm_clock(uint32_t frequency) {
+  return frequency;
+}
+
+void set_audioClock(int, int32_t, uint32_t, bool) {}
+
+char *dtostrf(double val, int width, unsigned int precision, char *buf) {
+  sprintf(buf, "%*.*f", width, precision, val);
+  return buf;
+}
+
+static char *ToBase(unsigned long v, char *s, int radix, bool negative) {
+  char tmp[66];
+  int i = 0;
+  if (radix < 2 || radix > 36) radix = 10;
+  do {
+    int d = (int)(v % radix);
+    tmp[i++] = (char)(d < 10 ? '0' + d : 'a' + d - 10);
+    v /= radix;
+  } while (v);
+  char *p = s;
+  if (negative) *p++ = '-';
+  while (i) *p++ = tmp[--i];
+  *p = 0;
+  return s;
+}
+
+char *itoa(int val, char *s, int radix) {
+  return ltoa(val, s, radix);
+}
+
+char *ltoa(long val, char *s, int radix) {
+  bool negative = (radix == 10 && val < 0);
+  return ToBase(negative ? -(unsigned long)val : (unsigned long)val, s, radix, negative);
+}
+
+char *ultoa(unsigned long val, char *s, int radix) {
+  return ToBase(val, s, radix, false);
+}
+
+#if !defined(__GLIBC_PREREQ) || !__GLIBC_PREREQ(2, 38)
+size_t strlcpy(char *dst, const char *src, size_t size) {
+  size_t len = strlen(src);
+  if (size) {
+    size_t n = len >= size ? size - 1 : len;
+    memcpy(dst, src, n);
+    dst[n] = 0;
+  }
+  return len;
+}
+#endif
+
+void AudioMemory(int) {}
+void AudioMemory_F32(int) {}
+int AudioMemoryUsage(void) {
+  return 0;
+}
+int AudioMemoryUsageMax(void) {
+  return 0;
+}
+void AudioMemoryUsageMaxReset(void) {}
+float AudioProcessorUsage(void) {
+  return 0.0f;
+}
+float AudioProcessorUsageMax(void) {
+  return 0.0f;
+}
+
+void setSyncProvider(getExternalTime) {}
+
+void setTime(time_t t) {
+  hostTimeOffset = t - time(nullptr);
+}
+
+time_t now(void) {
+  return time(nullptr) + hostTimeOffset;
+}
+
+static struct tm HostTm(time_t t) {
+  struct tm out;
+  gmtime_r(&t, &out);
+  return out;
+}
+
+int hour(time_t t) {
+  return HostTm(t).tm_hour;
+}
+int hour(void) {
+  return hour(now());
+}
+int minute(time_t t) {
+  return HostTm(t).tm_min;
+}
+int minute(void) {
+  return minute(now());
+}
+int second(time_t t) {
+  return HostTm(t).tm_sec;
+}
+int second(void) {
+  return second(now());
+}
+int day(void) {
+  return HostTm(now()).tm_mday;
+}
+int month(void) {
+  return HostTm(now()).tm_mon + 1;
+}
+int year(void) {
+  return HostTm(now()).tm_year + 1900;
+}
+
+unsigned long teensy3_clock_class::get(void) {
+  return (unsigned long)now();
+}
+
+void teensy3_clock_class::set(unsigned long t) {
+  setTime((time_t)t);
+}
@@ -0,0 +1,551 @@
+// Host build only: runs the sketch's receive chain on a recorded IQ file.
+//
+//   iq_runner [options] <in.wav> <out.wav>
+//
+// <in.wav> is 16-bit stereo PCM at 192 kSPS with I on the left channel and Q
+// on the right, i.e. what the T41 QSD delivers to the codec. The audio that
+// ProcessIQData() hands to Q_out_L/Q_out_R is written to <out.wav> (16-bit
+// stereo, 192 kSPS). Timing of every ProcessIQData() call is reported on
+// stdout; the sketch's own Serial output goes to stderr.
+#include "SDT.h"
+#include <getopt.h>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <algorithm>
+
+void setup();
+
+namespace {
+
+const uint32_t kSampleRate = 192000;
+
+struct WavData {
+  uint32_t sampleRate = kSampleRate;
+  std::vector<int16_t> left;
+  std::vector<int16_t> right;
+};
+
+uint32_t ReadLE32(const uint8_t *p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+uint16_t ReadLE16(const uint8_t *p) {
+  return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+void WriteLE32(FILE *f, uint32_t v) {
+  uint8_t b[4] = { (uint8_t)v, (uint8_t)(v >> 8), (uint8_t)(v >> 16), (uint8_t)(v >> 24) };
+  fwrite(b, 1, 4, f);
+}
+
+void WriteLE16(FILE *f, uint16_t v) {
+  uint8_t b[2] = { (uint8_t)v, (uint8_t)(v >> 8) };
+  fwrite(b, 1, 2, f);
+}
+
+bool ReadWav(const char *path, WavData &wav) {
+  FILE *f = fopen(path, "rb");
+  if (!f) {
+    fprintf(stderr, "iq_runner: cannot open %s\n", path);
+    return false;
+  }
+  uint8_t hdr[12];
+  if (fread(hdr, 1, 12, f) != 12 || memcmp(hdr, "RIFF", 4) || memcmp(hdr + 8, "WAVE", 4)) {
+    fprintf(stderr, "iq_runner: %s is not a RIFF/WAVE file\n", path);
+    fclose(f);
+    return false;
+  }
+  uint16_t channels = 0, bits = 0;
+  bool haveFmt = false;
+  uint8_t chunk[8];
+  while (fread(chunk, 1, 8, f) == 8) {
+    uint32_t size = ReadLE32(chunk + 4);
+    if (!memcmp(chunk, "fmt ", 4)) {
+      std::vector<uint8_t> fmt(size);
+      if (fread(fmt.data(), 1, size, f) != size || size < 16) break;
+      if (ReadLE16(&fmt[0]) != 1) {
+        fprintf(stderr, "iq_runner: %s is not PCM\n", path);
+        break;
+      }
+      channels = ReadLE16(&fmt[2]);
+      wav.sampleRate = ReadLE32(&fmt[4]);
+      bits = ReadLE16(&fmt[14]);
+      haveFmt = true;
+    } else if (!memcmp(chunk, "data", 4)) {
+      if (!haveFmt || channels != 2 || bits != 16) {
+        fprintf(stderr, "iq_runner: %s must be 16-bit stereo PCM\n", path);
+        break;
+      }
+      std::vector<int16_t> raw(size / 2);
+      size_t got = fread(raw.data(), 2, raw.size(), f);
+      wav.left.resize(got / 2);
+      wav.right.resize(got / 2);
+      for (size_t i = 0; i < got / 2; i++) {
+        wav.left[i] = raw[2 * i];
+        wav.right[i] = raw[2 * i + 1];
+      }
+      fclose(f);
+      return true;
+    } else {
+      fseek(f, size + (size & 1), SEEK_CUR);
+    }
+  }
+  fclose(f);
+  fprintf(stderr, "iq_runner: no usable data chunk in %s\n", path);
+  return false;
+}
+
+bool WriteWav(const char *path, const WavData &wav) {
+  FILE *f = fopen(path, "wb");
+  if (!f) {
+    fprintf(stderr, "iq_runner: cannot create %s\n", path);
+    return false;
+  }
+  uint32_t dataBytes = (uint32_t)(wav.left.size() * 4);
+  fwrite("RIFF", 1, 4, f);
+  WriteLE32(f, 36 + dataBytes);
+  fwrite("WAVEfmt ", 1, 8, f);
+  WriteLE32(f, 16);
+  WriteLE16(f, 1);
+  WriteLE16(f, 2);
+  WriteLE32(f, wav.sampleRate);
+  WriteLE32(f, wav.sampleRate * 4);
+  WriteLE16(f, 4);
+  WriteLE16(f, 16);
+  fwrite("data", 1, 4, f);
+  WriteLE32(f, dataBytes);
+  for (size_t i = 0; i < wav.left.size(); i++) {
+    WriteLE16(f, (uint16_t)wav.left[i]);
+    WriteLE16(f, (uint16_t)wav.right[i]);
+  }
+  fclose(f);
+  return true;
+}
+
+/*****
+  Writes a synthetic IQ test file: a complex tone at offsetHz (relative to the
+  QSD centre, so +48000 lands in the receive passband centre) in white noise.
+*****/
+bool GenerateTone(const char *path, double offsetHz, double seconds, double tone_dBFS, double noise_dBFS) {
+  WavData wav;
+  size_t n = (size_t)(seconds * kSampleRate);
+  wav.left.resize(n);
+  wav.right.resize(n);
+  double a = pow(10.0, tone_dBFS / 20.0) * 32767.0;
+  double sigma = pow(10.0, noise_dBFS / 20.0) * 32767.0;
+  srand(1);
+  for (size_t i = 0; i < n; i++) {
+    double ph = 2.0 * M_PI * offsetHz * (double)i / kSampleRate;
+    double u1 = (rand() + 1.0) / (RAND_MAX + 2.0), u2 = (rand() + 1.0) / (RAND_MAX + 2.0);
+    double r = sqrt(-2.0 * log(u1));
+    double ni = sigma * r * cos(2.0 * M_PI * u2), nq = sigma * r * sin(2.0 * M_PI * u2);
+    wav.left[i] = (int16_t)std::max(-32768.0, std::min(32767.0, a * cos(ph) + ni));
+    wav.right[i] = (int16_t)std::max(-32768.0, std::min(32767.0, a * sin(ph) + nq));
+  }
+  return WriteWav(path, wav);
+}
+
+/*****
+  Runs FreqShift2() on a constant 1 + j0 input so its output is the receive
+  NCO itself, and compares that with an exact (double) complex exponential at
+  Fs/4 - fineHz.  The rms error relative to the carrier bounds every spur.
+*****/
+int NcoAccuracy(long fineHz, int blockCount) {
+  const uint32_t n = BUFFER_SIZE * N_BLOCKS;
+  const double gain = 1.1 * sqrt(0.95);
+  // The NCO frequency resolution is Fs / 2^32; use the same increment so the
+  // reference does not slowly walk away from it.
+  const uint32_t phaseInc = (uint32_t)(int64_t)llround((kSampleRate / 4.0 - (double)fineHz) * 4294967296.0 / kSampleRate);
+  uint32_t phase = 0;
+  double maxErr = 0, sumErr = 0;
+  uint64_t k = 0;
+
+  xmtMode = SSB_MODE;
+  NCOFreq = fineHz;
+  ncoPhase = 0;
+  std::vector<float32_t> iq(2 * n);
+  for (int b = 0; b < blockCount; b++) {
+    for (uint32_t i = 0; i < n; i++) {
+      iq[2 * i] = 1.0;
+      iq[2 * i + 1] = 0.0;
+    }
+    FreqShift2(iq.data(), n);
+    for (uint32_t i = 0; i < n; i++, k++) {
+      double ph = (double)phase * (2.0 * M_PI / 4294967296.0);
+      phase += phaseInc;
+      double dI = iq[2 * i] - gain * cos(ph);
+      double dQ = iq[2 * i + 1] - gain * sin(ph);
+      double e = dI * dI + dQ * dQ;
+      maxErr = std::max(maxErr, e);
+      sumErr += e;
+    }
+  }
+  double carrier = gain * gain;
+  printf("NCO at Fs/4 - %ld Hz, %llu samples\n", fineHz, (unsigned long long)k);
+  printf("  max error %.1f dBc, rms error %.1f dBc\n", 10.0 * log10(maxErr / carrier + 1e-30),
+         10.0 * log10(sumErr / k / carrier + 1e-30));
+  return 0;
+}
+
+/*****
+  Reads comma separated equalizer band levels; bands not given keep their value.
+*****/
+void ParseEqualizer(const std::string &arg, int *levels) {
+  int band = 0;
+  for (const char *p = arg.c_str(); *p && band < EQUALIZER_CELL_COUNT; band++) {
+    levels[band] = atoi(p);
+    p = strchr(p, ',');
+    if (!p) break;
+    p++;
+  }
+}
+
+/*****
+  Feeds tones through SSBModulate() and measures the wanted (positive) and
+  opposite (negative) sideband in its I/Q output, the transmit counterpart of
+  NcoAccuracy().
+*****/
+int SsbResponse() {
+  const double rate = kSampleRate / 8.0;
+  const double amplitude = 0.1;
+  const int settle = 4, blocks = 64;
+  const double freqs[] = { 50, 100, 150, 200, 250, 300, 500, 1000, 2000, 2500, 2800, 3000, 3200, 3500, 5000 };
+  float32_t I[256], Q[256];
+
+  printf("SSB modulator, %s\n", xmitEQFlag == ON ? "transmit EQ on" : "transmit EQ off");
+  printf("  freq Hz   gain dB   opposite sideband dBc\n");
+  for (double f : freqs) {
+    InitSSBModulator();
+    double w = 2.0 * M_PI * f / rate;
+    double posRe = 0, posIm = 0, negRe = 0, negIm = 0;
+    uint64_t k = 0;
+    for (int b = 0; b < settle + blocks; b++) {
+      for (int i = 0; i < 256; i++) I[i] = amplitude * cos(w * (double)(b * 256 + i));
+      SSBModulate(I, Q);
+      if (b < settle) continue;
+      for (int i = 0; i < 256; i++, k++) {
+        double ph = w * (double)(b * 256 + i);
+        double c = cos(ph), s = sin(ph);
+        posRe += I[i] * c + Q[i] * s;  // z * e^-jwt
+        posIm += Q[i] * c - I[i] * s;
+        negRe += I[i] * c - Q[i] * s;  // z * e^+jwt
+        negIm += Q[i] * c + I[i] * s;
+      }
+    }
+    double pos = hypot(posRe, posIm) / k, neg = hypot(negRe, negIm) / k;
+    printf("  %7.0f   %7.1f   %7.1f\n", f, 20.0 * log10(pos / amplitude + 1e-30), 20.0 * log10(neg / pos + 1e-30));
+  }
+  return 0;
+}
+
+void Usage() {
+  fprintf(stderr,
+          "usage: iq_runner [options] <in.wav> <out.wav>\n"
+          "       iq_runner --gen <offsetHz>:<seconds>[:<tone_dBFS>[:<noise_dBFS>]] <out.wav>\n"
+          "       iq_runner --nco <fineHz>     check the receive NCO against an exact oscillator\n"
+          "       iq_runner --ssb [-e ...]     tone response of the transmit SSB modulator\n"
+          "options:\n"
+          "  -m, --mode usb|lsb|am|sam    demodulation mode (default usb); sam-lsb and sam-usb\n"
+          "                               keep one sideband of the SAM detector\n"
+          "  -b, --bw <lo>:<hi>           filter edges in Hz (FLoCut:FHiCut)\n"
+          "  -f, --fine <Hz>              fine tune offset (NCOFreq)\n"
+          "  -n, --nr <0..4>              noise reduction (NR_Index)\n"
+          "  -a, --notch                  automatic notch on (ANR_notchOn)\n"
+          "  -B, --blanker <ratio>        RF impulse blanker on with this threshold (NB_RF_thresh)\n"
+          "  -k, --skim                   run the CW skimmer and list what it decoded\n"
+          "  -c, --cw                     CW receive with the decoder on; print the decoded text\n"
+          "  -v, --volume <0..100>        audioVolume\n"
+          "  -L, --latency <mode>         normal|low|lowest receive block of 2048, 512 or 256 samples\n"
+          "                               (rxLatencyMode)\n"
+          "  -C, --conv <fft>[:<taps>]    receive convolution FFT size and filter length; standard,\n"
+          "                               efficient and sharp are the SetRxConvMode() sizes\n"
+          "  -w, --sweep <calls>          move the outer filter edge 100 Hz every <calls> ProcessIQData()\n"
+          "                               calls, up and down over 1 kHz, as a turning filter knob does\n"
+          "  -e, --eq <g1>,...,<g14>      turn the receive EQ on with these band levels (100 = flat);\n"
+          "                               with --ssb, the transmit EQ levels instead\n"
+          "  -r, --repeat <count>         process the input this many times (benchmarking)\n"
+          "  -s, --serial                 echo the sketch's Serial output to stderr\n"
+          "  -p, --profile                print the per-stage DSP profile after the run\n"
+          "  -d, --display                drive the chain through ShowSpectrum() as loop() does\n");
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  static const struct option longOpts[] = {
+    { "mode", required_argument, nullptr, 'm' },
+    { "bw", required_argument, nullptr, 'b' },
+    { "fine", required_argument, nullptr, 'f' },
+    { "nr", required_argument, nullptr, 'n' },
+    { "notch", no_argument, nullptr, 'a' },
+    { "blanker", required_argument, nullptr, 'B' },
+    { "skim", no_argument, nullptr, 'k' },
+    { "cw", no_argument, nullptr, 'c' },
+    { "volume", required_argument, nullptr, 'v' },
+    { "latency", required_argument, nullptr, 'L' },
+    { "conv", required_argument, nullptr, 'C' },
+    { "sweep", required_argument, nullptr, 'w' },
+    { "eq", required_argument, nullptr, 'e' },
+    { "repeat", required_argument, nullptr, 'r' },
+    { "serial", no_argument, nullptr, 's' },
+    { "profile", no_argument, nullptr, 'p' },
+    { "display", no_argument, nullptr, 'd' },
+    { "gen", required_argument, nullptr, 'g' },
+    { "nco", required_argument, nullptr, 'o' },
+    { "ssb", no_argument, nullptr, 'S' },
+    { "help", no_argument, nullptr, 'h' },
+    { nullptr, 0, nullptr, 0 }
+  };
+  int mode = DEMOD_USB;
+  int sideband = SAM_DSB;
+  int loCut = 200, hiCut = 3000;
+  bool haveBw = false;
+  long fine = 0;
+  int nr = 0;
+  bool notch = false;
+  float blanker = 0;
+  bool skim = false;
+  bool cw = false;
+  int volume = 50;
+  int latency = RX_LATENCY_NORMAL;
+  int convMode = RX_CONV_STANDARD;
+  unsigned convLength = 0, convTaps = 0;
+  int sweep = 0;
+  std::string eq;
+  int repeat = 1;
+  bool serialEcho = false;
+  bool profile = false;
+  bool display = false;
+  std::string gen;
+  std::string nco;
+  bool ssb = false;
+
+  int c;
+  while ((c = getopt_long(argc, argv, "m:b:f:n:aB:kcv:L:C:w:e:r:spdg:o:Sh", longOpts, nullptr)) != -1) {
+    switch (c) {
+      case 'm': {
+        std::string m = optarg;
+        if (m == "usb") mode = DEMOD_USB;
+        else if (m == "lsb") mode = DEMOD_LSB;
+        else if (m == "am") mode = DEMOD_AM;
+        else if (m == "sam") mode = DEMOD_SAM;
+        else if (m == "sam-lsb") mode = DEMOD_SAM, sideband = SAM_LSB;
+        else if (m == "sam-usb") mode = DEMOD_SAM, sideband = SAM_USB;
+        else {
+          Usage();
+          return 2;
+        }
+        break;
+      }
+      case 'b':
+        if (sscanf(optarg, "%d:%d", &loCut, &hiCut) != 2) {
+          Usage();
+          return 2;
+        }
+        haveBw = true;
+        break;
+      case 'f': fine = atol(optarg); break;
+      case 'n': nr = atoi(optarg); break;
+      case 'a': notch = true; break;
+      case 'B': blanker = atof(optarg); break;
+      case 'k': skim = true; break;
+      case 'c': cw = true; break;
+      case 'v': volume = atoi(optarg); break;
+      case 'L': {
+        std::string l = optarg;
+        if (l == "normal") latency = RX_LATENCY_NORMAL;
+        else if (l == "low") latency = RX_LATENCY_LOW;
+        else if (l == "lowest") latency = RX_LATENCY_LOWEST;
+        else {
+          Usage();
+          return 2;
+        }
+        break;
+      }
+      case 'C': {
+        std::string v = optarg;
+        if (v == "standard") convMode = RX_CONV_STANDARD;
+        else if (v == "efficient") convMode = RX_CONV_EFFICIENT;
+        else if (v == "sharp") convMode = RX_CONV_SHARP;
+        else if (sscanf(optarg, "%u:%u", &convLength, &convTaps) < 1) {
+          Usage();
+          return 2;
+        }
+        break;
+      }
+      case 'w': sweep = std::max(0, atoi(optarg)); break;
+      case 'e': eq = optarg; break;
+      case 'r': repeat = std::max(1, atoi(optarg)); break;
+      case 's': serialEcho = true; break;
+      case 'p': profile = true; break;
+      case 'd': display = true; break;
+      case 'g': gen = optarg; break;
+      case 'o': nco = optarg; break;
+      case 'S': ssb = true; break;
+      default:
+        Usage();
+        return c == 'h' ? 0 : 2;
+    }
+  }
+
+  if (!gen.empty()) {
+    double offset = 0, seconds = 1, tone = -20, noise = -90;
+    if (optind + 1 != argc || sscanf(gen.c_str(), "%lf:%lf:%lf:%lf", &offset, &seconds, &tone, &noise) < 2) {
+      Usage();
+      return 2;
+    }
+    return GenerateTone(argv[optind], offset, seconds, tone, noise) ? 0 : 1;
+  }
+  if (!nco.empty()) {
+    Serial.setSink(serialEcho ? stderr : nullptr);
+    setup();
+    return NcoAccuracy(atol(nco.c_str()), std::max(repeat, 200));
+  }
+  if (ssb) {
+    Serial.setSink(serialEcho ? stderr : nullptr);
+    setup();
+    xmitEQFlag = OFF;
+    if (!eq.empty()) {
+      int levels[EQUALIZER_CELL_COUNT];
+      for (int i = 0; i < EQUALIZER_CELL_COUNT; i++) levels[i] = (int)xmtEQ_Level[i];
+      ParseEqualizer(eq, levels);
+      for (int i = 0; i < EQUALIZER_CELL_COUNT; i++) xmtEQ_Level[i] = levels[i];
+      xmitEQFlag = ON;
+    }
+    return SsbResponse();
+  }
+  if (optind + 2 != argc) {
+    Usage();
+    return 2;
+  }
+
+  WavData in;
+  if (!ReadWav(argv[optind], in)) return 1;
+  if (in.sampleRate != kSampleRate)
+    fprintf(stderr, "iq_runner: warning: %s is %u SPS, the receive chain expects %u\n", argv[optind], in.sampleRate, kSampleRate);
+
+  Serial.setSink(serialEcho ? stderr : nullptr);
+  setup();
+
+  if (!haveBw) {
+    switch (mode) {
+      case DEMOD_LSB: loCut = -3000, hiCut = -200; break;
+      case DEMOD_AM:
+      case DEMOD_SAM: loCut = -4000, hiCut = 4000; break;
+      default: loCut = 200, hiCut = 3000; break;
+    }
+  }
+  bands[currentBand].mode = mode;
+  samSideband = sideband;
+  bands[currentBand].FLoCut = loCut;
+  bands[currentBand].FHiCut = hiCut;
+  NCOFreq = fine;
+  NR_Index = nr;
+  ANR_notchOn = notch ? 1 : 0;
+  NB_RF_on = blanker > 0 ? 1 : 0;
+  if (blanker > 0) NB_RF_thresh = blanker;
+  cwSkimmerOn = skim ? 1 : 0;
+  audioVolume = volume;
+  receiveEQFlag = OFF;
+  if (!eq.empty()) {
+    ParseEqualizer(eq, EEPROMData.equalizerRec);
+    receiveEQFlag = ON;
+  }
+  radioState = cw ? CW_RECEIVE_STATE : SSB_RECEIVE_STATE;
+  T41State = cw ? CW_RECEIVE : SSB_RECEIVE;
+  decoderFlag = cw ? DECODE_ON : DECODE_OFF;
+  xrState = RECEIVE_STATE;
+  FilterBandwidth();
+  if (latency != RX_LATENCY_NORMAL) SetRxLatencyMode(latency);
+  if (convLength != 0) SetRxConvolution(convLength, convTaps);
+  else if (convMode != RX_CONV_STANDARD) SetRxConvMode(convMode);
+  Q_in_L.begin();
+  Q_in_R.begin();
+#if defined(DSP_PROFILER)
+  ProfilerReset();  // Drop anything timed during setup()
+#endif
+
+  WavData out;
+  out.sampleRate = kSampleRate;
+  std::vector<double> callMicros;
+  const size_t blocks = in.left.size() / BUFFER_SIZE;
+  int16_t block[BUFFER_SIZE];
+
+  for (int pass = 0; pass < repeat; pass++) {
+    for (size_t b = 0; b < blocks; b++) {
+      // ProcessIQData() reads I from Q_in_R and Q from Q_in_L.
+      Q_in_R.HostPush(&in.left[b * BUFFER_SIZE]);
+      Q_in_L.HostPush(&in.right[b * BUFFER_SIZE]);
+      if (display) {
+        // loop() in SSB receive: one ShowSpectrum() slice per pass, which services the DSP itself.
+        bool due = (uint32_t)Q_in_L.available() > N_BLOCKS;
+        auto t0 = std::chrono::steady_clock::now();
+        ShowSpectrum();
+        auto t1 = std::chrono::steady_clock::now();
+        if (due) callMicros.push_back(std::chrono::duration<double, std::micro>(t1 - t0).count());
+      } else {
+        if ((uint32_t)Q_in_L.available() <= N_BLOCKS) continue;
+
+        auto t0 = std::chrono::steady_clock::now();
+        ProcessIQData();
+        auto t1 = std::chrono::steady_clock::now();
+        callMicros.push_back(std::chrono::duration<double, std::micro>(t1 - t0).count());
+        if (sweep > 0 && callMicros.size() % sweep == 0) {
+          // A triangle of 10 steps each way, narrowing the outer edge from where it started
+          int step = (int)(callMicros.size() / sweep) % 20;
+          int offset = 100 * (step < 10 ? step : 20 - step);
+          if (abs(hiCut) >= abs(loCut)) bands[currentBand].FHiCut = hiCut - offset;
+          else bands[currentBand].FLoCut = loCut + offset;
+          FilterBandwidth();
+        }
+      }
+
+      if (skim) CWSkimmerShowSpots(Serial);  // As loop() does, outside ProcessIQData()
+
+      while (Q_out_L.HostPop(block)) {
+        out.left.insert(out.left.end(), block, block + BUFFER_SIZE);
+        Q_out_R.HostPop(block);
+        out.right.insert(out.right.end(), block, block + BUFFER_SIZE);
+      }
+    }
+  }
+
+  if (!WriteWav(argv[optind + 1], out)) return 1;
+
+  if (callMicros.empty()) {
+    printf("ProcessIQData: input shorter than one %u-sample block, nothing processed\n", (unsigned)(N_BLOCKS * BUFFER_SIZE));
+    return 0;
+  }
+  std::vector<double> sorted = callMicros;
+  std::sort(sorted.begin(), sorted.end());
+  double sum = 0;
+  for (double v : sorted) sum += v;
+  double mean = sum / sorted.size();
+  double p99 = sorted[std::min(sorted.size() - 1, (size_t)(0.99 * sorted.size()))];
+  double budget = 1e6 * N_BLOCKS * BUFFER_SIZE / kSampleRate;
+  printf("ProcessIQData: %zu calls, %u samples each (%.2f ms of IQ)\n", sorted.size(), (unsigned)(N_BLOCKS * BUFFER_SIZE), budget / 1000.0);
+  printf("  host time per call: min %.1f us, mean %.1f us, p99 %.1f us, max %.1f us\n", sorted.front(), mean, p99, sorted.back());
+  printf("  real-time factor (host): %.1fx\n", budget / mean);
+  printf("  audio out: %zu samples -> %s\n", out.left.size(), argv[optind + 1]);
+  printf("  input queue overflows (n_clear): %ld\n", n_clear);
+  printf("  convolution: %u point FFT, %u taps, %u new samples per FFT (%.0f%%), %.1f MACs/sample"
+         " (direct form FIR %u)\n", (unsigned)FFT_length, (unsigned)m_NumTaps, (unsigned)rxConvHop,
+         100.0 * rxConvHop / FFT_length, RxConvolutionMACs(), 4 * (unsigned)m_NumTaps);
+  if (cw) {
+    printf("  CW decoder: \"%s\", dit %lu ms\n", decodeBuffer, (unsigned long)ditLength);
+  }
+  if (skim) {
+    HostSerial report(stdout);
+    CWSkimmerReport(report);
+  }
+  if (profile) {
+#if defined(DSP_PROFILER)
+    HostSerial report(stdout);
+    ProfilerReport(report);
+#else
+    printf("  per-stage profile unavailable: DSP_PROFILER is not defined in Config.h\n");
+#endif
+  }
+  return 0;
+}
@@ -0,0 +1,26 @@
+// Host build only: I2C device that acknowledges everything and reads zeros.
+#ifndef HOST_ADAFRUIT_I2CDEVICE_H
+#define HOST_ADAFRUIT_I2CDEVICE_H
+
+#include <Arduino.h>
+#include <Wire.h>
+
+class Adafruit_I2CDevice {
+ public:
+  Adafruit_I2CDevice(uint8_t addr, TwoWire *theWire = &Wire) : addr_(addr) { (void)theWire; }
+  bool begin(bool = true) { return true; }
+  uint8_t address(void) { return addr_; }
+  bool write(const uint8_t *, size_t, bool = true, const uint8_t * = nullptr, size_t = 0) { return true; }
+  bool read(uint8_t *buffer, size_t len, bool = true) {
+    memset(buffer, 0, len);
+    return true;
+  }
+  bool write_then_read(const uint8_t *, size_t, uint8_t *read_buffer, size_t read_len, bool = false) {
+    memset(read_buffer, 0, read_len);
+    return true;
+  }
+ private:
+  uint8_t addr_;
+};
+
+#endif
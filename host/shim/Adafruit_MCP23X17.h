@@ -0,0 +1,30 @@
+// Host build only: MCP23017 port expander with no pins ever changing.
+#ifndef HOST_ADAFRUIT_MCP23X17_H
+#define HOST_ADAFRUIT_MCP23X17_H
+
+#include <Arduino.h>
+#include <Wire.h>
+
+#define MCP23XXX_INT_ERR 255
+
+class Adafruit_MCP23X17 {
+ public:
+  bool begin_I2C(uint8_t = 0x20, TwoWire * = &Wire) { return true; }
+  void enableAddrPins(void) {}
+  void pinMode(uint8_t, uint8_t) {}
+  uint8_t digitalRead(uint8_t) { return HIGH; }
+  void digitalWrite(uint8_t, uint8_t) {}
+  uint8_t readGPIOA(void) { return 0xFF; }
+  uint8_t readGPIOB(void) { return 0xFF; }
+  uint16_t readGPIOAB(void) { return 0xFFFF; }
+  void writeGPIOA(uint8_t) {}
+  void writeGPIOB(uint8_t) {}
+  void writeGPIOAB(uint16_t) {}
+  void setupInterrupts(bool, bool, uint8_t) {}
+  void setupInterruptPin(uint8_t, uint8_t = CHANGE) {}
+  void disableInterruptPin(uint8_t) {}
+  void clearInterrupts(void) {}
+  uint8_t getLastInterruptPin(void) { return MCP23XXX_INT_ERR; }
+};
+
+#endif
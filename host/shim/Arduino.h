@@ -0,0 +1,455 @@
+// Host build only: the subset of the Teensyduino core the sketch relies on.
+// Hardware access compiles to no-ops; timing comes from the host clock.
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <math.h>
+#include <string>
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include "binary.h"
+
+typedef uint8_t byte;
+typedef bool boolean;
+typedef unsigned int word;
+
+#define FASTRUN
+#define FLASHMEM
+#define PROGMEM
+#define DMAMEM
+#define EXTMEM
+#define F(s) (s)
+#define PSTR(s) (s)
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define INPUT_PULLDOWN 3
+#define CHANGE 4
+#define FALLING 2
+#define RISING 3
+#define LSBFIRST 0
+#define MSBFIRST 1
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+#define LED_BUILTIN 13
+#define BUILTIN_SDCARD 254
+#define F_CPU 528000000
+#define F_CPU_ACTUAL 528000000
+
+#ifndef PI
+#define PI 3.1415926535897932384626433832795
+#endif
+#define HALF_PI 1.5707963267948966192313216916398
+#define TWO_PI 6.283185307179586476925286766559
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+
+// Teensyduino defines min/max as templates yielding the common type, which
+// the sketch relies on for mixed float/double arguments.
+template <class A, class B>
+constexpr auto min(A &&a, B &&b) -> decltype(a < b ? std::forward<A>(a) : std::forward<B>(b)) {
+  return a < b ? std::forward<A>(a) : std::forward<B>(b);
+}
+template <class A, class B>
+constexpr auto max(A &&a, B &&b) -> decltype(a < b ? std::forward<A>(a) : std::forward<B>(b)) {
+  return a >= b ? std::forward<A>(a) : std::forward<B>(b);
+}
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#define sq(x) ((x) * (x))
+#define radians(deg) ((deg) * DEG_TO_RAD)
+#define degrees(rad) ((rad) * RAD_TO_DEG)
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit) ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+#define bitWrite(value, bit, bitvalue) ((bitvalue) ? bitSet(value, bit) : bitClear(value, bit))
+#define bit(b) (1UL << (b))
+#define lowByte(w) ((uint8_t)((w) & 0xff))
+#define highByte(w) ((uint8_t)((w) >> 8))
+
+using std::abs;
+using std::isnan;
+using std::isinf;
+
+uint32_t millis(void);
+uint32_t micros(void);
+void delay(uint32_t msec);
+void delayMicroseconds(uint32_t usec);
+void yield(void);
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+uint8_t digitalRead(uint8_t pin);
+void digitalToggle(uint8_t pin);
+int analogRead(uint8_t pin);
+void analogWrite(uint8_t pin, int val);
+void analogReadResolution(unsigned int bits);
+void analogWriteResolution(unsigned int bits);
+void attachInterrupt(uint8_t pin, void (*function)(void), int mode);
+void detachInterrupt(uint8_t pin);
+#define digitalPinToInterrupt(p) (p)
+void __disable_irq(void);
+void __enable_irq(void);
+#define interrupts() __enable_irq()
+#define cli() __disable_irq()
+#define sei() __enable_irq()
+#define noInterrupts() __disable_irq()
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+float tempmonGetTemp(void);
+extern "C" uint32_t set_arm_clock(uint32_t frequency);
+
+char *dtostrf(double val, int width, unsigned int precision, char *buf);
+char *itoa(int val, char *s, int radix);
+char *ltoa(long val, char *s, int radix);
+char *ultoa(unsigned long val, char *s, int radix);
+#ifndef __GLIBC_PREREQ
+size_t strlcpy(char *dst, const char *src, size_t size);
+#elif !__GLIBC_PREREQ(2, 38)
+size_t strlcpy(char *dst, const char *src, size_t size);
+#endif
+
+// ---------------------------------------------------------------- timing
+// Cycle counter: on the host this reads a monotonic clock scaled to the 528 MHz
+// core clock (the README build setting), so cycle-to-time conversions hold.
+uint32_t host_cycle_count(void);
+#define ARM_DEMCR (*host_reg32(0))
+#define ARM_DEMCR_TRCENA (1 << 24)
+#define ARM_DWT_CTRL (*host_reg32(1))
+#define ARM_DWT_CTRL_CYCCNTENA (1 << 0)
+#define ARM_DWT_CYCCNT (host_cycle_count())
+volatile uint32_t *host_reg32(int index);
+
+class elapsedMicros {
+ public:
+  elapsedMicros(void) { us = micros(); }
+  elapsedMicros(unsigned long val) { us = micros() - val; }
+  operator unsigned long() const { return micros() - us; }
+  elapsedMicros &operator=(unsigned long val) {
+    us = micros() - val;
+    return *this;
+  }
+  elapsedMicros &operator-=(unsigned long val) {
+    us += val;
+    return *this;
+  }
+  elapsedMicros &operator+=(unsigned long val) {
+    us -= val;
+    return *this;
+  }
+ private:
+  unsigned long us;
+};
+
+class elapsedMillis {
+ public:
+  elapsedMillis(void) { ms = millis(); }
+  elapsedMillis(unsigned long val) { ms = millis() - val; }
+  operator unsigned long() const { return millis() - ms; }
+  elapsedMillis &operator=(unsigned long val) {
+    ms = millis() - val;
+    return *this;
+  }
+ private:
+  unsigned long ms;
+};
+
+// ---------------------------------------------------------------- i.MX RT registers
+volatile uint32_t *host_reg32(int index);
+#define TEMPMON_TEMPSENSE0 (*host_reg32(10))
+#define TEMPMON_TEMPSENSE1 (*host_reg32(11))
+#define HW_OCOTP_ANA1 (*host_reg32(12))
+#define CCM_CS1CDR (*host_reg32(13))
+#define CCM_CS2CDR (*host_reg32(14))
+#define SNVS_HPCR (*host_reg32(15))
+#define SNVS_LPCR (*host_reg32(16))
+#define SNVS_LPSRTCLR (*host_reg32(17))
+#define SNVS_LPSRTCMR (*host_reg32(18))
+#define CCM_CS1CDR_SAI1_CLK_PODF_MASK (0x3F << 0)
+#define CCM_CS1CDR_SAI1_CLK_PODF(n) ((uint32_t)(((n) & 0x3F) << 0))
+#define CCM_CS1CDR_SAI1_CLK_PRED_MASK (0x07 << 6)
+#define CCM_CS1CDR_SAI1_CLK_PRED(n) ((uint32_t)(((n) & 0x07) << 6))
+#define CCM_CS2CDR_SAI2_CLK_PODF_MASK (0x3F << 0)
+#define CCM_CS2CDR_SAI2_CLK_PODF(n) ((uint32_t)(((n) & 0x3F) << 0))
+#define CCM_CS2CDR_SAI2_CLK_PRED_MASK (0x07 << 6)
+#define CCM_CS2CDR_SAI2_CLK_PRED(n) ((uint32_t)(((n) & 0x07) << 6))
+#define SNVS_HPCR_RTC_EN ((uint32_t)(1 << 0))
+#define SNVS_HPCR_HP_TS ((uint32_t)(1 << 16))
+#define SNVS_LPCR_SRTC_ENV ((uint32_t)(1 << 0))
+#define IOMUXC_PAD_DSE(n) ((uint32_t)(((n) & 0x07) << 3))
+#define IOMUXC_PAD_SPEED(n) ((uint32_t)(((n) & 0x03) << 6))
+
+struct digital_pin_bitband_and_config_table_struct {
+  volatile uint32_t *reg;
+  volatile uint32_t *mux;
+  volatile uint32_t *pad;
+  uint32_t mask;
+};
+extern const struct digital_pin_bitband_and_config_table_struct digital_pin_to_info_PGM[];
+
+// ---------------------------------------------------------------- String
+class String {
+ public:
+  String() {}
+  String(const char *s) : s_(s ? s : "") {}
+  String(const std::string &s) : s_(s) {}
+  String(char c) : s_(1, c) {}
+  String(unsigned char v, unsigned char base = DEC) { s_ = FromULong(v, base); }
+  String(int v, unsigned char base = DEC) { s_ = (base == DEC) ? std::to_string(v) : FromULong((unsigned int)v, base); }
+  String(unsigned int v, unsigned char base = DEC) { s_ = FromULong(v, base); }
+  String(long v, unsigned char base = DEC) { s_ = (base == DEC) ? std::to_string(v) : FromULong((unsigned long)v, base); }
+  String(unsigned long v, unsigned char base = DEC) { s_ = FromULong(v, base); }
+  String(long long v, unsigned char base = DEC) { s_ = (base == DEC) ? std::to_string(v) : FromULong((unsigned long long)v, base); }
+  String(unsigned long long v, unsigned char base = DEC) { s_ = FromULong(v, base); }
+  String(float v, unsigned char decimals = 2) { s_ = FromDouble(v, decimals); }
+  String(double v, unsigned char decimals = 2) { s_ = FromDouble(v, decimals); }
+
+  const char *c_str() const { return s_.c_str(); }
+  unsigned int length() const { return (unsigned int)s_.length(); }
+  char charAt(unsigned int i) const { return i < s_.length() ? s_[i] : 0; }
+  char operator[](unsigned int i) const { return charAt(i); }
+  char &operator[](unsigned int i) { return s_[i]; }
+  void setCharAt(unsigned int i, char c) {
+    if (i < s_.length()) s_[i] = c;
+  }
+  long toInt() const { return atol(s_.c_str()); }
+  float toFloat() const { return (float)atof(s_.c_str()); }
+  double toDouble() const { return atof(s_.c_str()); }
+  int indexOf(char c, unsigned int from = 0) const {
+    size_t p = s_.find(c, from);
+    return p == std::string::npos ? -1 : (int)p;
+  }
+  int indexOf(const String &str, unsigned int from = 0) const {
+    size_t p = s_.find(str.s_, from);
+    return p == std::string::npos ? -1 : (int)p;
+  }
+  int lastIndexOf(char c) const {
+    size_t p = s_.rfind(c);
+    return p == std::string::npos ? -1 : (int)p;
+  }
+  String substring(unsigned int from) const { return from < s_.length() ? String(s_.substr(from)) : String(); }
+  String substring(unsigned int from, unsigned int to) const {
+    if (from > to) std::swap(from, to);
+    if (from >= s_.length()) return String();
+    return String(s_.substr(from, to - from));
+  }
+  bool equals(const String &o) const { return s_ == o.s_; }
+  bool equalsIgnoreCase(const String &o) const { return strcasecmp(s_.c_str(), o.s_.c_str()) == 0; }
+  bool startsWith(const String &o) const { return s_.compare(0, o.s_.length(), o.s_) == 0; }
+  bool endsWith(const String &o) const { return s_.length() >= o.s_.length() && s_.compare(s_.length() - o.s_.length(), o.s_.length(), o.s_) == 0; }
+  void toCharArray(char *buf, unsigned int bufsize, unsigned int index = 0) const {
+    if (!bufsize || !buf) return;
+    strncpy(buf, index < s_.length() ? s_.c_str() + index : "", bufsize - 1);
+    buf[bufsize - 1] = 0;
+  }
+  void getBytes(unsigned char *buf, unsigned int bufsize, unsigned int index = 0) const { toCharArray((char *)buf, bufsize, index); }
+  void trim() {
+    size_t b = s_.find_first_not_of(" \t\r\n");
+    size_t e = s_.find_last_not_of(" \t\r\n");
+    s_ = (b == std::string::npos) ? std::string() : s_.substr(b, e - b + 1);
+  }
+  void toUpperCase() {
+    for (auto &c : s_) c = (char)toupper(c);
+  }
+  void toLowerCase() {
+    for (auto &c : s_) c = (char)tolower(c);
+  }
+  void remove(unsigned int index) { s_.erase(std::min<size_t>(index, s_.length())); }
+  void remove(unsigned int index, unsigned int count) { s_.erase(std::min<size_t>(index, s_.length()), count); }
+  void replace(const String &from, const String &to) {
+    if (from.s_.empty()) return;
+    size_t p = 0;
+    while ((p = s_.find(from.s_, p)) != std::string::npos) {
+      s_.replace(p, from.s_.length(), to.s_);
+      p += to.s_.length();
+    }
+  }
+  bool concat(const String &o) {
+    s_ += o.s_;
+    return true;
+  }
+  void reserve(unsigned int n) { s_.reserve(n); }
+
+  String &operator+=(const String &o) {
+    s_ += o.s_;
+    return *this;
+  }
+  String &operator+=(const char *o) {
+    s_ += o;
+    return *this;
+  }
+  String &operator+=(char c) {
+    s_ += c;
+    return *this;
+  }
+  String &operator+=(int v) { return *this += String(v); }
+  String &operator+=(unsigned int v) { return *this += String(v); }
+  String &operator+=(long v) { return *this += String(v); }
+  String &operator+=(unsigned long v) { return *this += String(v); }
+  String &operator+=(float v) { return *this += String(v); }
+  String &operator+=(double v) { return *this += String(v); }
+  bool operator==(const String &o) const { return s_ == o.s_; }
+  bool operator==(const char *o) const { return s_ == o; }
+  bool operator!=(const String &o) const { return s_ != o.s_; }
+  bool operator!=(const char *o) const { return s_ != o; }
+  bool operator<(const String &o) const { return s_ < o.s_; }
+  operator bool() const { return true; }
+
+  friend String operator+(const String &a, const String &b) { return String(a.s_ + b.s_); }
+  friend String operator+(const String &a, const char *b) { return String(a.s_ + b); }
+  friend String operator+(const char *a, const String &b) { return String(a + b.s_); }
+  friend String operator+(const String &a, char b) { return String(a.s_ + b); }
+  friend String operator+(const String &a, int b) { return a + String(b); }
+  friend String operator+(const String &a, unsigned int b) { return a + String(b); }
+  friend String operator+(const String &a, long b) { return a + String(b); }
+  friend String operator+(const String &a, unsigned long b) { return a + String(b); }
+  friend String operator+(const String &a, long long b) { return a + String(b); }
+  friend String operator+(const String &a, float b) { return a + String(b); }
+  friend String operator+(const String &a, double b) { return a + String(b); }
+
+ private:
+  static std::string FromULong(unsigned long long v, unsigned char base) {
+    if (base < 2) base = 10;
+    if (v == 0) return "0";
+    std::string r;
+    while (v) {
+      int d = (int)(v % base);
+      r.insert(r.begin(), (char)(d < 10 ? '0' + d : 'A' + d - 10));
+      v /= base;
+    }
+    return r;
+  }
+  static std::string FromDouble(double v, unsigned char decimals) {
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%.*f", (int)decimals, v);
+    return buf;
+  }
+  std::string s_;
+};
+
+// ---------------------------------------------------------------- Print / Stream
+class Print;
+class Printable {
+ public:
+  virtual ~Printable() {}
+  virtual size_t printTo(Print &p) const = 0;
+};
+
+class Print {
+ public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t *buf, size_t n) {
+    for (size_t i = 0; i < n; i++) write(buf[i]);
+    return n;
+  }
+  size_t write(const char *s) { return write((const uint8_t *)s, strlen(s)); }
+  size_t write(const char *buf, size_t n) { return write((const uint8_t *)buf, n); }
+  virtual int availableForWrite() { return 4096; }
+  virtual void flush() {}
+
+  size_t print(const char *s) { return write(s); }
+  size_t print(const Printable &x) { return x.printTo(*this); }
+  size_t print(const String &s) { return write(s.c_str()); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(unsigned char v, int base = DEC) { return print((unsigned long)v, base); }
+  size_t print(int v, int base = DEC) { return base == DEC ? print((long)v) : print((unsigned long)(unsigned int)v, base); }
+  size_t print(unsigned int v, int base = DEC) { return print((unsigned long)v, base); }
+  size_t print(long v, int base = DEC) { return base == DEC ? write(std::to_string(v).c_str()) : print((unsigned long)v, base); }
+  size_t print(unsigned long v, int base = DEC) { return write(String(v, (unsigned char)base).c_str()); }
+  size_t print(long long v, int base = DEC) { return base == DEC ? write(std::to_string(v).c_str()) : print((unsigned long long)v, base); }
+  size_t print(unsigned long long v, int base = DEC) { return write(String(v, (unsigned char)base).c_str()); }
+  size_t print(double v, int digits = 2) { return write(String(v, (unsigned char)digits).c_str()); }
+  size_t println() { return write("\r\n"); }
+  template <typename T>
+  size_t println(const T &v) {
+    size_t n = print(v);
+    return n + println();
+  }
+  template <typename T>
+  size_t println(const T &v, int fmt) {
+    size_t n = print(v, fmt);
+    return n + println();
+  }
+  int printf(const char *fmt, ...) __attribute__((format(printf, 2, 3))) {
+    char buf[1024];
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(buf, sizeof(buf), fmt, ap);
+    va_end(ap);
+    write(buf);
+    return n;
+  }
+};
+
+class Stream : public Print {
+ public:
+  virtual int available() { return 0; }
+  virtual int read() { return -1; }
+  virtual int peek() { return -1; }
+  size_t readBytes(char *buf, size_t n) {
+    size_t i = 0;
+    for (; i < n; i++) {
+      int c = read();
+      if (c < 0) break;
+      buf[i] = (char)c;
+    }
+    return i;
+  }
+  String readStringUntil(char terminator) {
+    String s;
+    int c;
+    while ((c = read()) >= 0 && c != terminator) s += (char)c;
+    return s;
+  }
+  void setTimeout(unsigned long) {}
+};
+
+// Serial output goes to stderr so host tools can keep stdout for reports.
+class HostSerial : public Stream {
+ public:
+  explicit HostSerial(FILE *sink = nullptr) : sink_(sink) {}
+  void begin(unsigned long) {}
+  void end() {}
+  size_t write(uint8_t c) override {
+    if (sink_) fputc(c, sink_);
+    return 1;
+  }
+  size_t write(const uint8_t *buf, size_t n) override {
+    if (sink_) fwrite(buf, 1, n, sink_);
+    return n;
+  }
+  using Print::write;
+  operator bool() const { return true; }
+  void setSink(FILE *sink) { sink_ = sink; }
+ private:
+  FILE *sink_;
+};
+
+extern HostSerial Serial;
+extern HostSerial SerialUSB1;
+extern HostSerial Serial1;
+
+class CrashReportClass : public Printable {
+ public:
+  size_t printTo(Print &) const override { return 0; }
+  operator bool() { return false; }
+};
+extern CrashReportClass CrashReport;
+
+#endif
@@ -0,0 +1,42 @@
+// Host build only: enough of ArduinoJson v7 for JSON.cpp to compile. The host
+// has no SD card, so documents are never actually parsed or written.
+#ifndef HOST_ARDUINOJSON_H
+#define HOST_ARDUINOJSON_H
+
+#include <Arduino.h>
+
+class JsonVariant {
+ public:
+  JsonVariant operator[](int) const { return JsonVariant(); }
+  JsonVariant operator[](const char *) const { return JsonVariant(); }
+  template <typename T>
+  operator T() const { return T(); }
+  template <typename T>
+  JsonVariant &operator=(const T &) { return *this; }
+  const char *operator|(const char *def) const { return def; }
+  template <typename T>
+  T operator|(T def) const { return def; }
+};
+
+class JsonDocument {
+ public:
+  JsonVariant operator[](const char *) { return JsonVariant(); }
+  void clear(void) {}
+};
+
+class DeserializationError {
+ public:
+  explicit DeserializationError(bool failed) : failed_(failed) {}
+  explicit operator bool() const { return failed_; }
+  const char *c_str() const { return failed_ ? "NoSD" : "Ok"; }
+ private:
+  bool failed_;
+};
+
+template <typename TInput>
+DeserializationError deserializeJson(JsonDocument &, TInput &) { return DeserializationError(true); }
+
+inline size_t serializeJsonPretty(const JsonDocument &, Print &) { return 0; }
+inline size_t serializeJson(const JsonDocument &, Print &) { return 0; }
+
+#endif
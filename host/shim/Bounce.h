@@ -0,0 +1,16 @@
+// Host build only.
+#ifndef HOST_BOUNCE_H
+#define HOST_BOUNCE_H
+
+#include <Arduino.h>
+
+class Bounce {
+ public:
+  Bounce(uint8_t, unsigned long) {}
+  bool update(void) { return false; }
+  int read(void) { return HIGH; }
+  bool fallingEdge(void) { return false; }
+  bool risingEdge(void) { return false; }
+};
+
+#endif
@@ -0,0 +1,27 @@
+// Host build only: Chrono stopwatch on the host millisecond clock.
+#ifndef HOST_CHRONO_H
+#define HOST_CHRONO_H
+
+#include <Arduino.h>
+
+class Chrono {
+ public:
+  Chrono(bool startNow = true) : start_(millis()), running_(startNow) {}
+  void start(void) {
+    start_ = millis();
+    running_ = true;
+  }
+  void restart(unsigned long offset = 0) {
+    start_ = millis() - offset;
+    running_ = true;
+  }
+  void stop(void) { running_ = false; }
+  bool isRunning(void) const { return running_; }
+  unsigned long elapsed(void) const { return millis() - start_; }
+  bool hasPassed(unsigned long timeout) const { return elapsed() >= timeout; }
+ private:
+  unsigned long start_;
+  bool running_;
+};
+
+#endif
@@ -0,0 +1,31 @@
+// Host build only: 4 KB of emulated EEPROM, initially erased (0xFF).
+#ifndef HOST_EEPROM_H
+#define HOST_EEPROM_H
+
+#include <Arduino.h>
+
+#define E2END 0xFFF
+
+class EEPROMClass {
+ public:
+  EEPROMClass() { memset(data_, 0xFF, sizeof(data_)); }
+  uint8_t read(int idx) { return data_[idx & E2END]; }
+  void write(int idx, uint8_t val) { data_[idx & E2END] = val; }
+  void update(int idx, uint8_t val) { write(idx, val); }
+  uint16_t length() { return E2END + 1; }
+  template <typename T>
+  T &get(int idx, T &t) {
+    memcpy((void *)&t, data_ + idx, sizeof(T));
+    return t;
+  }
+  template <typename T>
+  const T &put(int idx, const T &t) {
+    memcpy(data_ + idx, (const void *)&t, sizeof(T));
+    return t;
+  }
+ private:
+  uint8_t data_[E2END + 1 + 4096];
+};
+extern EEPROMClass EEPROM;
+
+#endif
@@ -0,0 +1,4 @@
+// Host build only: placeholder for the Adafruit GFX font of the same name.
+#pragma once
+#include "../Adafruit_GFX.h"
+const GFXfont FreeMono24pt7b = { nullptr, nullptr, 0x20, 0x7E, 0 };
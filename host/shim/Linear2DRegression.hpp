@@ -0,0 +1,16 @@
+// Host build only.
+#ifndef HOST_LINEAR2DREGRESSION_HPP
+#define HOST_LINEAR2DREGRESSION_HPP
+
+#include "LinearRegression.h"
+
+class Linear2DRegression {
+ public:
+  void addPoint(double x, double y) { lr_.learn(x, y); }
+  double calculate(double x) { return lr_.calculate(x); }
+  void reset(void) { lr_.reset(); }
+ private:
+  LinearRegression lr_;
+};
+
+#endif
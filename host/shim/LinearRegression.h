@@ -0,0 +1,28 @@
+// Host build only.
+#ifndef HOST_LINEARREGRESSION_H
+#define HOST_LINEARREGRESSION_H
+
+#include <Arduino.h>
+
+class LinearRegression {
+ public:
+  LinearRegression() {}
+  void learn(double x, double y) {
+    n_++;
+    sx_ += x;
+    sy_ += y;
+    sxx_ += x * x;
+    sxy_ += x * y;
+  }
+  double calculate(double x) {
+    double d = n_ * sxx_ - sx_ * sx_;
+    if (d == 0.0) return 0.0;
+    double m = (n_ * sxy_ - sx_ * sy_) / d;
+    return m * x + (sy_ - m * sx_) / n_;
+  }
+  void reset(void) { n_ = sx_ = sy_ = sxx_ = sxy_ = 0.0; }
+ private:
+  double n_ = 0, sx_ = 0, sy_ = 0, sxx_ = 0, sxy_ = 0;
+};
+
+#endif
@@ -0,0 +1,24 @@
+// Host build only: Metro interval timer on the host clock.
+#ifndef HOST_METRO_H
+#define HOST_METRO_H
+
+#include <Arduino.h>
+
+class Metro {
+ public:
+  Metro(unsigned long interval_millis = 1000) : interval_(interval_millis), previous_(millis()) {}
+  void interval(unsigned long interval_millis) { interval_ = interval_millis; }
+  bool check(void) {
+    if (millis() - previous_ >= interval_) {
+      previous_ = millis();
+      return true;
+    }
+    return false;
+  }
+  void reset(void) { previous_ = millis(); }
+ private:
+  unsigned long interval_;
+  unsigned long previous_;
+};
+
+#endif
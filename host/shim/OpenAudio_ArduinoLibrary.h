@@ -0,0 +1,189 @@
+// Host build only: Teensy Audio / OpenAudio objects used by the sketch.
+// Record and play queues are backed by host memory so a driver program can
+// feed ProcessIQData() from a file and collect its output blocks.
+#ifndef HOST_OPENAUDIO_ARDUINOLIBRARY_H
+#define HOST_OPENAUDIO_ARDUINOLIBRARY_H
+
+#include <Arduino.h>
+#include <deque>
+#include <vector>
+#include <array>
+
+#define AUDIO_BLOCK_SAMPLES 128
+#define AUDIO_SAMPLE_RATE_EXACT 44117.64706f
+#define AUDIO_SAMPLE_RATE AUDIO_SAMPLE_RATE_EXACT
+#define AUDIO_INPUT_LINEIN 0
+#define AUDIO_INPUT_MIC 1
+
+void AudioMemory(int n);
+void AudioMemory_F32(int n);
+int AudioMemoryUsage(void);
+int AudioMemoryUsageMax(void);
+void AudioMemoryUsageMaxReset(void);
+float AudioProcessorUsage(void);
+float AudioProcessorUsageMax(void);
+#define AudioNoInterrupts() ((void)0)
+#define AudioInterrupts() ((void)0)
+
+class AudioStream {
+ public:
+  virtual ~AudioStream() {}
+};
+
+class AudioStream_F32 {
+ public:
+  virtual ~AudioStream_F32() {}
+};
+
+class AudioConnection {
+ public:
+  AudioConnection(AudioStream &, unsigned char, AudioStream &, unsigned char) {}
+  AudioConnection(AudioStream &, AudioStream &) {}
+};
+
+class AudioConnection_F32 {
+ public:
+  AudioConnection_F32(AudioStream_F32 &, unsigned char, AudioStream_F32 &, unsigned char) {}
+  AudioConnection_F32(AudioStream &, unsigned char, AudioStream_F32 &, unsigned char) {}
+  AudioConnection_F32(AudioStream_F32 &, unsigned char, AudioStream &, unsigned char) {}
+};
+
+class AudioSynthWaveformSine : public AudioStream {
+ public:
+  void frequency(float f) { freq_ = f; }
+  void amplitude(float a) { amp_ = a; }
+  void phase(float) {}
+ private:
+  float freq_ = 0.0f, amp_ = 0.0f;
+};
+
+class AudioInputI2SQuad : public AudioStream {};
+class AudioOutputI2SQuad : public AudioStream {};
+class AudioInputI2S : public AudioStream {};
+class AudioOutputI2S : public AudioStream {};
+
+class AudioMixer4 : public AudioStream {
+ public:
+  void gain(unsigned int channel, float g) {
+    if (channel < 4) gains_[channel] = g;
+  }
+  float getGain(unsigned int channel) const { return channel < 4 ? gains_[channel] : 0.0f; }
+ private:
+  float gains_[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+};
+
+class AudioAmplifier : public AudioStream {
+ public:
+  void gain(float) {}
+};
+
+class AudioControlSGTL5000 {
+ public:
+  bool enable(void) { return true; }
+  bool disable(void) { return true; }
+  void setAddress(uint8_t) {}
+  bool volume(float) { return true; }
+  bool inputSelect(int) { return true; }
+  bool micGain(unsigned int) { return true; }
+  bool lineInLevel(uint8_t) { return true; }
+  bool lineInLevel(uint8_t, uint8_t) { return true; }
+  unsigned short lineOutLevel(uint8_t) { return 0; }
+  unsigned short lineOutLevel(uint8_t, uint8_t) { return 0; }
+  unsigned short adcHighPassFilterDisable(void) { return 0; }
+  unsigned short adcHighPassFilterEnable(void) { return 0; }
+  bool muteHeadphone(void) { return true; }
+  bool unmuteHeadphone(void) { return true; }
+  bool muteLineout(void) { return true; }
+  bool unmuteLineout(void) { return true; }
+};
+
+class AudioControlSGTL5000_Extended : public AudioControlSGTL5000 {};
+
+class AudioConvert_I16toF32 : public AudioStream_F32 {};
+class AudioConvert_F32toI16 : public AudioStream_F32 {};
+
+class AudioEffectGain_F32 : public AudioStream_F32 {
+ public:
+  void setGain(float g) { gain_ = g; }
+  void setGain_dB(float dB) { gain_ = powf(10.0f, dB / 20.0f); }
+  float getGain(void) const { return gain_; }
+ private:
+  float gain_ = 1.0f;
+};
+
+class AudioEffectCompressor_F32 : public AudioStream_F32 {
+ public:
+  void enableHPFilter(bool) {}
+  void setThresh_dBFS(float) {}
+  void setCompressionRatio(float) {}
+  void setAttack_sec(float, float = 0.0f) {}
+  void setRelease_sec(float, float = 0.0f) {}
+  void setPreGain_dB(float) {}
+  void setPreGain(float) {}
+};
+
+/*****
+  Record queue. On the Teensy the I2S DMA fills it from interrupt context; on
+  the host a driver program pushes blocks with HostPush().
+*****/
+class AudioRecordQueue : public AudioStream {
+ public:
+  typedef std::array<int16_t, AUDIO_BLOCK_SAMPLES> Block;
+  void begin(void) { enabled_ = true; }
+  void end(void) { enabled_ = false; }
+  void clear(void) {
+    blocks_.clear();
+    hasCurrent_ = false;
+  }
+  int available(void) const { return (int)blocks_.size(); }
+  int16_t *readBuffer(void) {
+    if (blocks_.empty()) return nullptr;
+    current_ = blocks_.front();
+    blocks_.pop_front();
+    hasCurrent_ = true;
+    return current_.data();
+  }
+  void freeBuffer(void) { hasCurrent_ = false; }
+
+  bool HostEnabled(void) const { return enabled_; }
+  void HostPush(const int16_t *samples) {
+    Block b;
+    memcpy(b.data(), samples, sizeof(int16_t) * AUDIO_BLOCK_SAMPLES);
+    blocks_.push_back(b);
+  }
+ private:
+  std::deque<Block> blocks_;
+  Block current_{};
+  bool hasCurrent_ = false;
+  bool enabled_ = false;
+};
+
+/*****
+  Play queue. Blocks handed to playBuffer() are kept until a host driver
+  collects them with HostPop().
+*****/
+class AudioPlayQueue : public AudioStream {
+ public:
+  typedef std::array<int16_t, AUDIO_BLOCK_SAMPLES> Block;
+  int16_t *getBuffer(void) {
+    pending_.fill(0);
+    return pending_.data();
+  }
+  void playBuffer(void) { blocks_.push_back(pending_); }
+  void setMaxBuffers(uint8_t) {}
+  int available(void) const { return 1; }
+
+  size_t HostAvailable(void) const { return blocks_.size(); }
+  bool HostPop(int16_t *samples) {
+    if (blocks_.empty()) return false;
+    memcpy(samples, blocks_.front().data(), sizeof(int16_t) * AUDIO_BLOCK_SAMPLES);
+    blocks_.pop_front();
+    return true;
+  }
+  void HostClear(void) { blocks_.clear(); }
+ private:
+  std::deque<Block> blocks_;
+  Block pending_{};
+};
+
+#endif
@@ -0,0 +1,76 @@
+// Host build only: RA8875 display driver with every draw call a no-op.
+#ifndef HOST_RA8875_H
+#define HOST_RA8875_H
+
+#include <Arduino.h>
+#include "Adafruit_GFX.h"
+
+#define RA8875_BLACK 0x0000
+#define RA8875_WHITE 0xFFFF
+#define RA8875_RED 0xF800
+#define RA8875_CYAN 0x07FF
+#define RA8875_MAGENTA 0xF81F
+#define RA8875_YELLOW 0xFFE0
+#define RA8875_LIGHT_ORANGE 0xFC80
+
+enum RA8875sizes { RA8875_480x272, RA8875_800x480, RA8875_800x480ALT, Adafruit_480x272, Adafruit_800x480 };
+enum RA8875tsize { X16 = 0, X24, X32 };
+enum RA8875writes { L1 = 0, L2, CGRAM, PATTERN, CURSOR };
+enum RA8875boolean { LAYER1, LAYER2, TRANSPARENT, LIGHTEN, OR, AND, FLOATING };
+
+class RA8875 : public Print {
+ public:
+  RA8875(uint8_t, uint8_t = 255, uint8_t = 11, uint8_t = 13, uint8_t = 12) {}
+  void begin(enum RA8875sizes, uint8_t = 16, uint32_t = 0, uint32_t = 0) {}
+  size_t write(uint8_t) override { return 1; }
+  using Print::write;
+
+  int16_t width(void) const { return 800; }
+  int16_t height(void) const { return 480; }
+  void setRotation(uint8_t) {}
+  void useLayers(bool) {}
+  void layerEffect(enum RA8875boolean) {}
+  void writeTo(enum RA8875writes) {}
+  void clearMemory(bool = false) {}
+  void clearScreen(uint16_t = 0) {}
+  void fillWindow(uint16_t = 0) {}
+  void useCanvas() {}
+  void setCursor(int16_t, int16_t, bool = false) {}
+  void setTextColor(uint16_t) {}
+  void setTextColor(uint16_t, uint16_t) {}
+  void setForegroundColor(uint16_t) {}
+  void setFont(const GFXfont *) {}
+  void setFontDefault(void) {}
+  void setFontScale(uint8_t) {}
+  void setFontScale(enum RA8875tsize) {}
+  uint8_t getFontWidth(bool = false) { return 8; }
+  uint8_t getFontHeight(bool = false) { return 16; }
+  uint16_t Color565(uint8_t r, uint8_t g, uint8_t b) { return (uint16_t)(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3)); }
+  void Color565ToRGB(uint16_t color, uint8_t &r, uint8_t &g, uint8_t &b) {
+    r = (uint8_t)(((color >> 11) & 0x1F) << 3);
+    g = (uint8_t)(((color >> 5) & 0x3F) << 2);
+    b = (uint8_t)((color & 0x1F) << 3);
+  }
+  uint16_t colorInterpolation(uint16_t color1, uint16_t, uint16_t, uint16_t) { return color1; }
+
+  void drawPixel(int16_t, int16_t, uint16_t) {}
+  void drawPixels(uint16_t[], uint16_t, int16_t, int16_t) {}
+  void drawFastVLine(int16_t, int16_t, int16_t, uint16_t) {}
+  void drawFastHLine(int16_t, int16_t, int16_t, uint16_t) {}
+  void drawLine(int16_t, int16_t, int16_t, int16_t, uint16_t) {}
+  void drawLineAngle(int16_t, int16_t, int16_t, uint16_t, uint16_t, int = 0) {}
+  void drawRect(int16_t, int16_t, int16_t, int16_t, uint16_t) {}
+  void fillRect(int16_t, int16_t, int16_t, int16_t, uint16_t) {}
+  void fill(uint16_t) {}
+  void drawCircle(int16_t, int16_t, int16_t, uint16_t) {}
+  void fillCircle(int16_t, int16_t, int16_t, uint16_t) {}
+  void writeRect(int16_t, int16_t, int16_t, int16_t, const uint16_t *) {}
+  void putPicture_16bpp(uint16_t, uint16_t, uint16_t, uint16_t) {}
+  void startSend(void) {}
+  void endSend(bool = false) {}
+  void BTE_move(int16_t, int16_t, int16_t, int16_t, int16_t, int16_t, uint8_t = 0, uint8_t = 0, bool = false, uint8_t = 0xC, bool = false, bool = false) {}
+  bool readStatus(void) { return false; }
+  bool DMAFinished(void) { return true; }
+};
+
+#endif
@@ -0,0 +1,43 @@
+// Host build only: no SD card is present, so every open fails.
+#ifndef HOST_SD_H
+#define HOST_SD_H
+
+#include <Arduino.h>
+
+#define FILE_READ 0
+#define FILE_WRITE 1
+#ifndef O_RDWR
+#define O_RDWR 2
+#endif
+
+class File : public Stream {
+ public:
+  File() {}
+  size_t write(uint8_t) override { return 0; }
+  size_t write(const uint8_t *, size_t) override { return 0; }
+  using Print::write;
+  int available(void) override { return 0; }
+  int read(void) override { return -1; }
+  int read(void *, size_t) { return 0; }
+  bool seek(uint64_t) { return false; }
+  uint64_t position(void) { return 0; }
+  uint64_t size(void) { return 0; }
+  void close(void) {}
+  bool isDirectory(void) { return false; }
+  const char *name(void) { return ""; }
+  File openNextFile(uint8_t = 0) { return File(); }
+  void rewindDirectory(void) {}
+  operator bool() const { return false; }
+};
+
+class SDClass {
+ public:
+  bool begin(uint8_t = 0) { return false; }
+  File open(const char *, uint8_t = FILE_READ) { return File(); }
+  bool exists(const char *) { return false; }
+  bool remove(const char *) { return false; }
+  bool mkdir(const char *) { return false; }
+};
+extern SDClass SD;
+
+#endif
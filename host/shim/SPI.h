@@ -0,0 +1,28 @@
+// Host build only.
+#ifndef HOST_SPI_H
+#define HOST_SPI_H
+
+#include <Arduino.h>
+
+#define SPI_MODE0 0x00
+#define SPI_MODE1 0x04
+#define SPI_MODE2 0x08
+#define SPI_MODE3 0x0C
+
+class SPISettings {
+ public:
+  SPISettings() {}
+  SPISettings(uint32_t, uint8_t, uint8_t) {}
+};
+
+class SPIClass {
+ public:
+  void begin(void) {}
+  void end(void) {}
+  uint8_t transfer(uint8_t) { return 0; }
+  void beginTransaction(SPISettings) {}
+  void endTransaction(void) {}
+};
+extern SPIClass SPI;
+
+#endif
@@ -0,0 +1,29 @@
+// Host build only: Teensy Time library subset backed by the host clock.
+#ifndef HOST_TIMELIB_H
+#define HOST_TIMELIB_H
+
+#include <Arduino.h>
+#include <time.h>
+
+typedef time_t (*getExternalTime)();
+void setSyncProvider(getExternalTime getTimeFunction);
+void setTime(time_t t);
+time_t now(void);
+int hour(void);
+int hour(time_t t);
+int minute(void);
+int minute(time_t t);
+int second(void);
+int second(time_t t);
+int day(void);
+int month(void);
+int year(void);
+
+class teensy3_clock_class {
+ public:
+  unsigned long get(void);
+  void set(unsigned long t);
+};
+extern teensy3_clock_class Teensy3Clock;
+
+#endif
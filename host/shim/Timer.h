@@ -0,0 +1,18 @@
+// Host build only.
+#ifndef HOST_TIMER_H
+#define HOST_TIMER_H
+
+#include <Arduino.h>
+
+class Timer {
+ public:
+  void start(void) { start_ = millis(); }
+  void stop(void) {}
+  void pause(void) {}
+  void resume(void) {}
+  unsigned long read(void) const { return millis() - start_; }
+ private:
+  unsigned long start_ = 0;
+};
+
+#endif
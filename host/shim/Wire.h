@@ -0,0 +1,30 @@
+// Host build only: I2C bus with no devices attached. Reads return zero so
+// drivers that poll status registers see an idle, ready device.
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+
+#include <Arduino.h>
+
+class TwoWire : public Stream {
+ public:
+  void begin(void) {}
+  void begin(uint8_t) {}
+  void end(void) {}
+  void setClock(uint32_t) {}
+  void beginTransmission(uint8_t) {}
+  void beginTransmission(int) {}
+  uint8_t endTransmission(bool = true) { return 0; }
+  uint8_t requestFrom(uint8_t, uint8_t, bool = true) { return 0; }
+  uint8_t requestFrom(int, int, int = 1) { return 0; }
+  size_t write(uint8_t) override { return 1; }
+  size_t write(const uint8_t *, size_t n) override { return n; }
+  using Print::write;
+  int available(void) override { return 0; }
+  int read(void) override { return 0; }
+};
+
+extern TwoWire Wire;
+extern TwoWire Wire1;
+extern TwoWire Wire2;
+
+#endif